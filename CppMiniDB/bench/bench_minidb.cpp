@@ -0,0 +1,270 @@
+/**
+ * @file bench_minidb.cpp
+ * @brief Google Benchmark suite for MiniDB hot paths.
+ *
+ * Every benchmark is parameterized by row count and reports
+ *  - items_per_second : rows processed per second
+ *  - bytes_per_second : CSV payload (the `.tbl` line size) processed per second
+ *
+ * Row counts span 1K..10M for the in-memory paths. Paths that materialize
+ * the whole table as maps or JSON (selectWhereMulti, disk load, export/import) stop at 1M,
+ * since their peak memory grows several times faster than the row store.
+ *
+ * Run a subset with e.g. `./bench_minidb --benchmark_filter=SelectWhere`.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cppminidb/MiniDB.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr int64_t kMinRows = 1'000;
+    constexpr int64_t kMaxRows = 10'000'000;
+    constexpr int64_t kMaxMaterializedRows = 1'000'000;
+
+    const std::string kBenchDir = (std::filesystem::temp_directory_path() / "minidb_bench").string();
+
+    const std::vector<std::string> kColumns = {"timestamp_ms", "sensor_id", "value", "fault_flags"};
+    const std::vector<MiniDB::ColumnType> kTypes = {
+        MiniDB::ColumnType::Int,
+        MiniDB::ColumnType::String,
+        MiniDB::ColumnType::Float,
+        MiniDB::ColumnType::String};
+
+    /// Deterministic log-shaped row; mirrors what SensorScheduler writes.
+    std::vector<std::string> makeRow(int64_t i)
+    {
+        static const char *ids[] = {"TEMP-001", "TEMP-002", "PRES-001", "PRES-002"};
+        return {std::to_string(i * 100),
+                ids[i & 3],
+                std::to_string(20.0 + static_cast<double>(i % 1000) * 0.01),
+                (i % 97 == 0) ? "SPIKE" : "-"};
+    }
+
+    void removeTableFile(const std::string &table)
+    {
+        std::filesystem::remove(std::filesystem::path(kBenchDir) / (table + ".tbl"));
+    }
+
+    /// Size of the row as persisted in the `.tbl` file (comma separators + newline).
+    int64_t rowBytes(const std::vector<std::string> &row)
+    {
+        int64_t bytes = static_cast<int64_t>(row.size()); // separators and '\n'
+        for (const auto &cell : row)
+            bytes += static_cast<int64_t>(cell.size());
+        return bytes;
+    }
+
+    /// Builds a populated table and returns the total CSV payload size via @p bytes.
+    void populate(MiniDB &db, int64_t rows, int64_t &bytes)
+    {
+        db.setColumns(kColumns, kTypes);
+        bytes = 0;
+        for (int64_t i = 0; i < rows; ++i)
+        {
+            auto row = makeRow(i);
+            bytes += rowBytes(row);
+            db.insertRow(row);
+        }
+    }
+
+    void setCounters(benchmark::State &state, int64_t rows, int64_t bytes)
+    {
+        state.SetItemsProcessed(state.iterations() * rows);
+        state.SetBytesProcessed(state.iterations() * bytes);
+    }
+
+    void BM_InsertRow(benchmark::State &state)
+    {
+        const int64_t rows = state.range(0);
+        std::vector<std::vector<std::string>> input;
+        input.reserve(static_cast<size_t>(rows));
+        int64_t bytes = 0;
+        for (int64_t i = 0; i < rows; ++i)
+        {
+            input.push_back(makeRow(i));
+            bytes += rowBytes(input.back());
+        }
+
+        for (auto _ : state)
+        {
+            MiniDB db("bench_insert", kBenchDir);
+            db.setColumns(kColumns, kTypes);
+            for (const auto &row : input)
+                db.insertRow(row);
+            benchmark::DoNotOptimize(db);
+        }
+        setCounters(state, rows, bytes);
+    }
+
+    void BM_AppendLog(benchmark::State &state)
+    {
+        const int64_t rows = state.range(0);
+        int64_t bytes = 0;
+        for (int64_t i = 0; i < rows; ++i)
+            bytes += rowBytes(makeRow(i));
+        const std::vector<std::string> noFaults;
+        const std::vector<std::string> spike = {"SPIKE"};
+
+        for (auto _ : state)
+        {
+            MiniDB db("bench_append", kBenchDir);
+            db.setColumns(kColumns, kTypes);
+            for (int64_t i = 0; i < rows; ++i)
+            {
+                db.appendLog((i & 1) ? "TEMP-001" : "PRES-001",
+                             static_cast<uint64_t>(i) * 100,
+                             20.0 + static_cast<double>(i % 1000) * 0.01,
+                             (i % 97 == 0) ? spike : noFaults);
+            }
+            benchmark::DoNotOptimize(db);
+        }
+        setCounters(state, rows, bytes);
+    }
+
+    void BM_SelectWhereFromMemory(benchmark::State &state)
+    {
+        const int64_t rows = state.range(0);
+        MiniDB db("bench_select", kBenchDir);
+        int64_t bytes = 0;
+        populate(db, rows, bytes);
+
+        // Selects the upper half of the timestamp range.
+        const std::string threshold = std::to_string((rows / 2) * 100);
+        for (auto _ : state)
+        {
+            auto result = db.selectWhereFromMemory("timestamp_ms", ">=", threshold);
+            benchmark::DoNotOptimize(result);
+        }
+        setCounters(state, rows, bytes);
+    }
+
+    void BM_SelectWhereMulti(benchmark::State &state)
+    {
+        const int64_t rows = state.range(0);
+        MiniDB db("bench_select_multi", kBenchDir);
+        int64_t bytes = 0;
+        populate(db, rows, bytes);
+
+        const std::vector<Condition> conditions = {
+            {"timestamp_ms", ">=", std::to_string((rows / 2) * 100)},
+            {"value", ">", "25.0"}};
+        for (auto _ : state)
+        {
+            auto result = db.selectWhereMulti(conditions, false);
+            benchmark::DoNotOptimize(result);
+        }
+        setCounters(state, rows, bytes);
+    }
+
+    void BM_ExecutePrepared(benchmark::State &state)
+    {
+        const int64_t rows = state.range(0);
+        MiniDB db("bench_prepared", kBenchDir);
+        int64_t bytes = 0;
+        populate(db, rows, bytes);
+
+        const auto plan = db.prepare({{"timestamp_ms", ">=", ""}, {"value", ">", ""}});
+        const std::vector<std::string> params = {std::to_string((rows / 2) * 100), "25.0"};
+        for (auto _ : state)
+        {
+            auto result = db.execute(*plan, params);
+            benchmark::DoNotOptimize(result);
+        }
+        setCounters(state, rows, bytes);
+    }
+
+    void BM_Save(benchmark::State &state)
+    {
+        const int64_t rows = state.range(0);
+        MiniDB db("bench_save", kBenchDir);
+        int64_t bytes = 0;
+        populate(db, rows, bytes);
+
+        for (auto _ : state)
+            db.save();
+        setCounters(state, rows, bytes);
+        removeTableFile("bench_save");
+    }
+
+    void BM_LoadFromDisk(benchmark::State &state)
+    {
+        const int64_t rows = state.range(0);
+        MiniDB db("bench_load", kBenchDir);
+        int64_t bytes = 0;
+        populate(db, rows, bytes);
+        db.save();
+
+        for (auto _ : state)
+        {
+            auto loaded = db.loadFromDisk();
+            benchmark::DoNotOptimize(loaded);
+        }
+        setCounters(state, rows, bytes);
+        removeTableFile("bench_load");
+    }
+
+    void BM_ExportToJson(benchmark::State &state)
+    {
+        const int64_t rows = state.range(0);
+        MiniDB db("bench_export", kBenchDir);
+        int64_t bytes = 0;
+        populate(db, rows, bytes);
+
+        for (auto _ : state)
+        {
+            auto json = db.exportToJson();
+            benchmark::DoNotOptimize(json);
+        }
+        setCounters(state, rows, bytes);
+    }
+
+    void BM_ImportFromJson(benchmark::State &state)
+    {
+        const int64_t rows = state.range(0);
+        std::string json;
+        int64_t bytes = 0;
+        {
+            MiniDB source("bench_import_src", kBenchDir);
+            populate(source, rows, bytes);
+            json = source.exportToJson();
+        }
+
+        for (auto _ : state)
+        {
+            MiniDB db("bench_import", kBenchDir);
+            db.setColumns(kColumns, kTypes);
+            db.importFromJson(json);
+            benchmark::DoNotOptimize(db);
+        }
+        setCounters(state, rows, bytes);
+    }
+
+    void InMemoryRows(benchmark::internal::Benchmark *b)
+    {
+        b->RangeMultiplier(10)->Range(kMinRows, kMaxRows)->Unit(benchmark::kMillisecond);
+    }
+
+    void MaterializedRows(benchmark::internal::Benchmark *b)
+    {
+        b->RangeMultiplier(10)->Range(kMinRows, kMaxMaterializedRows)->Unit(benchmark::kMillisecond);
+    }
+} // namespace
+
+BENCHMARK(BM_InsertRow)->Apply(InMemoryRows);
+BENCHMARK(BM_AppendLog)->Apply(InMemoryRows);
+BENCHMARK(BM_SelectWhereFromMemory)->Apply(InMemoryRows);
+BENCHMARK(BM_SelectWhereMulti)->Apply(MaterializedRows);
+BENCHMARK(BM_ExecutePrepared)->Apply(MaterializedRows);
+BENCHMARK(BM_Save)->Apply(InMemoryRows);
+BENCHMARK(BM_LoadFromDisk)->Apply(MaterializedRows);
+BENCHMARK(BM_ExportToJson)->Apply(MaterializedRows);
+BENCHMARK(BM_ImportFromJson)->Apply(MaterializedRows);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace cppminidb
+{
+    /**
+     * Bounded lock-free queue (Vyukov): every cell carries a sequence number that tells
+     * producers and consumers whether it is free or full for their lap, so push and pop
+     * are one CAS on the shared index plus a release store on the cell. Any number of
+     * producers and consumers may use it concurrently (the sample bus and the logger use
+     * it as MPSC).
+     */
+    template <typename T>
+    class BoundedQueue
+    {
+    public:
+        // Capacity is rounded up to a power of two (minimum 2)
+        explicit BoundedQueue(std::size_t capacity)
+        {
+            std::size_t size = 2;
+            while (size < capacity)
+                size <<= 1;
+            mask_ = size - 1;
+            cells_ = std::make_unique<Cell[]>(size);
+            for (std::size_t i = 0; i < size; ++i)
+                cells_[i].seq.store(i, std::memory_order_relaxed);
+        }
+
+        BoundedQueue(const BoundedQueue &) = delete;
+        BoundedQueue &operator=(const BoundedQueue &) = delete;
+
+        template <typename U>
+        bool tryPush(U &&value)
+        {
+            std::size_t pos = tail_.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Cell &cell = cells_[pos & mask_];
+                const std::size_t seq = cell.seq.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+                if (diff == 0)
+                {
+                    if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        cell.value = std::forward<U>(value);
+                        cell.seq.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    return false; // full
+                }
+                else
+                {
+                    pos = tail_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        bool tryPop(T &out)
+        {
+            std::size_t pos = head_.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Cell &cell = cells_[pos & mask_];
+                const std::size_t seq = cell.seq.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+                if (diff == 0)
+                {
+                    if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        out = std::move(cell.value);
+                        cell.seq.store(pos + mask_ + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    return false; // empty
+                }
+                else
+                {
+                    pos = head_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        std::size_t capacity() const { return mask_ + 1; }
+
+        // Approximate while producers or consumers are active
+        std::size_t size() const
+        {
+            const std::size_t tail = tail_.load(std::memory_order_acquire);
+            const std::size_t head = head_.load(std::memory_order_acquire);
+            return tail > head ? tail - head : 0;
+        }
+
+    private:
+        struct Cell
+        {
+            std::atomic<std::size_t> seq{0};
+            T value{};
+        };
+
+        static constexpr std::size_t kLine = 64;
+
+        std::unique_ptr<Cell[]> cells_;
+        std::size_t mask_ = 0;
+        alignas(kLine) std::atomic<std::size_t> tail_{0};
+        alignas(kLine) std::atomic<std::size_t> head_{0};
+    };
+} // namespace cppminidb
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <cppminidb/MiniDB.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace cppminidb
+{
+    /**
+     * Columnar export format (`.mdbc`)
+     * ================================
+     *
+     * A self-describing binary file for offline analytics. Rows are grouped into
+     * chunks, and every chunk stores each column as its own contiguous block, so
+     * readers only decode the columns they need.
+     *
+     *   ┌──────────────────────────────────────────────────────────┐
+     *   │ "MDBCOL01" | version | column names + declared types     │  header
+     *   ├──────────────────────────────────────────────────────────┤
+     *   │ chunk 0: [col 0 block][col 1 block] ...                  │
+     *   │ chunk 1: [col 0 block][col 1 block] ...                  │  data
+     *   ├──────────────────────────────────────────────────────────┤
+     *   │ per chunk: row count, per column offset/length/encoding  │
+     *   │            and min/max statistics                        │  footer
+     *   ├──────────────────────────────────────────────────────────┤
+     *   │ footer offset (u64) | "MDBCEND1"                         │  trailer
+     *   └──────────────────────────────────────────────────────────┘
+     *
+     * Each column block picks the smallest lossless encoding that fits:
+     *  - DeltaDecimal : Int/Float columns whose cells share a fixed number of
+     *                   decimals (e.g. "21.340000"); stored as zig-zag varint
+     *                   deltas of the scaled integer.
+     *  - Dictionary   : low-cardinality columns such as sensor IDs or fault
+     *                   flags; a per-chunk dictionary plus bit-packed codes.
+     *  - Plain        : length-prefixed strings (fallback).
+     *
+     * All encodings reproduce the original cell strings exactly.
+     */
+
+    enum class ColumnEncoding : uint8_t
+    {
+        Plain = 0,
+        Dictionary = 1,
+        DeltaDecimal = 2
+    };
+
+    /// Min/max of one column inside one chunk. Numeric columns keep doubles, string columns keep strings.
+    struct ColumnStats
+    {
+        enum class Kind : uint8_t
+        {
+            None = 0,
+            Numeric = 1,
+            String = 2
+        };
+
+        Kind kind = Kind::None;
+        double minNumber = 0.0;
+        double maxNumber = 0.0;
+        std::string minString;
+        std::string maxString;
+    };
+
+    struct ColumnChunkInfo
+    {
+        uint64_t offset = 0;
+        uint64_t length = 0;
+        ColumnEncoding encoding = ColumnEncoding::Plain;
+        ColumnStats stats;
+    };
+
+    struct ChunkInfo
+    {
+        uint64_t rowCount = 0;
+        std::vector<ColumnChunkInfo> columns;
+    };
+
+    /**
+     * @class ColumnarWriter
+     * @brief Streams rows into a columnar file, flushing one chunk every rowsPerChunk rows.
+     *
+     * close() writes the footer; the destructor calls it if needed. Errors while
+     * opening or writing throw std::runtime_error.
+     */
+    class ColumnarWriter
+    {
+    public:
+        static constexpr std::size_t kDefaultRowsPerChunk = 64 * 1024;
+
+        ColumnarWriter(const std::string &path,
+                       const std::vector<std::string> &columns,
+                       const std::vector<MiniDB::ColumnType> &types,
+                       std::size_t rowsPerChunk = kDefaultRowsPerChunk);
+        ~ColumnarWriter();
+
+        ColumnarWriter(const ColumnarWriter &) = delete;
+        ColumnarWriter &operator=(const ColumnarWriter &) = delete;
+
+        /// Appends a row; missing trailing cells are stored as empty strings.
+        void writeRow(const std::vector<std::string> &row);
+
+        /// Flushes the pending chunk and writes the footer. Safe to call twice.
+        void close();
+
+        std::size_t rowsWritten() const noexcept { return rowsWritten_; }
+
+    private:
+        void flushChunk();
+
+        std::string path_;
+        std::ofstream out_;
+        std::vector<std::string> columns_;
+        std::vector<MiniDB::ColumnType> types_;
+        std::size_t rowsPerChunk_;
+        std::vector<std::vector<std::string>> pending_; // column-major
+        std::size_t pendingRows_ = 0;
+        std::vector<ChunkInfo> chunks_;
+        std::size_t rowsWritten_ = 0;
+        bool closed_ = false;
+    };
+
+    /**
+     * @class ColumnarReader
+     * @brief Reads a columnar file and answers filtered scans, skipping chunks by statistics.
+     *
+     * The header and footer are loaded at construction; column blocks are read
+     * on demand. Conditions use the same operators as MiniDB::selectWhereMulti
+     * and combine with AND.
+     */
+    class ColumnarReader
+    {
+    public:
+        struct ScanStats
+        {
+            std::size_t chunksTotal = 0;
+            std::size_t chunksSkipped = 0;
+            std::size_t rowsScanned = 0;
+            std::size_t rowsMatched = 0;
+        };
+
+        /// @throws std::runtime_error if the file is missing or malformed.
+        explicit ColumnarReader(const std::string &path);
+
+        const std::vector<std::string> &columns() const noexcept { return columns_; }
+        const std::vector<MiniDB::ColumnType> &types() const noexcept { return types_; }
+        const std::vector<ChunkInfo> &chunks() const noexcept { return chunks_; }
+        std::size_t rowCount() const noexcept;
+
+        /// Decodes a single column of one chunk.
+        std::vector<std::string> readColumn(std::size_t chunk, std::size_t column) const;
+
+        /// Decodes every row of the file, in order.
+        std::vector<std::vector<std::string>> readAll() const;
+
+        /**
+         * @brief Returns rows matching all conditions, as column→value maps.
+         *
+         * Chunks whose min/max statistics rule out a condition are skipped without
+         * being read. Within a chunk, filter columns are decoded first and the
+         * remaining columns only if at least one row matches. Conditions behave as in
+         * MiniDB::execute: == and != compare the text exactly, ordering operators compare
+         * numbers and never match cells that do not parse.
+         *
+         * @throws std::invalid_argument for unknown columns, unsupported operators or a
+         *         non-numeric value for an ordering operator.
+         */
+        std::vector<std::map<std::string, std::string>> select(const std::vector<Condition> &conditions,
+                                                               ScanStats *scanStats = nullptr) const;
+
+    private:
+        std::size_t columnIndex(const std::string &name) const;
+        // Scans open the file once and read every block through the same stream
+        std::ifstream openFile() const;
+        std::vector<std::string> readColumn(std::ifstream &in, std::size_t chunk, std::size_t column) const;
+
+        std::string path_;
+        std::vector<std::string> columns_;
+        std::vector<MiniDB::ColumnType> types_;
+        std::vector<ChunkInfo> chunks_;
+    };
+} // namespace cppminidb
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cppminidb/MiniDB.hpp>
+#include <cppminidb/StorageManager.hpp>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace cppminidb
+{
+    /**
+     * @class Database
+     * @brief Catalog that owns several MiniDB tables under one data directory.
+     *
+     * Every table created through a Database stores its `.tbl` file inside the
+     * configured data directory and charges its in-memory rows against a single
+     * shared StorageManager budget. This lets an application keep, for example,
+     * raw logs, rollups and fault events in separate tables without each of them
+     * growing its own unbounded buffers.
+     *
+     * @code
+     * cppminidb::Database db("./data", 32 * 1024 * 1024);
+     * MiniDB &raw = db.createTable("raw_logs", {"timestamp_ms", "sensor_id", "value"},
+     *                              {MiniDB::ColumnType::Int, MiniDB::ColumnType::String, MiniDB::ColumnType::Float});
+     * MiniDB &faults = db.openTable("fault_events");
+     * @endcode
+     */
+    class Database
+    {
+    public:
+        static constexpr std::size_t kDefaultMemoryBudget = 64 * 1024 * 1024;
+
+        /**
+         * @param dataDir Directory holding every `.tbl` file of this catalog.
+         * @param memoryBudgetBytes Combined in-memory budget shared by all tables.
+         * @param pageCacheBytes Capacity of the page cache serving disk reads (part of the budget).
+         */
+        explicit Database(const std::string &dataDir = "./data",
+                          std::size_t memoryBudgetBytes = kDefaultMemoryBudget,
+                          std::size_t pageCacheBytes = PageCache::kDefaultCapacity);
+
+        Database(const Database &) = delete;
+        Database &operator=(const Database &) = delete;
+
+        /**
+         * @brief Creates a new table with the given typed schema.
+         * @throws std::invalid_argument if a table with this name already exists.
+         */
+        MiniDB &createTable(const std::string &name,
+                            const std::vector<std::string> &columns,
+                            const std::vector<MiniDB::ColumnType> &types);
+
+        /**
+         * @brief Returns the named table, registering an empty one if it does not exist yet.
+         */
+        MiniDB &openTable(const std::string &name);
+
+        /**
+         * @brief Returns the named table or nullptr if it is not part of the catalog.
+         */
+        MiniDB *getTable(const std::string &name) const;
+
+        bool hasTable(const std::string &name) const;
+
+        /**
+         * @brief Removes a table from the catalog and releases its memory, including its cached file pages.
+         * @param removeFile If true, the table's `.tbl` file is deleted as well.
+         * @return false if the table was not found.
+         */
+        bool dropTable(const std::string &name, bool removeFile = false);
+
+        std::vector<std::string> tableNames() const;
+
+        /**
+         * @brief Persists every table of the catalog via MiniDB::save().
+         */
+        void saveAll() const;
+
+        const std::string &dataDirectory() const noexcept;
+
+        StorageManager &storage() noexcept;
+        const StorageManager &storage() const noexcept;
+
+        /**
+         * @brief Hit/miss counters of the page cache shared by all tables.
+         */
+        PageCache::Stats pageCacheStats() const;
+
+        /**
+         * @brief Combined in-memory footprint of all tables and cached pages, in bytes.
+         */
+        std::size_t memoryUsage() const noexcept;
+
+    private:
+        std::string dataDir_;
+        StorageManager storage_; // declared before tables_ so it outlives them
+        mutable std::mutex mtx_;
+        std::map<std::string, std::unique_ptr<MiniDB>> tables_;
+    };
+} // namespace cppminidb
@@ -0,0 +1,297 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <nlohmann/json.hpp>
+#include <cppminidb/BoundedQueue.hpp>
+
+namespace cppminidb
+{
+    enum class LogLevel : uint8_t
+    {
+        Trace,
+        Debug, // per-sample chatter (scheduler echo)
+        Info,
+        Warn,
+        Error,
+        Off
+    };
+
+    inline const char *toString(LogLevel level)
+    {
+        switch (level)
+        {
+        case LogLevel::Trace:
+            return "trace";
+        case LogLevel::Debug:
+            return "debug";
+        case LogLevel::Info:
+            return "info";
+        case LogLevel::Warn:
+            return "warn";
+        case LogLevel::Error:
+            return "error";
+        case LogLevel::Off:
+            return "off";
+        }
+        return "off";
+    }
+
+    // "trace", "debug", "info", "warn", "error" or "off"; false for anything else
+    inline bool parseLogLevel(std::string_view text, LogLevel &out)
+    {
+        for (auto level : {LogLevel::Trace, LogLevel::Debug, LogLevel::Info, LogLevel::Warn, LogLevel::Error, LogLevel::Off})
+        {
+            if (text == toString(level))
+            {
+                out = level;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Process-wide leveled logger shared by SensorSimulator, EdgeGateway and EdgeAgent.
+     *
+     * A record below the current level costs one relaxed atomic load (check enabled()
+     * before formatting anything expensive). Records at Warn and above go to std::cerr,
+     * the rest to std::cout; Text output is "[component] message" (the message as-is for
+     * an empty component), Json output is one object per line with ts_us, level,
+     * component and msg. Messages therefore do not repeat the component.
+     *
+     * Writes are inline (in call order, on the caller's thread) until startAsync():
+     * from then on records go through a bounded lock-free queue to a background writer,
+     * so logging never waits on console or pipe I/O. A full queue drops the record and
+     * counts it rather than stalling the caller. The default level is Debug, which keeps
+     * the interactive tools as chatty as before; services raise it to Info.
+     */
+    class Logger
+    {
+    public:
+        enum class Format
+        {
+            Text,
+            Json
+        };
+
+        static Logger &instance()
+        {
+            static Logger logger;
+            return logger;
+        }
+
+        ~Logger()
+        {
+            stopAsync();
+        }
+
+        bool enabled(LogLevel level) const
+        {
+            return level >= level_.load(std::memory_order_relaxed) && level != LogLevel::Off;
+        }
+
+        void setLevel(LogLevel level) { level_.store(level, std::memory_order_relaxed); }
+        LogLevel level() const { return level_.load(std::memory_order_relaxed); }
+
+        void setFormat(Format format) { format_.store(format, std::memory_order_relaxed); }
+        Format format() const { return format_.load(std::memory_order_relaxed); }
+
+        void log(LogLevel level, std::string_view component, std::string message)
+        {
+            if (!enabled(level))
+                return;
+            if (!message.empty() && message.back() == '\n')
+                message.pop_back();
+
+            Record record{now_us(), level, std::string(component), std::move(message)};
+            if (!async_.load(std::memory_order_acquire))
+            {
+                std::lock_guard<std::mutex> lock(write_mtx_);
+                write(record);
+                return;
+            }
+            if (!queue_->tryPush(std::move(record)))
+            {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            signal_.fetch_add(1, std::memory_order_release);
+            signal_.notify_one();
+        }
+
+        // Switches to the background writer. Call before other threads start logging.
+        void startAsync(std::size_t capacity = 8192)
+        {
+            if (async_.load(std::memory_order_acquire))
+                return;
+            queue_ = std::make_unique<BoundedQueue<Record>>(capacity);
+            stopping_.store(false, std::memory_order_relaxed);
+            writer_ = std::thread([this]
+                                  { writerLoop(); });
+            async_.store(true, std::memory_order_release);
+        }
+
+        // Writes out everything queued, then returns to inline writes. Call once other
+        // threads have stopped logging: a log() that saw the async mode just before the
+        // switch pushes after the writer's last pass, and is written here only if it has
+        // landed by the time the queue is drained below.
+        void stopAsync()
+        {
+            if (!async_.exchange(false, std::memory_order_acq_rel))
+                return;
+            stopping_.store(true, std::memory_order_release);
+            signal_.fetch_add(1, std::memory_order_release);
+            signal_.notify_one();
+            writer_.join();
+
+            // Records pushed between the writer's last pass and its exit
+            std::lock_guard<std::mutex> lock(write_mtx_);
+            Record record;
+            while (queue_->tryPop(record))
+                write(record);
+            std::cout.flush();
+            std::cerr.flush();
+        }
+
+        bool async() const { return async_.load(std::memory_order_acquire); }
+
+        // Waits until the background writer has written every queued record
+        void flush() const
+        {
+            while (async() && (queue_->size() > 0 || busy_.load(std::memory_order_acquire)))
+                std::this_thread::yield();
+        }
+
+        // Records lost to a full async queue
+        uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    private:
+        struct Record
+        {
+            uint64_t ts_us = 0;
+            LogLevel level = LogLevel::Info;
+            std::string component;
+            std::string message;
+        };
+
+        Logger() = default;
+
+        static uint64_t now_us()
+        {
+            using namespace std::chrono;
+            return static_cast<uint64_t>(duration_cast<microseconds>(system_clock::now().time_since_epoch()).count());
+        }
+
+        void write(const Record &record) const
+        {
+            std::ostream &out = record.level >= LogLevel::Warn ? std::cerr : std::cout;
+            if (format() == Format::Json)
+            {
+                nlohmann::json line = {{"ts_us", record.ts_us},
+                                       {"level", toString(record.level)},
+                                       {"component", record.component},
+                                       {"msg", record.message}};
+                out << line.dump() << '\n';
+            }
+            else if (record.component.empty())
+            {
+                out << record.message << '\n';
+            }
+            else
+            {
+                out << '[' << record.component << "] " << record.message << '\n';
+            }
+        }
+
+        void writerLoop()
+        {
+            Record record;
+            for (;;)
+            {
+                const uint32_t seen = signal_.load(std::memory_order_acquire);
+                busy_.store(true, std::memory_order_release);
+                bool wrote = false;
+                while (queue_->tryPop(record))
+                {
+                    write(record);
+                    wrote = true;
+                }
+                if (wrote)
+                {
+                    std::cout.flush();
+                    std::cerr.flush();
+                }
+                busy_.store(false, std::memory_order_release);
+                if (stopping_.load(std::memory_order_acquire) && queue_->size() == 0)
+                    return;
+                signal_.wait(seen, std::memory_order_acquire);
+            }
+        }
+
+        std::atomic<LogLevel> level_{LogLevel::Debug};
+        std::atomic<Format> format_{Format::Text};
+        std::atomic<bool> async_{false};
+        std::atomic<bool> stopping_{false};
+        std::atomic<bool> busy_{false};
+        std::atomic<uint32_t> signal_{0};
+        std::atomic<uint64_t> dropped_{0};
+        std::unique_ptr<BoundedQueue<Record>> queue_;
+        std::thread writer_;
+        std::mutex write_mtx_;
+    };
+
+    /**
+     * One log record built with <<, submitted when the statement ends:
+     *
+     *   cppminidb::logInfo("EdgeGateway") << "Fleet loaded: " << path;
+     *
+     * Nothing is formatted when the level is disabled, but the operands are still
+     * evaluated; guard per-sample call sites with Logger::enabled().
+     */
+    class LogLine
+    {
+    public:
+        LogLine(LogLevel level, std::string_view component) : level_(level), component_(component)
+        {
+            if (Logger::instance().enabled(level))
+                stream_.emplace();
+        }
+
+        LogLine(const LogLine &) = delete;
+        LogLine &operator=(const LogLine &) = delete;
+
+        ~LogLine()
+        {
+            if (stream_)
+                Logger::instance().log(level_, component_, std::move(*stream_).str());
+        }
+
+        template <typename T>
+        LogLine &operator<<(const T &value)
+        {
+            if (stream_)
+                *stream_ << value;
+            return *this;
+        }
+
+    private:
+        LogLevel level_;
+        std::string_view component_;
+        std::optional<std::ostringstream> stream_;
+    };
+
+    inline LogLine logDebug(std::string_view component) { return LogLine(LogLevel::Debug, component); }
+    inline LogLine logInfo(std::string_view component) { return LogLine(LogLevel::Info, component); }
+    inline LogLine logWarn(std::string_view component) { return LogLine(LogLevel::Warn, component); }
+    inline LogLine logError(std::string_view component) { return LogLine(LogLevel::Error, component); }
+} // namespace cppminidb
@@ -43,6 +43,17 @@
 #include <string>
 #include <map>
 #include <mutex>
+#include <cstdint>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <cppminidb/PageCache.hpp>
+#include <cppminidb/QueryPlan.hpp>
+
+namespace cppminidb
+{
+    class StorageManager;
+}
 
 struct LogEntry
 {
@@ -50,6 +61,7 @@ struct LogEntry
     std::string sensorId;
     double value;
     std::vector<std::string> faults;
+    std::vector<double> channels; // every channel of a multi-channel row (value == channels[0]); else empty
 };
 
 struct Condition
@@ -85,8 +97,21 @@ public:
      */
     MiniDB(const std::string &tableName);
 
+    /**
+     * @brief Constructor for tables managed by a catalog (see cppminidb::Database).
+     * @param tableName Name of the table, also used for file storage.
+     * @param dataDir Directory that holds the table's `.tbl` file.
+     * @param storage Optional shared memory budget; in-memory rows are charged against it.
+     *
+     * When a StorageManager is supplied, inserts that would exceed the shared
+     * budget throw std::runtime_error instead of growing memory unbounded.
+     */
+    MiniDB(const std::string &tableName, const std::string &dataDir, cppminidb::StorageManager *storage = nullptr);
+
     MiniDB() = default;
 
+    ~MiniDB();
+
     /**
      * @brief Sets schema with names only; defaults all column types to String.
      *
@@ -352,6 +377,21 @@ public:
     std::string exportToJson() const;
     std::string exportToJsonFromDisk() const;
 
+    /**
+     * @brief Writes the table to a compressed columnar file (see cppminidb::ColumnarWriter).
+     *
+     * Rows are stored in chunks of per-column blocks with min/max statistics,
+     * delta-encoded numbers and dictionary-encoded strings (e.g. sensor IDs).
+     * Read the file back with cppminidb::ColumnarReader.
+     *
+     * @param filePath Destination file; overwritten if it exists.
+     * @param fromDisk Export the persisted `.tbl` file instead of in-memory rows.
+     * @param rowsPerChunk Rows per chunk; 0 uses ColumnarWriter::kDefaultRowsPerChunk.
+     * @return Number of rows written.
+     * @throws std::runtime_error if no columns are defined or the file cannot be written.
+     */
+    std::size_t exportToColumnar(const std::string &filePath, bool fromDisk = false, std::size_t rowsPerChunk = 0) const;
+
     /**
      * @brief Imports table data from a JSON-formatted string into memory.
      *
@@ -453,6 +493,29 @@ public:
      */
     std::size_t rowCount() const noexcept;
 
+    /**
+     * @brief Returns the directory that holds this table's `.tbl` file.
+     */
+    const std::string &dataDirectory() const noexcept;
+
+    /**
+     * @brief Returns the approximate heap footprint of in-memory rows and log entries, in bytes.
+     */
+    std::size_t memoryUsage() const noexcept;
+
+    /**
+     * @brief Returns the counters of the page cache that serves this table's disk reads.
+     *
+     * Tables created through a cppminidb::Database share that catalog's cache;
+     * standalone tables use cppminidb::PageCache::shared().
+     */
+    cppminidb::PageCache::Stats pageCacheStats() const;
+
+    /**
+     * @brief Drops this table's file pages from the page cache (e.g. when the table is dropped).
+     */
+    void evictCachedPages() const;
+
     // Validates whether the operator is allowed for the given column type
     static bool isOpAllowedForType(const std::string &op, ColumnType t);
 
@@ -491,6 +554,38 @@ public:
                    double value,
                    const std::vector<std::string> &faults);
 
+    /**
+     * @brief Appends one log row holding every channel of a multi-channel sample.
+     *
+     * Channel 0 goes to the `value` column and channel k to `value_k`, so a 3-axis
+     * reading is a single row. Columns are matched by name; value columns without a
+     * channel are left empty. Create the table with logColumns(n) / logColumnTypes(n).
+     *
+     * @throws std::invalid_argument if `values` is empty or the schema has no column
+     *         for one of the channels.
+     */
+    void appendLog(const std::string &sensorId,
+                   uint64_t timestampMs,
+                   std::span<const double> values,
+                   const std::vector<std::string> &faults);
+
+    /**
+     * @brief Sensor log schema with `channels` value columns:
+     * timestamp_ms, sensor_id, value, value_1 .. value_{channels-1}, fault_flags.
+     */
+    static std::vector<std::string> logColumns(std::size_t channels = 1);
+    static std::vector<ColumnType> logColumnTypes(std::size_t channels = 1);
+
+    /**
+     * @brief Widens a logColumns(n) table to at least `channels` value columns.
+     *
+     * Rows already stored get empty cells in the new columns, as appendLog() leaves
+     * them for samples with fewer channels. Safe to call while logs are appended.
+     *
+     * @throws std::logic_error if the schema is not logColumns(n) for some n.
+     */
+    void widenLogColumns(std::size_t channels);
+
     const std::vector<LogEntry> &getLogs() const;
 
     void loadLogsIntoMemory();
@@ -498,8 +593,49 @@ public:
     // Preserves existing getLogs() behavior. Introduces getLogsSnapshot() to provide a thread-safe copy for consistent iteration under concurrent access.
     std::vector<LogEntry> getLogsSnapshot() const;
 
+    /**
+     * @brief Filters rows with AND-combined conditions.
+     *
+     * Equivalent to `execute(*prepare(conditions), <condition values>, fromDisk)`,
+     * so repeated shapes reuse a cached plan.
+     */
     std::vector<std::map<std::string, std::string>> selectWhereMulti(const std::vector<Condition> &conditions, bool fromDisk) const;
 
+    /**
+     * @brief Validates and compiles a condition list into a reusable query plan.
+     *
+     * Only the columns and operators of `conditions` form the plan; their values
+     * are ignored and supplied later to execute(). Plans are kept in a small
+     * per-table LRU keyed by shape, so preparing a recently used shape is a
+     * cache lookup. Changing the schema (setColumns) drops all cached plans.
+     *
+     * @throws std::invalid_argument for unknown columns, unknown operators, or
+     *         ordering operators on String columns.
+     */
+    cppminidb::QueryPlanPtr prepare(const std::vector<Condition> &conditions) const;
+
+    /**
+     * @brief Runs a prepared plan with one bound value per predicate, in plan order.
+     *
+     * `==`/`!=` compare cell strings exactly; ordering operators compare numerically
+     * and skip cells that are not numbers.
+     *
+     * @param plan Plan returned by prepare() on this table.
+     * @param params Values bound to the plan's predicates.
+     * @param fromDisk Scan the persisted `.tbl` file instead of in-memory rows.
+     * @throws std::invalid_argument if the parameter count differs from the plan or a
+     *         value bound to an ordering operator is not numeric.
+     * @throws std::logic_error if the table schema changed since the plan was prepared.
+     */
+    std::vector<std::map<std::string, std::string>> execute(const cppminidb::QueryPlan &plan,
+                                                            const std::vector<std::string> &params,
+                                                            bool fromDisk = false) const;
+
+    /**
+     * @brief Returns hit/miss counters of this table's query plan cache.
+     */
+    cppminidb::QueryPlanCache::Stats planCacheStats() const;
+
 private:
     mutable std::mutex mtx_; // "mutable" to allow locking in const methods
 
@@ -534,6 +670,39 @@ private:
     std::vector<ColumnType> columnTypes_;
 
     std::vector<LogEntry> logs_;
+
+    /**
+     * @brief Directory used for persistence. Defaults to `./data`.
+     */
+    std::string dataDir_ = "./data";
+
+    /**
+     * @brief Shared memory budget (owned by a cppminidb::Database), or nullptr for unbounded tables.
+     */
+    cppminidb::StorageManager *storage_ = nullptr;
+
+    std::size_t rowBytes_ = 0;
+    std::size_t logBytes_ = 0;
+
+    // Memory accounting helpers. reserve*() throw std::runtime_error when the shared budget is exhausted.
+    static std::size_t rowFootprint(const std::vector<std::string> &row);
+    static std::size_t logFootprint(const LogEntry &entry);
+    // "value" -> 0, "value_k" -> k; nullopt for other columns
+    static std::optional<std::size_t> logValueChannel(const std::string &column);
+    void reserveMemory(std::size_t bytes);
+    void releaseMemory(std::size_t bytes);
+    void syncRowBytes();
+
+    // Cache used by loadFromDisk(), selectWhereFromDisk() and exportToJsonFromDisk().
+    cppminidb::PageCache &pageCache() const;
+
+    // Compiled plans keyed by query shape; invalidated whenever the schema changes.
+    mutable cppminidb::QueryPlanCache planCache_;
+    uint64_t schemaVersion_ = 0;
+    // True when the schema is exactly logColumns(1), so scalar log rows can be placed
+    // by position; any other schema goes through name-based placement
+    bool scalarLogSchema_ = false;
+    void schemaChanged();
 };
 
 /**
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace cppminidb
+{
+    class StorageManager;
+
+    /**
+     * @class PageCache
+     * @brief Block-based LRU cache for table files read from disk.
+     *
+     * Files are split into fixed-size pages keyed by (path, page index). Disk
+     * queries read their input through the cache, so repeated queries against
+     * the same table are served from memory instead of re-reading the file.
+     *
+     * Freshness: every read of a file first checks its size and modification
+     * time. If either differs from what the cache saw last time, all cached
+     * pages of that file are dropped. MiniDB additionally calls invalidate()
+     * after each of its own writes.
+     *
+     * When a StorageManager is supplied, cached pages are charged against the
+     * shared memory budget. A page that cannot be reserved (even after evicting
+     * older pages) is served to the caller but not kept.
+     *
+     * All methods are thread-safe.
+     */
+    class PageCache
+    {
+    public:
+        static constexpr std::size_t kDefaultPageSize = 64 * 1024;
+        static constexpr std::size_t kDefaultCapacity = 8 * 1024 * 1024;
+
+        using Page = std::shared_ptr<const std::string>;
+
+        struct Stats
+        {
+            uint64_t hits = 0;
+            uint64_t misses = 0;
+            uint64_t evictions = 0;
+            uint64_t invalidations = 0;
+            std::size_t residentPages = 0;
+            std::size_t residentBytes = 0;
+
+            double hitRatio() const
+            {
+                const uint64_t total = hits + misses;
+                return total == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(total);
+            }
+        };
+
+        explicit PageCache(std::size_t capacityBytes = kDefaultCapacity,
+                           std::size_t pageSize = kDefaultPageSize,
+                           StorageManager *budget = nullptr);
+        ~PageCache();
+
+        PageCache(const PageCache &) = delete;
+        PageCache &operator=(const PageCache &) = delete;
+
+        /**
+         * @brief Returns the current size of a file, or std::nullopt if it does not exist.
+         *
+         * Drops cached pages of the file if it changed since it was last seen.
+         */
+        std::optional<std::size_t> fileSize(const std::string &path);
+
+        /**
+         * @brief Returns page `index` of the file, loading it from disk on a miss.
+         *
+         * The returned page is shorter than pageSize() for the last block of a file
+         * and empty past the end of the file.
+         */
+        Page page(const std::string &path, std::size_t index);
+
+        /**
+         * @brief Drops every cached page of the given file.
+         */
+        void invalidate(const std::string &path);
+
+        /**
+         * @brief Drops every cached page.
+         */
+        void clear();
+
+        /**
+         * @brief Evicts least-recently-used pages until at least `bytes` were freed or the cache is empty.
+         * @return Number of bytes actually freed.
+         */
+        std::size_t shrink(std::size_t bytes);
+
+        void setCapacity(std::size_t capacityBytes);
+        std::size_t capacity() const;
+        std::size_t pageSize() const noexcept;
+
+        Stats stats() const;
+        void resetStats();
+
+        /**
+         * @brief Process-wide cache used by tables that are not part of a Database.
+         */
+        static PageCache &shared();
+
+    private:
+        struct Key
+        {
+            std::string path;
+            std::size_t index;
+
+            bool operator==(const Key &other) const
+            {
+                return index == other.index && path == other.path;
+            }
+        };
+
+        struct KeyHash
+        {
+            std::size_t operator()(const Key &key) const noexcept
+            {
+                return std::hash<std::string>{}(key.path) ^ (std::hash<std::size_t>{}(key.index) * 0x9e3779b97f4a7c15ULL);
+            }
+        };
+
+        struct Entry
+        {
+            Key key;
+            Page data;
+        };
+
+        struct FileState
+        {
+            std::uintmax_t size = 0;
+            std::filesystem::file_time_type mtime;
+        };
+
+        void evictLocked(std::list<Entry>::iterator it, bool countEviction = true);
+        void dropFileLocked(const std::string &path);
+        bool makeRoomLocked(std::size_t bytes);
+        Page loadPage(const std::string &path, std::size_t index) const;
+
+        const std::size_t pageSize_;
+        StorageManager *budget_;
+
+        mutable std::mutex mtx_;
+        std::size_t capacity_;
+        std::list<Entry> lru_; // front = most recently used
+        std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index_;
+        std::unordered_map<std::string, FileState> files_;
+        Stats stats_;
+    };
+
+    /**
+     * @class PagedFileReader
+     * @brief Line reader that pulls a file through a PageCache.
+     *
+     * Mirrors the std::ifstream + std::getline pattern used by MiniDB's disk
+     * paths: lines are split on '\n' and a trailing line without a newline is
+     * still returned.
+     */
+    class PagedFileReader
+    {
+    public:
+        PagedFileReader(PageCache &cache, const std::string &path);
+
+        bool isOpen() const noexcept;
+        bool getline(std::string &line);
+
+    private:
+        bool nextPage();
+
+        PageCache &cache_;
+        std::string path_;
+        std::size_t fileSize_ = 0;
+        std::size_t pageIndex_ = 0;
+        std::size_t offset_ = 0;
+        bool open_ = false;
+        PageCache::Page page_;
+    };
+} // namespace cppminidb
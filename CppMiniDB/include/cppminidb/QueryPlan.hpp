@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cppminidb
+{
+    enum class CompareOp : uint8_t
+    {
+        Equal,
+        NotEqual,
+        Greater,
+        GreaterEqual,
+        Less,
+        LessEqual
+    };
+
+    /**
+     * @brief Parses an operator string ("==", "=", "!=", ">", ">=", "<", "<=").
+     * @throws std::invalid_argument for anything else.
+     */
+    CompareOp parseCompareOp(const std::string &op);
+
+    const char *toString(CompareOp op) noexcept;
+
+    /// One validated condition of a plan; the comparison value is bound at execution.
+    struct PlanPredicate
+    {
+        std::string column;
+        std::size_t columnIndex = 0; // position in the table schema
+        CompareOp op = CompareOp::Equal;
+        bool numeric = false; // ordering ops compare as numbers
+    };
+
+    /**
+     * @class QueryPlan
+     * @brief A condition list that has been validated and compiled once against a table schema.
+     *
+     * A plan only captures the query *shape* (columns and operators). Values are
+     * passed as bound parameters to MiniDB::execute(), one per predicate, so the
+     * same plan serves every query of that shape.
+     *
+     * Plans are immutable and safe to share between threads.
+     */
+    class QueryPlan
+    {
+    public:
+        QueryPlan(std::string shape, std::vector<PlanPredicate> predicates, uint64_t schemaVersion)
+            : shape_(std::move(shape)), predicates_(std::move(predicates)), schemaVersion_(schemaVersion) {}
+
+        /// Canonical shape key, e.g. "timestamp_ms >= ? AND sensor_id == ?".
+        const std::string &shape() const noexcept { return shape_; }
+        const std::vector<PlanPredicate> &predicates() const noexcept { return predicates_; }
+        std::size_t parameterCount() const noexcept { return predicates_.size(); }
+
+        /// Schema generation the plan was compiled against (see MiniDB::setColumns).
+        uint64_t schemaVersion() const noexcept { return schemaVersion_; }
+
+    private:
+        std::string shape_;
+        std::vector<PlanPredicate> predicates_;
+        uint64_t schemaVersion_;
+    };
+
+    using QueryPlanPtr = std::shared_ptr<const QueryPlan>;
+
+    /**
+     * @class QueryPlanCache
+     * @brief Small LRU of compiled plans keyed by query shape. Thread-safe.
+     */
+    class QueryPlanCache
+    {
+    public:
+        static constexpr std::size_t kDefaultCapacity = 32;
+
+        struct Stats
+        {
+            uint64_t hits = 0;
+            uint64_t misses = 0;
+            uint64_t evictions = 0;
+            std::size_t size = 0;
+        };
+
+        explicit QueryPlanCache(std::size_t capacity = kDefaultCapacity) : capacity_(capacity) {}
+
+        /// Returns the cached plan for `shape` (marking it most recently used), or nullptr.
+        QueryPlanPtr find(const std::string &shape);
+
+        /// Inserts or replaces a plan, evicting the least recently used one if full.
+        void insert(QueryPlanPtr plan);
+
+        void clear();
+        void setCapacity(std::size_t capacity);
+        Stats stats() const;
+
+    private:
+        void evictLocked();
+
+        mutable std::mutex mtx_;
+        std::size_t capacity_;
+        std::list<QueryPlanPtr> lru_; // front = most recently used
+        std::unordered_map<std::string, std::list<QueryPlanPtr>::iterator> index_;
+        Stats stats_;
+    };
+} // namespace cppminidb
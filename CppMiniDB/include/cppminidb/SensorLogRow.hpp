@@ -8,12 +8,21 @@
 
 namespace cppminidb
 {
+    /**
+     * One emitted sample. timestamp_ms is the millisecond time that sensors, MiniDB log
+     * rows and captures store (sub-millisecond scheduler time is truncated there);
+     * timestamp_us keeps the scheduler's full resolution, and toJSON() always emits it
+     * as "timestampUs".
+     */
     struct SensorLogRow
     {
         uint64_t timestamp_ms;
         std::string sensor_id;
         double value;
         std::vector<std::string> fault_flags;
+        uint64_t timestamp_us = 0; // full-resolution time when known (0 = ms only)
+        std::vector<double> channels{}; // every channel of a multi-channel sample (value == channels[0]); else empty
+        uint32_t sensor_handle = 0; // interned sensor_id (sensor::SensorHandle) when emitted by the scheduler; 0 = unknown
 
         nlohmann::json toJSON() const;
     };
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cppminidb/PageCache.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
+
+namespace cppminidb
+{
+    /**
+     * @class StorageManager
+     * @brief Shared memory budget for every table managed by a Database.
+     *
+     * Tables report the approximate heap footprint of their in-memory rows and
+     * log entries through tryReserve()/release(). Because a single StorageManager
+     * is shared across all tables of a Database, one busy table cannot grow
+     * without bound while the others starve: once the combined usage reaches the
+     * budget, further reservations are rejected.
+     *
+     * The StorageManager also owns the PageCache used by the disk read paths of
+     * its tables. Cached pages are charged against the same budget; when a table
+     * insert is rejected, MiniDB shrinks the cache before giving up.
+     *
+     * All methods are thread-safe.
+     */
+    class StorageManager
+    {
+    public:
+        static constexpr std::size_t kUnlimited = std::numeric_limits<std::size_t>::max();
+
+        explicit StorageManager(std::size_t budgetBytes = kUnlimited,
+                                std::size_t pageCacheBytes = PageCache::kDefaultCapacity);
+
+        StorageManager(const StorageManager &) = delete;
+        StorageManager &operator=(const StorageManager &) = delete;
+
+        /**
+         * @brief Reserves bytes against the shared budget.
+         * @return false if the reservation would exceed the budget (nothing is reserved).
+         */
+        bool tryReserve(std::size_t bytes) noexcept;
+
+        /**
+         * @brief Reserves bytes even if the budget is exceeded.
+         *
+         * Used for in-place updates where the data has already been modified and
+         * the accounting must stay truthful.
+         */
+        void forceReserve(std::size_t bytes) noexcept;
+
+        /**
+         * @brief Returns previously reserved bytes to the shared budget.
+         */
+        void release(std::size_t bytes) noexcept;
+
+        std::size_t used() const noexcept;
+        std::size_t budget() const noexcept;
+        std::size_t available() const noexcept;
+
+        /**
+         * @brief Changes the budget. Existing reservations are kept even if they exceed the new limit.
+         */
+        void setBudget(std::size_t budgetBytes) noexcept;
+
+        PageCache &pageCache() noexcept;
+        const PageCache &pageCache() const noexcept;
+
+    private:
+        std::atomic<std::size_t> budget_;
+        std::atomic<std::size_t> used_{0};
+        PageCache pageCache_; // declared last: releases its pages into used_ on destruction
+    };
+} // namespace cppminidb
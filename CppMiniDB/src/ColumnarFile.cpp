@@ -0,0 +1,832 @@
+#include "../include/cppminidb/ColumnarFile.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace cppminidb
+{
+    namespace
+    {
+        constexpr char kMagic[8] = {'M', 'D', 'B', 'C', 'O', 'L', '0', '1'};
+        constexpr char kTrailerMagic[8] = {'M', 'D', 'B', 'C', 'E', 'N', 'D', '1'};
+        constexpr uint64_t kFormatVersion = 1;
+        constexpr std::size_t kTrailerSize = 16; // footer offset + trailer magic
+        constexpr std::size_t kMaxDictionarySize = 1u << 16;
+        constexpr int kMaxDecimalDigits = 18; // keeps scaled values inside int64
+
+        // Byte helpers
+
+        void putVarint(std::string &out, uint64_t v)
+        {
+            while (v >= 0x80)
+            {
+                out.push_back(static_cast<char>((v & 0x7F) | 0x80));
+                v >>= 7;
+            }
+            out.push_back(static_cast<char>(v));
+        }
+
+        void putU64(std::string &out, uint64_t v)
+        {
+            for (int i = 0; i < 8; ++i)
+                out.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+        }
+
+        void putDouble(std::string &out, double d)
+        {
+            uint64_t bits = 0;
+            std::memcpy(&bits, &d, sizeof(bits));
+            putU64(out, bits);
+        }
+
+        void putString(std::string &out, const std::string &s)
+        {
+            putVarint(out, s.size());
+            out.append(s);
+        }
+
+        uint64_t zigzag(int64_t v)
+        {
+            return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+        }
+
+        int64_t unzigzag(uint64_t v)
+        {
+            return static_cast<int64_t>((v >> 1) ^ (~(v & 1) + 1));
+        }
+
+        /// Bounds-checked cursor over an in-memory byte block.
+        class ByteReader
+        {
+        public:
+            ByteReader(const char *data, std::size_t size) : p_(data), end_(data + size) {}
+
+            uint8_t u8()
+            {
+                need(1);
+                return static_cast<uint8_t>(*p_++);
+            }
+
+            uint64_t varint()
+            {
+                uint64_t v = 0;
+                for (int shift = 0; shift < 64; shift += 7)
+                {
+                    const uint8_t b = u8();
+                    v |= static_cast<uint64_t>(b & 0x7F) << shift;
+                    if ((b & 0x80) == 0)
+                        return v;
+                }
+                throw std::runtime_error("Columnar file corrupted: varint too long.");
+            }
+
+            uint64_t u64()
+            {
+                need(8);
+                uint64_t v = 0;
+                for (int i = 0; i < 8; ++i)
+                    v |= static_cast<uint64_t>(static_cast<uint8_t>(p_[i])) << (8 * i);
+                p_ += 8;
+                return v;
+            }
+
+            double f64()
+            {
+                const uint64_t bits = u64();
+                double d = 0.0;
+                std::memcpy(&d, &bits, sizeof(d));
+                return d;
+            }
+
+            std::string string()
+            {
+                const uint64_t len = varint();
+                need(len);
+                std::string s(p_, static_cast<std::size_t>(len));
+                p_ += len;
+                return s;
+            }
+
+            const char *take(std::size_t n)
+            {
+                need(n);
+                const char *at = p_;
+                p_ += n;
+                return at;
+            }
+
+        private:
+            void need(uint64_t n) const
+            {
+                if (static_cast<uint64_t>(end_ - p_) < n)
+                    throw std::runtime_error("Columnar file corrupted: unexpected end of block.");
+            }
+
+            const char *p_;
+            const char *end_;
+        };
+
+        // Value helpers
+
+        std::optional<double> parseNumber(const std::string &s)
+        {
+            if (s.empty())
+                return std::nullopt;
+            errno = 0;
+            char *end = nullptr;
+            const double d = std::strtod(s.c_str(), &end);
+            if (errno != 0 || end != s.c_str() + s.size())
+                return std::nullopt;
+            return d;
+        }
+
+        int64_t pow10(int exp)
+        {
+            int64_t r = 1;
+            for (int i = 0; i < exp; ++i)
+                r *= 10;
+            return r;
+        }
+
+        std::string formatDecimal(int64_t v, int scale)
+        {
+            if (scale == 0)
+                return std::to_string(v);
+
+            const bool negative = v < 0;
+            const uint64_t magnitude = negative ? ~static_cast<uint64_t>(v) + 1 : static_cast<uint64_t>(v);
+            const uint64_t divisor = static_cast<uint64_t>(pow10(scale));
+            std::string frac = std::to_string(magnitude % divisor);
+            frac.insert(0, static_cast<std::size_t>(scale) - frac.size(), '0');
+            return (negative ? "-" : "") + std::to_string(magnitude / divisor) + "." + frac;
+        }
+
+        /// Parses "[-]digits[.digits]" into a scaled integer. Only accepts cells that
+        /// formatDecimal() reproduces byte-for-byte.
+        bool parseDecimal(const std::string &cell, int64_t &value, int &scale)
+        {
+            std::size_t i = 0;
+            const bool negative = !cell.empty() && cell[0] == '-';
+            if (negative)
+                ++i;
+
+            int64_t magnitude = 0;
+            int digits = 0;
+            int fracDigits = 0;
+            bool seenDot = false;
+            for (; i < cell.size(); ++i)
+            {
+                const char c = cell[i];
+                if (c == '.' && !seenDot)
+                {
+                    seenDot = true;
+                    continue;
+                }
+                if (c < '0' || c > '9' || ++digits > kMaxDecimalDigits)
+                    return false;
+                magnitude = magnitude * 10 + (c - '0');
+                if (seenDot)
+                    ++fracDigits;
+            }
+            if (digits == 0 || (seenDot && fracDigits == 0))
+                return false;
+
+            value = negative ? -magnitude : magnitude;
+            scale = fracDigits;
+            return formatDecimal(value, scale) == cell;
+        }
+
+        bool isNumeric(MiniDB::ColumnType t)
+        {
+            return t == MiniDB::ColumnType::Int || t == MiniDB::ColumnType::Float;
+        }
+
+        // Column block encoders
+
+        bool encodeDeltaDecimal(const std::vector<std::string> &cells, std::string &out)
+        {
+            std::vector<int64_t> values(cells.size());
+            int scale = -1;
+            for (std::size_t i = 0; i < cells.size(); ++i)
+            {
+                int cellScale = 0;
+                if (!parseDecimal(cells[i], values[i], cellScale))
+                    return false;
+                if (scale == -1)
+                    scale = cellScale;
+                else if (cellScale != scale)
+                    return false;
+            }
+
+            out.push_back(static_cast<char>(ColumnEncoding::DeltaDecimal));
+            out.push_back(static_cast<char>(std::max(scale, 0)));
+            int64_t prev = 0;
+            for (int64_t v : values)
+            {
+                putVarint(out, zigzag(static_cast<int64_t>(static_cast<uint64_t>(v) - static_cast<uint64_t>(prev))));
+                prev = v;
+            }
+            return true;
+        }
+
+        bool encodeDictionary(const std::vector<std::string> &cells, std::string &out)
+        {
+            std::unordered_map<std::string, uint32_t> index;
+            std::vector<const std::string *> dictionary;
+            std::vector<uint32_t> codes;
+            codes.reserve(cells.size());
+
+            const std::size_t limit = std::min(kMaxDictionarySize, std::max<std::size_t>(1, cells.size() / 2));
+            for (const auto &cell : cells)
+            {
+                auto [it, inserted] = index.emplace(cell, static_cast<uint32_t>(dictionary.size()));
+                if (inserted)
+                {
+                    if (dictionary.size() >= limit)
+                        return false;
+                    dictionary.push_back(&it->first);
+                }
+                codes.push_back(it->second);
+            }
+
+            uint8_t width = 0;
+            while ((static_cast<std::size_t>(1) << width) < dictionary.size())
+                ++width;
+
+            out.push_back(static_cast<char>(ColumnEncoding::Dictionary));
+            putVarint(out, dictionary.size());
+            for (const auto *entry : dictionary)
+                putString(out, *entry);
+            out.push_back(static_cast<char>(width));
+
+            // Bit-pack codes LSB-first.
+            uint64_t acc = 0;
+            int bits = 0;
+            for (uint32_t code : codes)
+            {
+                acc |= static_cast<uint64_t>(code) << bits;
+                bits += width;
+                while (bits >= 8)
+                {
+                    out.push_back(static_cast<char>(acc & 0xFF));
+                    acc >>= 8;
+                    bits -= 8;
+                }
+            }
+            if (bits > 0)
+                out.push_back(static_cast<char>(acc & 0xFF));
+            return true;
+        }
+
+        void encodePlain(const std::vector<std::string> &cells, std::string &out)
+        {
+            out.push_back(static_cast<char>(ColumnEncoding::Plain));
+            for (const auto &cell : cells)
+                putString(out, cell);
+        }
+
+        std::vector<std::string> decodeBlock(const std::string &block, std::size_t rows)
+        {
+            ByteReader in(block.data(), block.size());
+            std::vector<std::string> cells;
+            cells.reserve(rows);
+
+            switch (static_cast<ColumnEncoding>(in.u8()))
+            {
+            case ColumnEncoding::Plain:
+                for (std::size_t i = 0; i < rows; ++i)
+                    cells.push_back(in.string());
+                break;
+
+            case ColumnEncoding::Dictionary:
+            {
+                std::vector<std::string> dictionary(static_cast<std::size_t>(in.varint()));
+                for (auto &entry : dictionary)
+                    entry = in.string();
+                const uint8_t width = in.u8();
+                if (width > 32)
+                    throw std::runtime_error("Columnar file corrupted: invalid dictionary code width.");
+                const std::size_t packedBytes = (rows * width + 7) / 8;
+                const auto *packed = reinterpret_cast<const uint8_t *>(in.take(packedBytes));
+
+                const uint64_t mask = (static_cast<uint64_t>(1) << width) - 1;
+                std::size_t bitPos = 0;
+                for (std::size_t i = 0; i < rows; ++i, bitPos += width)
+                {
+                    uint64_t code = 0;
+                    for (std::size_t b = bitPos / 8, shift = 0; shift < (bitPos % 8) + width; ++b, shift += 8)
+                        code |= static_cast<uint64_t>(packed[b]) << shift;
+                    code = (code >> (bitPos % 8)) & mask;
+                    if (code >= dictionary.size())
+                        throw std::runtime_error("Columnar file corrupted: dictionary code out of range.");
+                    cells.push_back(dictionary[code]);
+                }
+                break;
+            }
+
+            case ColumnEncoding::DeltaDecimal:
+            {
+                const int scale = in.u8();
+                int64_t value = 0;
+                for (std::size_t i = 0; i < rows; ++i)
+                {
+                    value = static_cast<int64_t>(static_cast<uint64_t>(value) + static_cast<uint64_t>(unzigzag(in.varint())));
+                    cells.push_back(formatDecimal(value, scale));
+                }
+                break;
+            }
+
+            default:
+                throw std::runtime_error("Columnar file corrupted: unknown column encoding.");
+            }
+            return cells;
+        }
+
+        ColumnStats computeStats(const std::vector<std::string> &cells, MiniDB::ColumnType type)
+        {
+            ColumnStats stats;
+            if (cells.empty())
+                return stats;
+
+            if (isNumeric(type))
+            {
+                // Cells that do not parse never satisfy a numeric predicate, so
+                // leaving them out of min/max keeps pruning correct.
+                bool any = false;
+                for (const auto &cell : cells)
+                {
+                    const auto number = parseNumber(cell);
+                    if (!number)
+                        continue;
+                    if (!any)
+                    {
+                        stats.minNumber = stats.maxNumber = *number;
+                        any = true;
+                    }
+                    stats.minNumber = std::min(stats.minNumber, *number);
+                    stats.maxNumber = std::max(stats.maxNumber, *number);
+                }
+                if (any)
+                    stats.kind = ColumnStats::Kind::Numeric;
+                return stats;
+            }
+
+            const auto [lo, hi] = std::minmax_element(cells.begin(), cells.end());
+            stats.kind = ColumnStats::Kind::String;
+            stats.minString = *lo;
+            stats.maxString = *hi;
+            return stats;
+        }
+
+        // Predicate helpers
+
+        const std::string &normalizeOp(const std::string &op)
+        {
+            static const std::string eq = "==";
+            return op == "=" ? eq : op;
+        }
+
+        bool compareNumbers(double a, const std::string &op, double b)
+        {
+            if (op == ">")
+                return a > b;
+            if (op == ">=")
+                return a >= b;
+            if (op == "<")
+                return a < b;
+            return a <= b;
+        }
+
+        /// True if no row in a chunk with these statistics can satisfy the condition.
+        /// As in MiniDB::execute, == and != compare the cell text exactly and only the
+        /// ordering operators compare numerically.
+        bool chunkRuledOut(const ColumnStats &stats, const std::string &op, const std::string &value,
+                           const std::optional<double> &number)
+        {
+            if (op == "==")
+            {
+                if (stats.kind == ColumnStats::Kind::String)
+                    return value < stats.minString || value > stats.maxString;
+                // A cell with the same text parses to the same number, so it lies in the
+                // chunk's numeric range; unparseable values can only match unparseable cells.
+                if (number)
+                    return stats.kind != ColumnStats::Kind::Numeric || *number < stats.minNumber ||
+                           *number > stats.maxNumber;
+                return false;
+            }
+            if (op == "!=")
+                return stats.kind == ColumnStats::Kind::String && stats.minString == value && stats.maxString == value;
+
+            // Ordering: numeric columns only, and unparseable cells never match.
+            if (stats.kind != ColumnStats::Kind::Numeric)
+                return true;
+            const double v = *number;
+            if (op == ">")
+                return stats.maxNumber <= v;
+            if (op == ">=")
+                return stats.maxNumber < v;
+            if (op == "<")
+                return stats.minNumber >= v;
+            if (op == "<=")
+                return stats.minNumber > v;
+            return false;
+        }
+    } // namespace
+
+    // ColumnarWriter
+
+    ColumnarWriter::ColumnarWriter(const std::string &path,
+                                   const std::vector<std::string> &columns,
+                                   const std::vector<MiniDB::ColumnType> &types,
+                                   std::size_t rowsPerChunk)
+        : path_(path), columns_(columns), types_(types),
+          rowsPerChunk_(rowsPerChunk == 0 ? kDefaultRowsPerChunk : rowsPerChunk),
+          pending_(columns.size())
+    {
+        if (columns_.empty())
+            throw std::invalid_argument("Columnar export requires at least one column.");
+        if (types_.size() != columns_.size())
+            types_.resize(columns_.size(), MiniDB::ColumnType::String);
+
+        out_.open(path_, std::ios::binary | std::ios::trunc);
+        if (!out_.is_open())
+            throw std::runtime_error("Failed to open file for writing: " + path_);
+
+        std::string schema;
+        putVarint(schema, kFormatVersion);
+        putVarint(schema, columns_.size());
+        for (std::size_t i = 0; i < columns_.size(); ++i)
+        {
+            putString(schema, columns_[i]);
+            schema.push_back(static_cast<char>(types_[i]));
+        }
+
+        std::string header(kMagic, sizeof(kMagic));
+        putU64(header, schema.size());
+        header.append(schema);
+        out_.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+        for (auto &column : pending_)
+            column.reserve(rowsPerChunk_);
+    }
+
+    ColumnarWriter::~ColumnarWriter()
+    {
+        try
+        {
+            close();
+        }
+        catch (...)
+        {
+            // Destructors must not throw; call close() explicitly to observe errors.
+        }
+    }
+
+    void ColumnarWriter::writeRow(const std::vector<std::string> &row)
+    {
+        if (closed_)
+            throw std::logic_error("ColumnarWriter is already closed.");
+
+        static const std::string empty;
+        for (std::size_t c = 0; c < columns_.size(); ++c)
+            pending_[c].push_back(c < row.size() ? row[c] : empty);
+
+        ++rowsWritten_;
+        if (++pendingRows_ == rowsPerChunk_)
+            flushChunk();
+    }
+
+    void ColumnarWriter::flushChunk()
+    {
+        if (pendingRows_ == 0)
+            return;
+
+        ChunkInfo chunk;
+        chunk.rowCount = pendingRows_;
+        chunk.columns.resize(columns_.size());
+
+        std::string block;
+        for (std::size_t c = 0; c < columns_.size(); ++c)
+        {
+            const auto &cells = pending_[c];
+            block.clear();
+            if (!(isNumeric(types_[c]) && encodeDeltaDecimal(cells, block)))
+            {
+                block.clear();
+                if (!encodeDictionary(cells, block))
+                {
+                    block.clear();
+                    encodePlain(cells, block);
+                }
+            }
+
+            auto &info = chunk.columns[c];
+            info.offset = static_cast<uint64_t>(out_.tellp());
+            info.length = block.size();
+            info.encoding = static_cast<ColumnEncoding>(block[0]);
+            info.stats = computeStats(cells, types_[c]);
+            out_.write(block.data(), static_cast<std::streamsize>(block.size()));
+
+            pending_[c].clear();
+        }
+        if (!out_)
+            throw std::runtime_error("Failed to write columnar chunk to: " + path_);
+
+        chunks_.push_back(std::move(chunk));
+        pendingRows_ = 0;
+    }
+
+    void ColumnarWriter::close()
+    {
+        if (closed_)
+            return;
+        closed_ = true;
+
+        flushChunk();
+
+        const uint64_t footerOffset = static_cast<uint64_t>(out_.tellp());
+        std::string footer;
+        putVarint(footer, chunks_.size());
+        for (const auto &chunk : chunks_)
+        {
+            putVarint(footer, chunk.rowCount);
+            for (const auto &col : chunk.columns)
+            {
+                putVarint(footer, col.offset);
+                putVarint(footer, col.length);
+                footer.push_back(static_cast<char>(col.encoding));
+                footer.push_back(static_cast<char>(col.stats.kind));
+                if (col.stats.kind == ColumnStats::Kind::Numeric)
+                {
+                    putDouble(footer, col.stats.minNumber);
+                    putDouble(footer, col.stats.maxNumber);
+                }
+                else if (col.stats.kind == ColumnStats::Kind::String)
+                {
+                    putString(footer, col.stats.minString);
+                    putString(footer, col.stats.maxString);
+                }
+            }
+        }
+        putU64(footer, footerOffset);
+        footer.append(kTrailerMagic, sizeof(kTrailerMagic));
+
+        out_.write(footer.data(), static_cast<std::streamsize>(footer.size()));
+        out_.close();
+        if (!out_)
+            throw std::runtime_error("Failed to finalize columnar file: " + path_);
+    }
+
+    // ColumnarReader
+
+    ColumnarReader::ColumnarReader(const std::string &path) : path_(path)
+    {
+        std::ifstream in(path_, std::ios::binary | std::ios::ate);
+        if (!in.is_open())
+            throw std::runtime_error("Failed to open columnar file: " + path_);
+
+        const auto fileSize = static_cast<uint64_t>(in.tellg());
+        if (fileSize < sizeof(kMagic) + 8 + kTrailerSize)
+            throw std::runtime_error("Not a columnar file: " + path_);
+
+        // Trailer → footer offset.
+        char trailer[kTrailerSize];
+        in.seekg(static_cast<std::streamoff>(fileSize - kTrailerSize));
+        in.read(trailer, kTrailerSize);
+        if (!in || std::memcmp(trailer + 8, kTrailerMagic, sizeof(kTrailerMagic)) != 0)
+            throw std::runtime_error("Not a columnar file: " + path_);
+        const uint64_t footerOffset = ByteReader(trailer, 8).u64();
+        if (footerOffset < sizeof(kMagic) + 8 || footerOffset > fileSize - kTrailerSize)
+            throw std::runtime_error("Columnar file corrupted: bad footer offset.");
+
+        // Header: magic, schema length, schema.
+        char prefix[sizeof(kMagic) + 8];
+        in.seekg(0);
+        in.read(prefix, sizeof(prefix));
+        if (!in || std::memcmp(prefix, kMagic, sizeof(kMagic)) != 0)
+            throw std::runtime_error("Not a columnar file: " + path_);
+        const uint64_t schemaSize = ByteReader(prefix + sizeof(kMagic), 8).u64();
+        if (schemaSize > footerOffset - sizeof(prefix))
+            throw std::runtime_error("Columnar file corrupted: bad header length.");
+
+        std::string schema(static_cast<std::size_t>(schemaSize), '\0');
+        in.read(schema.data(), static_cast<std::streamsize>(schema.size()));
+
+        std::string footer(static_cast<std::size_t>(fileSize - kTrailerSize - footerOffset), '\0');
+        in.seekg(static_cast<std::streamoff>(footerOffset));
+        in.read(footer.data(), static_cast<std::streamsize>(footer.size()));
+        if (!in)
+            throw std::runtime_error("Columnar file corrupted: short read in " + path_);
+
+        ByteReader hr(schema.data(), schema.size());
+        if (hr.varint() != kFormatVersion)
+            throw std::runtime_error("Unsupported columnar file version: " + path_);
+        const uint64_t columnCount = hr.varint();
+        for (uint64_t i = 0; i < columnCount; ++i)
+        {
+            columns_.push_back(hr.string());
+            const uint8_t type = hr.u8();
+            if (type > static_cast<uint8_t>(MiniDB::ColumnType::Float))
+                throw std::runtime_error("Columnar file corrupted: unknown column type.");
+            types_.push_back(static_cast<MiniDB::ColumnType>(type));
+        }
+
+        // Footer.
+        ByteReader fr(footer.data(), footer.size());
+        const uint64_t chunkCount = fr.varint();
+        chunks_.resize(static_cast<std::size_t>(chunkCount));
+        for (auto &chunk : chunks_)
+        {
+            chunk.rowCount = fr.varint();
+            chunk.columns.resize(columns_.size());
+            for (auto &col : chunk.columns)
+            {
+                col.offset = fr.varint();
+                col.length = fr.varint();
+                col.encoding = static_cast<ColumnEncoding>(fr.u8());
+                col.stats.kind = static_cast<ColumnStats::Kind>(fr.u8());
+                if (col.stats.kind == ColumnStats::Kind::Numeric)
+                {
+                    col.stats.minNumber = fr.f64();
+                    col.stats.maxNumber = fr.f64();
+                }
+                else if (col.stats.kind == ColumnStats::Kind::String)
+                {
+                    col.stats.minString = fr.string();
+                    col.stats.maxString = fr.string();
+                }
+                if (col.offset + col.length > footerOffset)
+                    throw std::runtime_error("Columnar file corrupted: column block out of range.");
+            }
+        }
+    }
+
+    std::size_t ColumnarReader::rowCount() const noexcept
+    {
+        std::size_t total = 0;
+        for (const auto &chunk : chunks_)
+            total += static_cast<std::size_t>(chunk.rowCount);
+        return total;
+    }
+
+    std::size_t ColumnarReader::columnIndex(const std::string &name) const
+    {
+        auto it = std::find(columns_.begin(), columns_.end(), name);
+        if (it == columns_.end())
+            throw std::invalid_argument("Column not found: " + name);
+        return static_cast<std::size_t>(std::distance(columns_.begin(), it));
+    }
+
+    std::ifstream ColumnarReader::openFile() const
+    {
+        std::ifstream in(path_, std::ios::binary);
+        if (!in.is_open())
+            throw std::runtime_error("Failed to open columnar file: " + path_);
+        return in;
+    }
+
+    std::vector<std::string> ColumnarReader::readColumn(std::size_t chunk, std::size_t column) const
+    {
+        std::ifstream in = openFile();
+        return readColumn(in, chunk, column);
+    }
+
+    std::vector<std::string> ColumnarReader::readColumn(std::ifstream &in, std::size_t chunk, std::size_t column) const
+    {
+        const auto &info = chunks_.at(chunk).columns.at(column);
+
+        std::string block(static_cast<std::size_t>(info.length), '\0');
+        in.seekg(static_cast<std::streamoff>(info.offset));
+        in.read(block.data(), static_cast<std::streamsize>(block.size()));
+        if (!in)
+            throw std::runtime_error("Columnar file corrupted: short read in " + path_);
+
+        return decodeBlock(block, static_cast<std::size_t>(chunks_[chunk].rowCount));
+    }
+
+    std::vector<std::vector<std::string>> ColumnarReader::readAll() const
+    {
+        std::ifstream in = openFile();
+        std::vector<std::vector<std::string>> rows;
+        rows.reserve(rowCount());
+        for (std::size_t k = 0; k < chunks_.size(); ++k)
+        {
+            std::vector<std::vector<std::string>> cols;
+            for (std::size_t c = 0; c < columns_.size(); ++c)
+                cols.push_back(readColumn(in, k, c));
+
+            for (std::size_t r = 0; r < chunks_[k].rowCount; ++r)
+            {
+                std::vector<std::string> row;
+                row.reserve(columns_.size());
+                for (auto &col : cols)
+                    row.push_back(std::move(col[r]));
+                rows.push_back(std::move(row));
+            }
+        }
+        return rows;
+    }
+
+    std::vector<std::map<std::string, std::string>> ColumnarReader::select(const std::vector<Condition> &conditions,
+                                                                           ScanStats *scanStats) const
+    {
+        struct Predicate
+        {
+            std::size_t column;
+            std::string op;
+            std::string value;
+            std::optional<double> number; // the value parsed, on numeric columns
+            bool numeric;                 // ordering operator, compared as numbers
+        };
+
+        std::vector<Predicate> predicates;
+        for (const auto &cond : conditions)
+        {
+            Predicate p;
+            p.column = columnIndex(cond.column);
+            p.op = normalizeOp(cond.op);
+            p.value = cond.value;
+            if (!MiniDB::isOpAllowedForType(p.op, types_[p.column]))
+                throw std::invalid_argument("Operator not allowed for this column type:" + cond.op);
+            if (isNumeric(types_[p.column]))
+                p.number = parseNumber(cond.value);
+            p.numeric = p.op != "==" && p.op != "!=";
+            if (p.numeric && !p.number)
+                throw std::invalid_argument("Value '" + cond.value + "' for column '" + cond.column + "' is not numeric");
+            predicates.push_back(std::move(p));
+        }
+
+        ScanStats local;
+        local.chunksTotal = chunks_.size();
+        std::vector<std::map<std::string, std::string>> result;
+        std::ifstream in = openFile();
+
+        for (std::size_t k = 0; k < chunks_.size(); ++k)
+        {
+            const auto &chunk = chunks_[k];
+            const bool skip = std::any_of(predicates.begin(), predicates.end(), [&](const Predicate &p)
+                                          { return chunkRuledOut(chunk.columns[p.column].stats, p.op, p.value, p.number); });
+            if (skip)
+            {
+                ++local.chunksSkipped;
+                continue;
+            }
+
+            const auto rows = static_cast<std::size_t>(chunk.rowCount);
+            local.rowsScanned += rows;
+
+            // Decode filter columns first; everything else only if something matches.
+            std::vector<std::optional<std::vector<std::string>>> decoded(columns_.size());
+            std::vector<bool> match(rows, true);
+            for (const auto &p : predicates)
+            {
+                if (!decoded[p.column])
+                    decoded[p.column] = readColumn(in, k, p.column);
+                const auto &cells = *decoded[p.column];
+                for (std::size_t r = 0; r < rows; ++r)
+                {
+                    if (!match[r])
+                        continue;
+                    if (p.numeric)
+                    {
+                        const auto lhs = parseNumber(cells[r]);
+                        match[r] = lhs && compareNumbers(*lhs, p.op, *p.number);
+                    }
+                    else
+                    {
+                        match[r] = (p.op == "==") ? cells[r] == p.value : cells[r] != p.value;
+                    }
+                }
+            }
+
+            if (std::none_of(match.begin(), match.end(), [](bool m)
+                             { return m; }))
+                continue;
+
+            for (std::size_t c = 0; c < columns_.size(); ++c)
+                if (!decoded[c])
+                    decoded[c] = readColumn(in, k, c);
+
+            for (std::size_t r = 0; r < rows; ++r)
+            {
+                if (!match[r])
+                    continue;
+                std::map<std::string, std::string> row;
+                for (std::size_t c = 0; c < columns_.size(); ++c)
+                    row[columns_[c]] = (*decoded[c])[r];
+                result.push_back(std::move(row));
+                ++local.rowsMatched;
+            }
+        }
+
+        if (scanStats)
+            *scanStats = local;
+        return result;
+    }
+} // namespace cppminidb
@@ -0,0 +1,117 @@
+#include "../include/cppminidb/Database.hpp"
+
+#include <filesystem>
+#include <stdexcept>
+
+namespace cppminidb
+{
+    Database::Database(const std::string &dataDir, std::size_t memoryBudgetBytes, std::size_t pageCacheBytes)
+        : dataDir_(dataDir), storage_(memoryBudgetBytes, pageCacheBytes)
+    {
+        std::filesystem::create_directories(dataDir_);
+    }
+
+    MiniDB &Database::createTable(const std::string &name,
+                                  const std::vector<std::string> &columns,
+                                  const std::vector<MiniDB::ColumnType> &types)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (tables_.count(name))
+            throw std::invalid_argument("Table already exists: " + name);
+
+        auto table = std::make_unique<MiniDB>(name, dataDir_, &storage_);
+        table->setColumns(columns, types);
+
+        MiniDB &ref = *table;
+        tables_.emplace(name, std::move(table));
+        return ref;
+    }
+
+    MiniDB &Database::openTable(const std::string &name)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        auto it = tables_.find(name);
+        if (it == tables_.end())
+        {
+            it = tables_.emplace(name, std::make_unique<MiniDB>(name, dataDir_, &storage_)).first;
+        }
+        return *it->second;
+    }
+
+    MiniDB *Database::getTable(const std::string &name) const
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        auto it = tables_.find(name);
+        return it != tables_.end() ? it->second.get() : nullptr;
+    }
+
+    bool Database::hasTable(const std::string &name) const
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        return tables_.count(name) != 0;
+    }
+
+    bool Database::dropTable(const std::string &name, bool removeFile)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        auto it = tables_.find(name);
+        if (it == tables_.end())
+            return false;
+
+        // The cache is shared by the catalog, so a dropped table's pages would otherwise
+        // stay resident (and charged to the budget) until LRU pressure pushed them out
+        it->second->evictCachedPages();
+        if (removeFile)
+            it->second->clearDisk(false);
+
+        tables_.erase(it);
+        return true;
+    }
+
+    std::vector<std::string> Database::tableNames() const
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        std::vector<std::string> names;
+        names.reserve(tables_.size());
+        for (const auto &[name, _] : tables_)
+        {
+            names.push_back(name);
+        }
+        return names;
+    }
+
+    void Database::saveAll() const
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        for (const auto &[_, table] : tables_)
+        {
+            if (table->columnCount() > 0)
+                table->save();
+        }
+    }
+
+    const std::string &Database::dataDirectory() const noexcept
+    {
+        return dataDir_;
+    }
+
+    StorageManager &Database::storage() noexcept
+    {
+        return storage_;
+    }
+
+    const StorageManager &Database::storage() const noexcept
+    {
+        return storage_;
+    }
+
+    PageCache::Stats Database::pageCacheStats() const
+    {
+        return storage_.pageCache().stats();
+    }
+
+    std::size_t Database::memoryUsage() const noexcept
+    {
+        return storage_.used();
+    }
+} // namespace cppminidb
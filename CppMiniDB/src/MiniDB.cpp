@@ -1,5 +1,10 @@
 #include "../include/cppminidb/MiniDB.hpp"
+#include "../include/cppminidb/StorageManager.hpp"
+#include "../include/cppminidb/PageCache.hpp"
+#include "../include/cppminidb/ColumnarFile.hpp"
 #include <fstream>
+#include <cerrno>
+#include <cstdlib>
 #include <sstream>
 #include <iostream>
 #include <filesystem>
@@ -8,12 +13,21 @@
 
 MiniDB::MiniDB(const std::string &tableName) : tableName_(tableName) {}
 
+MiniDB::MiniDB(const std::string &tableName, const std::string &dataDir, cppminidb::StorageManager *storage)
+    : tableName_(tableName), dataDir_(dataDir), storage_(storage) {}
+
+MiniDB::~MiniDB()
+{
+    releaseMemory(rowBytes_ + logBytes_);
+}
+
 void MiniDB::setColumns(const std::vector<std::string> &names)
 {
     if (names.empty())
         throw std::runtime_error("Column names cannot be empty.");
     columns_ = names;
     columnTypes_.assign(names.size(), ColumnType::String);
+    schemaChanged();
 }
 
 void MiniDB::setColumns(const std::vector<std::string> &names, const std::vector<ColumnType> &types)
@@ -27,6 +41,7 @@ void MiniDB::setColumns(const std::vector<std::string> &names, const std::vector
 
     columns_ = names;
     columnTypes_ = types;
+    schemaChanged();
 }
 
 MiniDB::ColumnType MiniDB::columnTypeOf(const std::string &columnName) const
@@ -56,24 +71,27 @@ void MiniDB::insertRow(const std::vector<std::string> &values)
         throw std::invalid_argument("Number of values must match the number of columns.");
     }
 
+    const std::size_t bytes = rowFootprint(values);
+    reserveMemory(bytes);
     rows_.push_back(values);
+    rowBytes_ += bytes;
 }
 
 std::string MiniDB::getTableFilePath() const
 {
-    return "./data/" + tableName_ + ".tbl";
+    return (std::filesystem::path(dataDir_) / (tableName_ + ".tbl")).string();
 }
 
 std::string MiniDB::getTempFilePath() const
 {
-    return "./data/" + tableName_ + "_temp.tbl";
+    return (std::filesystem::path(dataDir_) / (tableName_ + "_temp.tbl")).string();
 }
 
 void MiniDB::save() const
 {
     std::lock_guard<std::mutex> lock(mtx_);
 
-    std::filesystem::create_directories("data");
+    std::filesystem::create_directories(dataDir_);
     std::ofstream outFile(getTableFilePath(), std::ios::trunc); // overwrite;
     if (!outFile.is_open())
     {
@@ -99,14 +117,16 @@ void MiniDB::save() const
         }
         outFile << "\n";
     }
+    outFile.close();
+    pageCache().invalidate(getTableFilePath());
 }
 
 std::vector<std::map<std::string, std::string>> MiniDB::loadFromDisk() const
 {
     std::vector<std::map<std::string, std::string>> result;
 
-    std::ifstream inFile(getTableFilePath());
-    if (!inFile.is_open())
+    cppminidb::PagedFileReader inFile(pageCache(), getTableFilePath());
+    if (!inFile.isOpen())
     {
         // throw std::runtime_error("Failed to open file for reading:" + getTableFilePath());
         return {};
@@ -115,7 +135,7 @@ std::vector<std::map<std::string, std::string>> MiniDB::loadFromDisk() const
     std::string line;
 
     // read column headers
-    std::getline(inFile, line);
+    inFile.getline(line);
     std::vector<std::string> fileColumns;
     std::stringstream headerStream(line);
     std::string header;
@@ -125,7 +145,7 @@ std::vector<std::map<std::string, std::string>> MiniDB::loadFromDisk() const
     }
 
     // read data rows
-    while (std::getline(inFile, line))
+    while (inFile.getline(line))
     {
         std::vector<std::string> values;
         std::stringstream rowStream(line);
@@ -180,6 +200,8 @@ void MiniDB::clear()
 
     // Clear the in-memory rows
     rows_.clear();
+    releaseMemory(rowBytes_);
+    rowBytes_ = 0;
 
     // Clear the disk file by opening with trunc mode
     std::ofstream outFile(getTableFilePath(), std::ios::trunc);
@@ -197,6 +219,8 @@ void MiniDB::clear()
             outFile << ",";
     }
     outFile << "\n";
+    outFile.close();
+    pageCache().invalidate(getTableFilePath());
 }
 
 std::string MiniDB::exportToJsonLegacy() const
@@ -341,8 +365,8 @@ std::vector<std::map<std::string, std::string>> MiniDB::selectWhereFromDisk(
 {
     std::vector<std::map<std::string, std::string>> result;
 
-    std::ifstream inFile(getTableFilePath());
-    if (!inFile.is_open())
+    cppminidb::PagedFileReader inFile(pageCache(), getTableFilePath());
+    if (!inFile.isOpen())
     {
         throw std::runtime_error("Failed to open file for reading.");
     }
@@ -350,7 +374,7 @@ std::vector<std::map<std::string, std::string>> MiniDB::selectWhereFromDisk(
     std::string line;
 
     // read column headers
-    std::getline(inFile, line);
+    inFile.getline(line);
     std::vector<std::string> fileColumns;
     std::stringstream headerStream(line);
     std::string header;
@@ -360,7 +384,7 @@ std::vector<std::map<std::string, std::string>> MiniDB::selectWhereFromDisk(
     }
 
     // read data rows
-    while (std::getline(inFile, line))
+    while (inFile.getline(line))
     {
         std::vector<std::string> values;
         std::stringstream rowStream(line);
@@ -478,6 +502,7 @@ void MiniDB::updateWhereFromMemory(const std::string &column,
             }
         }
     }
+    syncRowBytes();
 }
 
 void MiniDB::updateWhereFromDisk(const std::string &column,
@@ -573,6 +598,7 @@ void MiniDB::updateWhereFromDisk(const std::string &column,
     inFile.close();
     outFile.close();
     std::filesystem::rename(getTempFilePath(), getTableFilePath());
+    pageCache().invalidate(getTableFilePath());
 }
 
 void MiniDB::deleteWhereFromMemory(const std::string &column,
@@ -613,6 +639,7 @@ void MiniDB::deleteWhereFromMemory(const std::string &column,
         });
 
     rows_.erase(filteredRows, rows_.end());
+    syncRowBytes();
 }
 
 void MiniDB::deleteWhereFromDisk(const std::string &column,
@@ -698,6 +725,7 @@ void MiniDB::deleteWhereFromDisk(const std::string &column,
     inFile.close();
     outFile.close();
     std::filesystem::rename(getTempFilePath(), getTableFilePath());
+    pageCache().invalidate(getTableFilePath());
 }
 
 std::string MiniDB::exportToJson() const
@@ -726,12 +754,12 @@ std::string MiniDB::exportToJson() const
 
 std::string MiniDB::exportToJsonFromDisk() const
 {
-    std::ifstream inFile(getTableFilePath());
-    if (!inFile.is_open())
+    cppminidb::PagedFileReader inFile(pageCache(), getTableFilePath());
+    if (!inFile.isOpen())
         throw std::runtime_error("Failed to open file for reading.");
 
     std::string line;
-    std::getline(inFile, line);
+    inFile.getline(line);
     std::vector<std::string> fileColumns;
     std::stringstream headerStream(line);
     std::string header;
@@ -743,7 +771,7 @@ std::string MiniDB::exportToJsonFromDisk() const
     // start building JSON array
     nlohmann::json jsonArray = nlohmann::json::array();
 
-    while (getline(inFile, line))
+    while (inFile.getline(line))
     {
         std::vector<std::string> rowValues;
         std::stringstream rowStream(line);
@@ -769,6 +797,57 @@ std::string MiniDB::exportToJsonFromDisk() const
     return jsonArray.dump(4);
 }
 
+std::size_t MiniDB::exportToColumnar(const std::string &filePath, bool fromDisk, std::size_t rowsPerChunk) const
+{
+    if (!fromDisk)
+    {
+        if (columns_.empty())
+            throw std::runtime_error("No columns defined. Columns must be defined before exporting.");
+
+        std::lock_guard<std::mutex> lock(mtx_);
+        cppminidb::ColumnarWriter writer(filePath, columns_, columnTypes_, rowsPerChunk);
+        for (const auto &row : rows_)
+            writer.writeRow(row);
+        writer.close();
+        return writer.rowsWritten();
+    }
+
+    cppminidb::PagedFileReader inFile(pageCache(), getTableFilePath());
+    if (!inFile.isOpen())
+        throw std::runtime_error("Failed to open file for reading.");
+
+    std::string line;
+    inFile.getline(line);
+    std::vector<std::string> fileColumns;
+    std::stringstream headerStream(line);
+    std::string header;
+    while (std::getline(headerStream, header, ','))
+    {
+        fileColumns.push_back(header);
+    }
+
+    // Keep declared types for known columns so numbers get delta-encoded.
+    std::vector<ColumnType> fileTypes;
+    for (const auto &col : fileColumns)
+        fileTypes.push_back(hasColumn(col) ? columnTypeOf(col) : ColumnType::String);
+
+    cppminidb::ColumnarWriter writer(filePath, fileColumns, fileTypes, rowsPerChunk);
+    std::vector<std::string> rowValues;
+    while (inFile.getline(line))
+    {
+        rowValues.clear();
+        std::stringstream rowStream(line);
+        std::string cell;
+        while (std::getline(rowStream, cell, ','))
+        {
+            rowValues.push_back(cell);
+        }
+        writer.writeRow(rowValues);
+    }
+    writer.close();
+    return writer.rowsWritten();
+}
+
 void MiniDB::importFromJson(const std::string &jsonString)
 {
 
@@ -794,6 +873,7 @@ void MiniDB::importFromJson(const std::string &jsonString)
         {
             columns_.push_back(it.key());
         }
+        schemaChanged();
     }
     else
     {
@@ -819,7 +899,10 @@ void MiniDB::importFromJson(const std::string &jsonString)
         {
             row.push_back(item[column].get<std::string>());
         }
-        rows_.push_back(row);
+        const std::size_t bytes = rowFootprint(row);
+        reserveMemory(bytes);
+        rows_.push_back(std::move(row));
+        rowBytes_ += bytes;
     }
 }
 
@@ -851,7 +934,7 @@ void MiniDB::importFromJsonToDisk(const std::string &jsonString, bool append)
         jsonColumns.push_back(it.key());
     }
 
-    std::filesystem::create_directories("data");
+    std::filesystem::create_directories(dataDir_);
     const std::string tableFilePath = getTableFilePath();
 
     if (!append)
@@ -962,17 +1045,22 @@ void MiniDB::importFromJsonToDisk(const std::string &jsonString, bool append)
         }
         outFile.close();
     }
+    pageCache().invalidate(tableFilePath);
 }
 
 void MiniDB::clearMemory()
 {
     rows_.clear();
     logs_.clear();
+    releaseMemory(rowBytes_ + logBytes_);
+    rowBytes_ = 0;
+    logBytes_ = 0;
 }
 
 void MiniDB::clearDisk(bool keepHeader)
 {
     const std::string path = getTableFilePath();
+    pageCache().invalidate(path);
 
     if (!std::filesystem::exists(path))
         return;
@@ -1021,6 +1109,86 @@ std::size_t MiniDB::rowCount() const noexcept
     return rows_.size();
 }
 
+const std::string &MiniDB::dataDirectory() const noexcept
+{
+    return dataDir_;
+}
+
+std::size_t MiniDB::memoryUsage() const noexcept
+{
+    return rowBytes_ + logBytes_;
+}
+
+cppminidb::PageCache::Stats MiniDB::pageCacheStats() const
+{
+    return pageCache().stats();
+}
+
+void MiniDB::evictCachedPages() const
+{
+    pageCache().invalidate(getTableFilePath());
+}
+
+cppminidb::PageCache &MiniDB::pageCache() const
+{
+    return storage_ ? storage_->pageCache() : cppminidb::PageCache::shared();
+}
+
+std::size_t MiniDB::rowFootprint(const std::vector<std::string> &row)
+{
+    std::size_t bytes = sizeof(std::vector<std::string>);
+    for (const auto &cell : row)
+        bytes += sizeof(std::string) + cell.size();
+    return bytes;
+}
+
+std::size_t MiniDB::logFootprint(const LogEntry &entry)
+{
+    std::size_t bytes = sizeof(LogEntry) + entry.sensorId.size();
+    for (const auto &fault : entry.faults)
+        bytes += sizeof(std::string) + fault.size();
+    bytes += entry.channels.size() * sizeof(double);
+    return bytes;
+}
+
+void MiniDB::reserveMemory(std::size_t bytes)
+{
+    if (!storage_ || storage_->tryReserve(bytes))
+        return;
+
+    // Cached pages are the cheapest memory to give back: evict them before rejecting the insert.
+    storage_->pageCache().shrink(bytes);
+    if (!storage_->tryReserve(bytes))
+    {
+        throw std::runtime_error("Memory budget exceeded while growing table: " + tableName_);
+    }
+}
+
+void MiniDB::releaseMemory(std::size_t bytes)
+{
+    if (storage_ && bytes > 0)
+        storage_->release(bytes);
+}
+
+void MiniDB::syncRowBytes()
+{
+    std::size_t actual = 0;
+    for (const auto &row : rows_)
+        actual += rowFootprint(row);
+
+    if (actual > rowBytes_)
+    {
+        // Rows were already modified in place, so the growth is charged even past the budget.
+        if (storage_)
+            storage_->forceReserve(actual - rowBytes_);
+    }
+    else
+    {
+        releaseMemory(rowBytes_ - actual);
+    }
+    rowBytes_ = actual;
+}
+
 bool MiniDB::isOpAllowedForType(const std::string &op, ColumnType t)
 {
     if (op == "==" || op == "!=")
@@ -1072,7 +1240,16 @@ void MiniDB::appendLog(const std::string &sensorId,
                        double value,
                        const std::vector<std::string> &faults)
 {
-    std::lock_guard<std::mutex> lock(mtx_);
+    std::unique_lock<std::mutex> lock(mtx_);
+    // Anything but the one-channel log schema (wide or reordered) needs name-based
+    // placement; checked under the lock since widenLogColumns() may run concurrently
+    if (!scalarLogSchema_)
+    {
+        lock.unlock();
+        appendLog(sensorId, timestampMs, std::span<const double>(&value, 1), faults);
+        return;
+    }
+
     std::string faultFlags;
     for (size_t i = 0; i < faults.size(); ++i)
     {
@@ -1087,8 +1264,136 @@ void MiniDB::appendLog(const std::string &sensorId,
     row.push_back(std::to_string(value));
     row.push_back(faultFlags.empty() ? "-" : faultFlags);
 
-    insertRow(row);
-    logs_.push_back(LogEntry{timestampMs, sensorId, value, faults});
+    LogEntry entry{timestampMs, sensorId, value, faults, {}};
+    const std::size_t logBytes = logFootprint(entry);
+    reserveMemory(logBytes);
+    try
+    {
+        insertRow(row);
+    }
+    catch (...)
+    {
+        releaseMemory(logBytes);
+        throw;
+    }
+    logs_.push_back(std::move(entry));
+    logBytes_ += logBytes;
+}
+
+void MiniDB::appendLog(const std::string &sensorId,
+                       uint64_t timestampMs,
+                       std::span<const double> values,
+                       const std::vector<std::string> &faults)
+{
+    if (values.empty())
+    {
+        throw std::invalid_argument("appendLog requires at least one value.");
+    }
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    std::string faultFlags;
+    for (size_t i = 0; i < faults.size(); ++i)
+    {
+        faultFlags += faults[i];
+        if (i < faults.size() - 1)
+            faultFlags += ",";
+    }
+
+    std::vector<std::string> row;
+    row.reserve(columns_.size());
+    std::size_t placed = 0;
+    for (const auto &column : columns_)
+    {
+        if (column == "timestamp_ms")
+            row.push_back(std::to_string(timestampMs));
+        else if (column == "sensor_id")
+            row.push_back(sensorId);
+        else if (column == "fault_flags")
+            row.push_back(faultFlags.empty() ? "-" : faultFlags);
+        else if (const auto channel = logValueChannel(column); channel && *channel < values.size())
+        {
+            row.push_back(std::to_string(values[*channel]));
+            ++placed;
+        }
+        else
+            row.emplace_back();
+    }
+    if (placed < values.size())
+    {
+        throw std::invalid_argument("Log table '" + tableName_ + "' has no column for all " +
+                                    std::to_string(values.size()) + " channels.");
+    }
+
+    LogEntry entry{timestampMs, sensorId, values[0], faults, {}};
+    if (values.size() > 1)
+        entry.channels.assign(values.begin(), values.end());
+    const std::size_t logBytes = logFootprint(entry);
+    reserveMemory(logBytes);
+    try
+    {
+        insertRow(row);
+    }
+    catch (...)
+    {
+        releaseMemory(logBytes);
+        throw;
+    }
+    logs_.push_back(std::move(entry));
+    logBytes_ += logBytes;
+}
+
+std::optional<std::size_t> MiniDB::logValueChannel(const std::string &column)
+{
+    if (column == "value")
+        return 0;
+    if (column.size() <= 6 || column.compare(0, 6, "value_") != 0)
+        return std::nullopt;
+    std::size_t channel = 0;
+    for (std::size_t i = 6; i < column.size(); ++i)
+    {
+        if (column[i] < '0' || column[i] > '9')
+            return std::nullopt;
+        channel = channel * 10 + static_cast<std::size_t>(column[i] - '0');
+    }
+    return channel;
+}
+
+std::vector<std::string> MiniDB::logColumns(std::size_t channels)
+{
+    std::vector<std::string> names{"timestamp_ms", "sensor_id", "value"};
+    for (std::size_t c = 1; c < channels; ++c)
+        names.push_back("value_" + std::to_string(c));
+    names.push_back("fault_flags");
+    return names;
+}
+
+std::vector<MiniDB::ColumnType> MiniDB::logColumnTypes(std::size_t channels)
+{
+    std::vector<ColumnType> types{ColumnType::Int, ColumnType::String};
+    types.insert(types.end(), std::max<std::size_t>(channels, 1), ColumnType::Float);
+    types.push_back(ColumnType::String);
+    return types;
+}
+
+void MiniDB::widenLogColumns(std::size_t channels)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    const std::size_t current = columns_.size() > 3 ? columns_.size() - 3 : 0;
+    if (current == 0 || columns_ != logColumns(current))
+        throw std::logic_error("Table '" + tableName_ + "' does not have a sensor log schema.");
+    if (channels <= current)
+        return;
+
+    const std::size_t added = channels - current;
+    const std::size_t bytes = rows_.size() * added * sizeof(std::string);
+    reserveMemory(bytes);
+    for (auto &row : rows_)
+        row.insert(row.end() - 1, added, std::string{}); // before fault_flags
+    rowBytes_ += bytes;
+
+    columns_ = logColumns(channels);
+    columnTypes_ = logColumnTypes(channels);
+    schemaChanged();
 }
 
 const std::vector<LogEntry> &MiniDB::getLogs() const
@@ -1099,6 +1404,8 @@ const std::vector<LogEntry> &MiniDB::getLogs() const
 void MiniDB::loadLogsIntoMemory()
 {
     logs_.clear();
+    releaseMemory(logBytes_);
+    logBytes_ = 0;
 
     auto loaded = loadFromDisk();
     for (const auto &row : loaded)
@@ -1118,7 +1425,20 @@ void MiniDB::loadLogsIntoMemory()
                 faults.push_back(fault);
             }
         }
-        logs_.push_back(LogEntry{ts, sensorId, value, faults});
+        LogEntry entry{ts, sensorId, value, faults, {}};
+        for (std::size_t c = 1;; ++c)
+        {
+            auto cell = row.find("value_" + std::to_string(c));
+            if (cell == row.end() || cell->second.empty())
+                break;
+            if (entry.channels.empty())
+                entry.channels.push_back(value);
+            entry.channels.push_back(std::stod(cell->second));
+        }
+        const std::size_t bytes = logFootprint(entry);
+        reserveMemory(bytes);
+        logs_.push_back(std::move(entry));
+        logBytes_ += bytes;
     }
 }
 
@@ -1130,103 +1450,233 @@ std::vector<LogEntry> MiniDB::getLogsSnapshot() const
 
 std::vector<std::map<std::string, std::string>> MiniDB::selectWhereMulti(const std::vector<Condition> &conditions, bool fromDisk) const
 {
-    auto rows = fromDisk ? loadFromDisk() : selectAll();
-    std::vector<std::map<std::string, std::string>> result;
+    std::vector<std::string> params;
+    params.reserve(conditions.size());
+    for (const auto &condition : conditions)
+    {
+        params.push_back(condition.value);
+    }
+    return execute(*prepare(conditions), params, fromDisk);
+}
 
-    for (const auto &row : rows)
+namespace
+{
+    bool parseDouble(const std::string &s, double &out)
+    {
+        if (s.empty())
+            return false;
+        char *end = nullptr;
+        errno = 0;
+        out = std::strtod(s.c_str(), &end);
+        return errno == 0 && end == s.c_str() + s.size();
+    }
+
+    bool compareBound(cppminidb::CompareOp op, double a, double b)
     {
-        bool match = true;
-        for (const auto &condition : conditions)
+        switch (op)
         {
-            auto it = row.find(condition.column);
-            if (it == row.end())
-            {
-                match = false;
-                break;
-            }
+        case cppminidb::CompareOp::Greater:
+            return a > b;
+        case cppminidb::CompareOp::GreaterEqual:
+            return a >= b;
+        case cppminidb::CompareOp::Less:
+            return a < b;
+        case cppminidb::CompareOp::LessEqual:
+            return a <= b;
+        default:
+            return false;
+        }
+    }
+}
 
-            ColumnType colType;
+cppminidb::QueryPlanPtr MiniDB::prepare(const std::vector<Condition> &conditions) const
+{
+    std::string shape;
+    for (const auto &condition : conditions)
+    {
+        if (!shape.empty())
+            shape += " AND ";
+        shape += condition.column + " " + cppminidb::toString(cppminidb::parseCompareOp(condition.op)) + " ?";
+    }
 
-            try
-            {
-                colType = columnTypeOf(condition.column);
-            }
-            catch (const std::exception &e)
-            {
-                std::cerr << e.what() << '\n';
-                match = false;
-                break;
-            }
+    if (auto cached = planCache_.find(shape))
+    {
+        if (cached->schemaVersion() == schemaVersion_)
+            return cached;
+    }
 
-            if (condition.op == ">" || condition.op == "<" || condition.op == ">=" || condition.op == "<=")
-            {
-                if (columnTypeOf(condition.column) != ColumnType::Int &&
-                    columnTypeOf(condition.column) != ColumnType::Float)
-                {
-                    throw std::invalid_argument(
-                        "Operator '" + condition.op + "' not valid for non-numeric column '" + condition.column + "'");
-                }
-            }
+    std::vector<cppminidb::PlanPredicate> predicates;
+    predicates.reserve(conditions.size());
+    for (const auto &condition : conditions)
+    {
+        auto it = std::find(columns_.begin(), columns_.end(), condition.column);
+        if (it == columns_.end())
+            throw std::invalid_argument("Column not found: " + condition.column);
+
+        cppminidb::PlanPredicate predicate;
+        predicate.column = condition.column;
+        predicate.columnIndex = static_cast<std::size_t>(std::distance(columns_.begin(), it));
+        predicate.op = cppminidb::parseCompareOp(condition.op);
+
+        const ColumnType type = columnTypes_.at(predicate.columnIndex);
+        const bool ordering = predicate.op != cppminidb::CompareOp::Equal &&
+                              predicate.op != cppminidb::CompareOp::NotEqual;
+        if (ordering && type != ColumnType::Int && type != ColumnType::Float)
+        {
+            throw std::invalid_argument(
+                "Operator '" + condition.op + "' not valid for non-numeric column '" + condition.column + "'");
+        }
+        predicate.numeric = ordering;
+        predicates.push_back(std::move(predicate));
+    }
 
-            const std::string &cell = it->second;
-            if (condition.op == "==")
-            {
-                if (cell != condition.value)
-                {
-                    match = false;
-                    break;
-                }
-            }
-            else if (condition.op == "!=")
-            {
-                if (cell == condition.value)
-                {
-                    match = false;
-                    break;
-                }
-            }
-            else if (condition.op == ">")
+    auto plan = std::make_shared<const cppminidb::QueryPlan>(std::move(shape), std::move(predicates), schemaVersion_);
+    planCache_.insert(plan);
+    return plan;
+}
+
+std::vector<std::map<std::string, std::string>> MiniDB::execute(const cppminidb::QueryPlan &plan,
+                                                                const std::vector<std::string> &params,
+                                                                bool fromDisk) const
+{
+    if (plan.schemaVersion() != schemaVersion_)
+        throw std::logic_error("Query plan is stale: table schema changed since it was prepared.");
+
+    const auto &predicates = plan.predicates();
+    if (params.size() != predicates.size())
+    {
+        throw std::invalid_argument("Query plan expects " + std::to_string(predicates.size()) +
+                                    " parameters, got " + std::to_string(params.size()));
+    }
+
+    // Bind: numeric parameters are parsed once per execution, not once per row.
+    std::vector<double> bound(predicates.size(), 0.0);
+    for (std::size_t i = 0; i < predicates.size(); ++i)
+    {
+        if (predicates[i].numeric && !parseDouble(params[i], bound[i]))
+        {
+            throw std::invalid_argument("Value '" + params[i] + "' for column '" + predicates[i].column +
+                                        "' is not numeric");
+        }
+    }
+
+    // columnAt[i] is the cell index of predicate i in the rows being scanned.
+    auto matches = [&](const std::vector<std::string> &row, const std::vector<std::size_t> &columnAt)
+    {
+        for (std::size_t i = 0; i < predicates.size(); ++i)
+        {
+            if (columnAt[i] >= row.size())
+                return false;
+            const std::string &cell = row[columnAt[i]];
+            switch (predicates[i].op)
             {
-                if (!(std::stod(cell) > std::stod(condition.value)))
-                {
-                    match = false;
-                    break;
-                }
-            }
-            else if (condition.op == "<")
+            case cppminidb::CompareOp::Equal:
+                if (cell != params[i])
+                    return false;
+                break;
+            case cppminidb::CompareOp::NotEqual:
+                if (cell == params[i])
+                    return false;
+                break;
+            default:
             {
-                if (!(std::stod(cell) < std::stod(condition.value)))
-                {
-                    match = false;
-                    break;
-                }
+                double value = 0.0;
+                if (!parseDouble(cell, value) || !compareBound(predicates[i].op, value, bound[i]))
+                    return false;
             }
-            else if (condition.op == ">=")
-            {
-                if (!(std::stod(cell) >= std::stod(condition.value)))
-                {
-                    match = false;
-                    break;
-                }
             }
-            else if (condition.op == "<=")
+        }
+        return true;
+    };
+
+    std::vector<std::map<std::string, std::string>> result;
+
+    if (!fromDisk)
+    {
+        std::vector<std::size_t> columnAt;
+        for (const auto &predicate : predicates)
+            columnAt.push_back(predicate.columnIndex);
+
+        std::lock_guard<std::mutex> lock(mtx_);
+        for (const auto &row : rows_)
+        {
+            if (row.size() != columns_.size() || !matches(row, columnAt))
+                continue;
+
+            std::map<std::string, std::string> rowMap;
+            for (size_t i = 0; i < columns_.size(); ++i)
             {
-                if (!(std::stod(cell) <= std::stod(condition.value)))
-                {
-                    match = false;
-                    break;
-                }
+                rowMap[columns_[i]] = row[i];
             }
+            result.push_back(std::move(rowMap));
         }
+        return result;
+    }
 
-        if (match)
+    cppminidb::PagedFileReader inFile(pageCache(), getTableFilePath());
+    if (!inFile.isOpen())
+        return result;
+
+    std::string line;
+    inFile.getline(line);
+    std::vector<std::string> fileColumns;
+    std::stringstream headerStream(line);
+    std::string header;
+    while (std::getline(headerStream, header, ','))
+    {
+        fileColumns.push_back(header);
+    }
+
+    // The file may predate the current schema, so resolve predicate columns by name.
+    std::vector<std::size_t> columnAt;
+    for (const auto &predicate : predicates)
+    {
+        auto it = std::find(fileColumns.begin(), fileColumns.end(), predicate.column);
+        if (it == fileColumns.end())
+            return result;
+        columnAt.push_back(static_cast<std::size_t>(std::distance(fileColumns.begin(), it)));
+    }
+
+    std::vector<std::string> values;
+    while (inFile.getline(line))
+    {
+        values.clear();
+        std::stringstream rowStream(line);
+        std::string value;
+        while (std::getline(rowStream, value, ','))
         {
-            result.push_back(row);
+            values.push_back(value);
         }
+        while (values.size() < fileColumns.size())
+        {
+            values.push_back("");
+        }
+
+        if (!matches(values, columnAt))
+            continue;
+
+        std::map<std::string, std::string> rowMap;
+        for (size_t i = 0; i < fileColumns.size(); ++i)
+        {
+            rowMap[fileColumns[i]] = values[i];
+        }
+        result.push_back(std::move(rowMap));
     }
     return result;
 }
 
+cppminidb::QueryPlanCache::Stats MiniDB::planCacheStats() const
+{
+    return planCache_.stats();
+}
+
+void MiniDB::schemaChanged()
+{
+    ++schemaVersion_;
+    planCache_.clear();
+    scalarLogSchema_ = columns_ == logColumns(1);
+}
+
 bool NumberValidator::isPureInteger(const std::string &str)
 {
     if (str.empty())
@@ -0,0 +1,257 @@
+#include "../include/cppminidb/PageCache.hpp"
+#include "../include/cppminidb/StorageManager.hpp"
+
+#include <fstream>
+#include <iterator>
+
+namespace cppminidb
+{
+    PageCache::PageCache(std::size_t capacityBytes, std::size_t pageSize, StorageManager *budget)
+        : pageSize_(pageSize == 0 ? kDefaultPageSize : pageSize), budget_(budget), capacity_(capacityBytes) {}
+
+    PageCache::~PageCache()
+    {
+        clear();
+    }
+
+    std::optional<std::size_t> PageCache::fileSize(const std::string &path)
+    {
+        std::error_code ec;
+        const auto size = std::filesystem::file_size(path, ec);
+        std::filesystem::file_time_type mtime{};
+        if (!ec)
+            mtime = std::filesystem::last_write_time(path, ec);
+
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (ec)
+        {
+            dropFileLocked(path);
+            files_.erase(path);
+            return std::nullopt;
+        }
+
+        auto it = files_.find(path);
+        if (it != files_.end() && (it->second.size != size || it->second.mtime != mtime))
+        {
+            dropFileLocked(path);
+            ++stats_.invalidations;
+        }
+        files_[path] = FileState{size, mtime};
+        return static_cast<std::size_t>(size);
+    }
+
+    PageCache::Page PageCache::page(const std::string &path, std::size_t index)
+    {
+        Key key{path, index};
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            auto it = index_.find(key);
+            if (it != index_.end())
+            {
+                lru_.splice(lru_.begin(), lru_, it->second);
+                ++stats_.hits;
+                return it->second->data;
+            }
+            ++stats_.misses;
+        }
+
+        // Disk I/O happens outside the lock so concurrent hits are not blocked.
+        Page loaded = loadPage(path, index);
+
+        std::lock_guard<std::mutex> lock(mtx_);
+        auto it = index_.find(key);
+        if (it != index_.end())
+            return it->second->data; // another thread loaded it meanwhile
+
+        if (loaded->empty() || loaded->size() > capacity_ || !makeRoomLocked(loaded->size()))
+            return loaded;
+
+        lru_.push_front(Entry{key, loaded});
+        index_.emplace(std::move(key), lru_.begin());
+        stats_.residentBytes += loaded->size();
+        return loaded;
+    }
+
+    void PageCache::invalidate(const std::string &path)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        dropFileLocked(path);
+        files_.erase(path);
+        ++stats_.invalidations;
+    }
+
+    void PageCache::clear()
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        while (!lru_.empty())
+            evictLocked(std::prev(lru_.end()), false);
+        files_.clear();
+    }
+
+    std::size_t PageCache::shrink(std::size_t bytes)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        std::size_t freed = 0;
+        while (freed < bytes && !lru_.empty())
+        {
+            auto victim = std::prev(lru_.end());
+            freed += victim->data->size();
+            evictLocked(victim);
+        }
+        return freed;
+    }
+
+    void PageCache::setCapacity(std::size_t capacityBytes)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        capacity_ = capacityBytes;
+        while (stats_.residentBytes > capacity_ && !lru_.empty())
+            evictLocked(std::prev(lru_.end()));
+    }
+
+    std::size_t PageCache::capacity() const
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        return capacity_;
+    }
+
+    std::size_t PageCache::pageSize() const noexcept
+    {
+        return pageSize_;
+    }
+
+    PageCache::Stats PageCache::stats() const
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        Stats copy = stats_;
+        copy.residentPages = lru_.size();
+        return copy;
+    }
+
+    void PageCache::resetStats()
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        stats_.hits = 0;
+        stats_.misses = 0;
+        stats_.evictions = 0;
+        stats_.invalidations = 0;
+    }
+
+    PageCache &PageCache::shared()
+    {
+        static PageCache cache;
+        return cache;
+    }
+
+    void PageCache::evictLocked(std::list<Entry>::iterator it, bool countEviction)
+    {
+        const std::size_t bytes = it->data->size();
+        stats_.residentBytes -= bytes;
+        if (budget_)
+            budget_->release(bytes);
+        if (countEviction)
+            ++stats_.evictions;
+        index_.erase(it->key);
+        lru_.erase(it);
+    }
+
+    void PageCache::dropFileLocked(const std::string &path)
+    {
+        for (auto it = lru_.begin(); it != lru_.end();)
+        {
+            auto next = std::next(it);
+            if (it->key.path == path)
+                evictLocked(it, false);
+            it = next;
+        }
+    }
+
+    bool PageCache::makeRoomLocked(std::size_t bytes)
+    {
+        while (stats_.residentBytes + bytes > capacity_ && !lru_.empty())
+            evictLocked(std::prev(lru_.end()));
+
+        if (budget_)
+        {
+            while (!budget_->tryReserve(bytes))
+            {
+                if (lru_.empty())
+                    return false;
+                evictLocked(std::prev(lru_.end()));
+            }
+        }
+        return stats_.residentBytes + bytes <= capacity_;
+    }
+
+    PageCache::Page PageCache::loadPage(const std::string &path, std::size_t index) const
+    {
+        auto data = std::make_shared<std::string>();
+        std::ifstream inFile(path, std::ios::binary);
+        if (!inFile.is_open())
+            return data;
+
+        inFile.seekg(static_cast<std::streamoff>(index * pageSize_));
+        if (!inFile)
+            return data;
+
+        data->resize(pageSize_);
+        inFile.read(data->data(), static_cast<std::streamsize>(pageSize_));
+        data->resize(static_cast<std::size_t>(inFile.gcount()));
+        data->shrink_to_fit();
+        return data;
+    }
+
+    PagedFileReader::PagedFileReader(PageCache &cache, const std::string &path)
+        : cache_(cache), path_(path)
+    {
+        auto size = cache_.fileSize(path_);
+        open_ = size.has_value();
+        fileSize_ = size.value_or(0);
+    }
+
+    bool PagedFileReader::isOpen() const noexcept
+    {
+        return open_;
+    }
+
+    bool PagedFileReader::getline(std::string &line)
+    {
+        line.clear();
+        if (!open_)
+            return false;
+
+        bool partial = false;
+        while (true)
+        {
+            if (!page_ || offset_ >= page_->size())
+            {
+                if (!nextPage())
+                    return partial; // last line without a trailing newline
+            }
+
+            const std::string &data = *page_;
+            const std::size_t newline = data.find('\n', offset_);
+            if (newline == std::string::npos)
+            {
+                line.append(data, offset_, std::string::npos);
+                offset_ = data.size();
+                partial = true;
+                continue;
+            }
+
+            line.append(data, offset_, newline - offset_);
+            offset_ = newline + 1;
+            return true;
+        }
+    }
+
+    bool PagedFileReader::nextPage()
+    {
+        if (pageIndex_ * cache_.pageSize() >= fileSize_)
+            return false;
+
+        page_ = cache_.page(path_, pageIndex_++);
+        offset_ = 0;
+        return !page_->empty();
+    }
+} // namespace cppminidb
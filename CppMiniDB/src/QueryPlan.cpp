@@ -0,0 +1,109 @@
+#include "../include/cppminidb/QueryPlan.hpp"
+
+#include <stdexcept>
+
+namespace cppminidb
+{
+    CompareOp parseCompareOp(const std::string &op)
+    {
+        if (op == "==" || op == "=")
+            return CompareOp::Equal;
+        if (op == "!=")
+            return CompareOp::NotEqual;
+        if (op == ">")
+            return CompareOp::Greater;
+        if (op == ">=")
+            return CompareOp::GreaterEqual;
+        if (op == "<")
+            return CompareOp::Less;
+        if (op == "<=")
+            return CompareOp::LessEqual;
+
+        throw std::invalid_argument("Unsupported operator: " + op);
+    }
+
+    const char *toString(CompareOp op) noexcept
+    {
+        switch (op)
+        {
+        case CompareOp::Equal:
+            return "==";
+        case CompareOp::NotEqual:
+            return "!=";
+        case CompareOp::Greater:
+            return ">";
+        case CompareOp::GreaterEqual:
+            return ">=";
+        case CompareOp::Less:
+            return "<";
+        case CompareOp::LessEqual:
+            return "<=";
+        }
+        return "?";
+    }
+
+    QueryPlanPtr QueryPlanCache::find(const std::string &shape)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        auto it = index_.find(shape);
+        if (it == index_.end())
+        {
+            ++stats_.misses;
+            return nullptr;
+        }
+        ++stats_.hits;
+        lru_.splice(lru_.begin(), lru_, it->second);
+        return *it->second;
+    }
+
+    void QueryPlanCache::insert(QueryPlanPtr plan)
+    {
+        if (!plan)
+            return;
+
+        std::lock_guard<std::mutex> lock(mtx_);
+        auto it = index_.find(plan->shape());
+        if (it != index_.end())
+        {
+            *it->second = std::move(plan);
+            lru_.splice(lru_.begin(), lru_, it->second);
+            return;
+        }
+
+        lru_.push_front(std::move(plan));
+        index_.emplace(lru_.front()->shape(), lru_.begin());
+        evictLocked();
+    }
+
+    void QueryPlanCache::clear()
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        lru_.clear();
+        index_.clear();
+    }
+
+    void QueryPlanCache::setCapacity(std::size_t capacity)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        capacity_ = capacity;
+        evictLocked();
+    }
+
+    QueryPlanCache::Stats QueryPlanCache::stats() const
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        Stats s = stats_;
+        s.size = lru_.size();
+        return s;
+    }
+
+    void QueryPlanCache::evictLocked()
+    {
+        while (lru_.size() > capacity_)
+        {
+            index_.erase(lru_.back()->shape());
+            lru_.pop_back();
+            ++stats_.evictions;
+        }
+    }
+} // namespace cppminidb
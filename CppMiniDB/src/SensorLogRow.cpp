@@ -4,10 +4,14 @@ namespace cppminidb
 {
     nlohmann::json SensorLogRow::toJSON() const
     {
-        return {
+        nlohmann::json j = {
             {"timestamp", timestamp_ms},
             {"sensorId", sensor_id},
             {"value", value},
-            {"faultType", fault_flags}};
+            {"faultType", fault_flags},
+            {"timestampUs", timestamp_us != 0 ? timestamp_us : timestamp_ms * 1000}};
+        if (!channels.empty())
+            j["values"] = channels;
+        return j;
     }
 } // namespace cppminidb
@@ -0,0 +1,66 @@
+#include "../include/cppminidb/StorageManager.hpp"
+
+namespace cppminidb
+{
+    StorageManager::StorageManager(std::size_t budgetBytes, std::size_t pageCacheBytes)
+        : budget_(budgetBytes), pageCache_(pageCacheBytes, PageCache::kDefaultPageSize, this) {}
+
+    bool StorageManager::tryReserve(std::size_t bytes) noexcept
+    {
+        std::size_t current = used_.load(std::memory_order_relaxed);
+        while (true)
+        {
+            const std::size_t limit = budget_.load(std::memory_order_relaxed);
+            if (bytes > limit || current > limit - bytes)
+                return false;
+
+            if (used_.compare_exchange_weak(current, current + bytes, std::memory_order_acq_rel))
+                return true;
+        }
+    }
+
+    void StorageManager::forceReserve(std::size_t bytes) noexcept
+    {
+        used_.fetch_add(bytes, std::memory_order_acq_rel);
+    }
+
+    void StorageManager::release(std::size_t bytes) noexcept
+    {
+        std::size_t current = used_.load(std::memory_order_relaxed);
+        while (!used_.compare_exchange_weak(current, current > bytes ? current - bytes : 0, std::memory_order_acq_rel))
+        {
+        }
+    }
+
+    std::size_t StorageManager::used() const noexcept
+    {
+        return used_.load(std::memory_order_acquire);
+    }
+
+    std::size_t StorageManager::budget() const noexcept
+    {
+        return budget_.load(std::memory_order_acquire);
+    }
+
+    std::size_t StorageManager::available() const noexcept
+    {
+        const std::size_t limit = budget();
+        const std::size_t inUse = used();
+        return inUse >= limit ? 0 : limit - inUse;
+    }
+
+    void StorageManager::setBudget(std::size_t budgetBytes) noexcept
+    {
+        budget_.store(budgetBytes, std::memory_order_release);
+    }
+
+    PageCache &StorageManager::pageCache() noexcept
+    {
+        return pageCache_;
+    }
+
+    const PageCache &StorageManager::pageCache() const noexcept
+    {
+        return pageCache_;
+    }
+} // namespace cppminidb
@@ -1,8 +1,15 @@
 #define CATCH_CONFIG_MAIN
 #include <catch2/catch_all.hpp>
 #include "cppminidb/MiniDB.hpp"
+#include "cppminidb/Database.hpp"
+#include "cppminidb/ColumnarFile.hpp"
+#include "cppminidb/Logger.hpp"
 #include <iostream>
 #include <fstream>
+#include <filesystem>
+#include <sstream>
+#include <iterator>
+#include <thread>
 #include <nlohmann/json.hpp>
 
 TEST_CASE("MiniDB basic insert and export", "[MiniDB]")
@@ -498,4 +505,522 @@ TEST_CASE("MiniDB typed: string column rejects ordering ops in memory", "[typed]
 
     db.insertRow({"Alice"});
     REQUIRE_THROWS_AS(db.selectWhereFromMemory("name", ">", "K"), std::invalid_argument);
-}
\ No newline at end of file
+}
+TEST_CASE("Database stores tables under its configured data directory", "[database][catalog]")
+{
+    const std::string dataDir = "./data/catalog_test";
+    std::filesystem::remove_all(dataDir);
+
+    cppminidb::Database db(dataDir);
+    MiniDB &raw = db.createTable("raw_logs", {"timestamp_ms", "value"},
+                                 {MiniDB::ColumnType::Int, MiniDB::ColumnType::Float});
+    MiniDB &faults = db.openTable("fault_events");
+    faults.setColumns({"sensor_id", "fault"});
+
+    raw.insertRow({"1000", "24.5"});
+    faults.insertRow({"TEMP-001", "spike"});
+    db.saveAll();
+
+    REQUIRE(std::filesystem::exists(dataDir + "/raw_logs.tbl"));
+    REQUIRE(std::filesystem::exists(dataDir + "/fault_events.tbl"));
+    REQUIRE(db.tableNames() == std::vector<std::string>{"fault_events", "raw_logs"});
+    REQUIRE(&db.openTable("raw_logs") == &raw);
+    REQUIRE_THROWS_AS(db.createTable("raw_logs", {"a"}, {MiniDB::ColumnType::String}), std::invalid_argument);
+
+    REQUIRE(db.dropTable("fault_events", true));
+    REQUIRE_FALSE(db.hasTable("fault_events"));
+    REQUIRE_FALSE(std::filesystem::exists(dataDir + "/fault_events.tbl"));
+
+    std::filesystem::remove_all(dataDir);
+}
+
+TEST_CASE("Database enforces one memory budget across all tables", "[database][memory]")
+{
+    cppminidb::Database db("./data/catalog_budget", 2048);
+    MiniDB &a = db.openTable("a");
+    MiniDB &b = db.openTable("b");
+    a.setColumns({"payload"});
+    b.setColumns({"payload"});
+
+    const std::string payload(200, 'x');
+    for (int i = 0; i < 4; ++i)
+        a.insertRow({payload});
+
+    REQUIRE(db.memoryUsage() == a.memoryUsage());
+    REQUIRE(db.memoryUsage() <= db.storage().budget());
+
+    // Table b shares the budget already consumed by table a
+    REQUIRE_THROWS_AS([&]()
+                      { for (int i = 0; i < 16; ++i) b.insertRow({payload}); }(),
+                      std::runtime_error);
+    REQUIRE(db.memoryUsage() <= db.storage().budget());
+
+    const std::size_t beforeClear = db.memoryUsage();
+    a.clearMemory();
+    REQUIRE(a.memoryUsage() == 0);
+    REQUIRE(db.memoryUsage() < beforeClear);
+    REQUIRE_NOTHROW(b.insertRow({payload}));
+
+    db.dropTable("b");
+    REQUIRE(db.memoryUsage() == 0);
+}
+
+TEST_CASE("MiniDB memory accounting follows deletes and log appends", "[database][memory]")
+{
+    cppminidb::StorageManager storage;
+    MiniDB db("accounting_table", "./data", &storage);
+    db.setColumns({"timestamp_ms", "sensor_id", "value", "fault_flags"});
+
+    db.appendLog("TEMP-001", 1000, 24.0, {});
+    db.appendLog("TEMP-002", 2000, 25.0, {"spike"});
+    REQUIRE(storage.used() == db.memoryUsage());
+    REQUIRE(storage.used() > 0);
+
+    const std::size_t withTwo = storage.used();
+    db.deleteWhereFromMemory("timestamp_ms", "==", "1000");
+    REQUIRE(db.rowCount() == 1);
+    REQUIRE(storage.used() < withTwo);
+    REQUIRE(storage.used() == db.memoryUsage());
+}
+
+TEST_CASE("Repeated disk queries are served from the page cache", "[pagecache][disk]")
+{
+    const std::string dataDir = "./data/pagecache_test";
+    std::filesystem::remove_all(dataDir);
+
+    cppminidb::Database db(dataDir);
+    MiniDB &logs = db.createTable("logs", {"timestamp_ms", "sensor_id", "value"},
+                                  {MiniDB::ColumnType::Int, MiniDB::ColumnType::String, MiniDB::ColumnType::Float});
+    for (int i = 0; i < 50; ++i)
+        logs.insertRow({std::to_string(i * 1000), "TEMP-001", "24.5"});
+    logs.save();
+
+    auto first = logs.selectWhereFromDisk("timestamp_ms", ">", "10000");
+    const auto afterFirst = db.pageCacheStats();
+    REQUIRE(afterFirst.misses > 0);
+
+    auto second = logs.selectWhereMulti({{"timestamp_ms", ">", "10000"}}, true);
+    auto json = logs.exportToJsonFromDisk();
+    const auto afterRepeat = db.pageCacheStats();
+
+    REQUIRE(first.size() == 39);
+    REQUIRE(second.size() == first.size());
+    REQUIRE(afterRepeat.misses == afterFirst.misses);
+    REQUIRE(afterRepeat.hits >= 2);
+    REQUIRE(afterRepeat.residentBytes > 0);
+    REQUIRE(db.memoryUsage() >= afterRepeat.residentBytes);
+
+    // Writes through MiniDB invalidate cached pages
+    logs.deleteWhereFromDisk("timestamp_ms", ">", "10000");
+    REQUIRE(logs.selectWhereFromDisk("timestamp_ms", ">", "10000").empty());
+    REQUIRE(logs.loadFromDisk().size() == 11);
+
+    // Dropping the table evicts its pages even when the file stays on disk
+    REQUIRE(db.pageCacheStats().residentBytes > 0);
+    REQUIRE(db.dropTable("logs"));
+    REQUIRE(db.pageCacheStats().residentBytes == 0);
+    REQUIRE(db.memoryUsage() == 0);
+
+    std::filesystem::remove_all(dataDir);
+}
+
+TEST_CASE("PageCache evicts least recently used pages and reads lines across page boundaries", "[pagecache][lru]")
+{
+    std::filesystem::create_directories("./data");
+    const std::string path = "./data/pagecache_lru.txt";
+    {
+        std::ofstream out(path, std::ios::trunc);
+        for (int i = 0; i < 100; ++i)
+            out << "line-" << i << "\n";
+        out << "tail-without-newline";
+    }
+
+    cppminidb::PageCache cache(256, 64);
+    cppminidb::PagedFileReader reader(cache, path);
+    REQUIRE(reader.isOpen());
+
+    std::vector<std::string> lines;
+    std::string line;
+    while (reader.getline(line))
+        lines.push_back(line);
+
+    REQUIRE(lines.size() == 101);
+    REQUIRE(lines[0] == "line-0");
+    REQUIRE(lines[57] == "line-57");
+    REQUIRE(lines.back() == "tail-without-newline");
+
+    auto stats = cache.stats();
+    REQUIRE(stats.residentBytes <= 256);
+    REQUIRE(stats.evictions > 0);
+
+    // The most recently used page is still resident, the first one was evicted
+    const auto misses = stats.misses;
+    const std::size_t lastPage = (std::filesystem::file_size(path) - 1) / 64;
+    cache.page(path, lastPage);
+    REQUIRE(cache.stats().misses == misses);
+    cache.page(path, 0);
+    REQUIRE(cache.stats().misses == misses + 1);
+
+    cppminidb::PagedFileReader missing(cache, "./data/does_not_exist.txt");
+    REQUIRE_FALSE(missing.isOpen());
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Columnar export round-trips rows and compresses log columns", "[columnar][export]")
+{
+    std::filesystem::create_directories("./data");
+    const std::string path = "./data/columnar_roundtrip.mdbc";
+
+    MiniDB db("columnar_roundtrip");
+    db.setColumns({"timestamp_ms", "sensor_id", "value", "fault_flags"},
+                  {MiniDB::ColumnType::Int, MiniDB::ColumnType::String, MiniDB::ColumnType::Float, MiniDB::ColumnType::String});
+    for (int i = 0; i < 1000; ++i)
+    {
+        db.appendLog(i % 2 ? "TEMP-001" : "PRES-001", 1000 + i * 100, 20.0 + (i % 50) * 0.25,
+                     i % 100 == 0 ? std::vector<std::string>{"SPIKE"} : std::vector<std::string>{});
+    }
+    db.insertRow({"bad", "TEMP-002", "-0.000000", ""}); // not delta-encodable, must survive verbatim
+
+    REQUIRE(db.exportToColumnar(path, false, 256) == 1001);
+
+    cppminidb::ColumnarReader reader(path);
+    REQUIRE(reader.columns() == std::vector<std::string>{"timestamp_ms", "sensor_id", "value", "fault_flags"});
+    REQUIRE(reader.rowCount() == 1001);
+    REQUIRE(reader.chunks().size() == 4);
+    REQUIRE(reader.chunks()[0].columns[0].encoding == cppminidb::ColumnEncoding::DeltaDecimal);
+    REQUIRE(reader.chunks()[0].columns[1].encoding == cppminidb::ColumnEncoding::Dictionary);
+    REQUIRE(reader.chunks()[0].columns[2].encoding == cppminidb::ColumnEncoding::DeltaDecimal);
+
+    auto rows = reader.readAll();
+    auto expected = db.selectAll();
+    REQUIRE(rows.size() == expected.size());
+    for (std::size_t i = 0; i < rows.size(); ++i)
+    {
+        REQUIRE(rows[i][0] == expected[i]["timestamp_ms"]);
+        REQUIRE(rows[i][1] == expected[i]["sensor_id"]);
+        REQUIRE(rows[i][2] == expected[i]["value"]);
+        REQUIRE(rows[i][3] == expected[i]["fault_flags"]);
+    }
+
+    // Much smaller than the JSON export of the same rows
+    REQUIRE(std::filesystem::file_size(path) * 5 < db.exportToJson().size());
+
+    // Disk export reads the .tbl file and produces the same rows
+    db.save();
+    const std::string diskPath = "./data/columnar_roundtrip_disk.mdbc";
+    REQUIRE(db.exportToColumnar(diskPath, true) == 1001);
+    REQUIRE(cppminidb::ColumnarReader(diskPath).readAll() == rows);
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(diskPath);
+    std::filesystem::remove("./data/columnar_roundtrip.tbl");
+}
+
+TEST_CASE("Columnar reader skips chunks using min/max statistics", "[columnar][select]")
+{
+    std::filesystem::create_directories("./data");
+    const std::string path = "./data/columnar_select.mdbc";
+
+    MiniDB db("columnar_select");
+    db.setColumns({"timestamp_ms", "sensor_id", "value"},
+                  {MiniDB::ColumnType::Int, MiniDB::ColumnType::String, MiniDB::ColumnType::Float});
+    for (int i = 0; i < 1000; ++i)
+        db.insertRow({std::to_string(i * 10), i < 500 ? "TEMP-001" : "PRES-001", std::to_string(i * 0.5)});
+    db.exportToColumnar(path, false, 100);
+
+    cppminidb::ColumnarReader reader(path);
+    cppminidb::ColumnarReader::ScanStats scan;
+
+    auto late = reader.select({{"timestamp_ms", ">=", "9500"}}, &scan);
+    REQUIRE(late.size() == 50);
+    REQUIRE(late.front()["timestamp_ms"] == "9500");
+    REQUIRE(scan.chunksTotal == 10);
+    REQUIRE(scan.chunksSkipped == 9);
+    REQUIRE(scan.rowsScanned == 100);
+
+    auto pres = reader.select({{"sensor_id", "=", "PRES-001"}, {"value", "<", "300"}}, &scan);
+    REQUIRE(pres.size() == 100);
+    REQUIRE(scan.chunksSkipped == 9);
+
+    REQUIRE(reader.select({{"sensor_id", "==", "HUM-001"}}, &scan).empty());
+    REQUIRE(scan.chunksSkipped == 10);
+
+    REQUIRE_THROWS_AS(reader.select({{"sensor_id", ">", "A"}}), std::invalid_argument);
+    REQUIRE_THROWS_AS(reader.select({{"missing", "==", "1"}}), std::invalid_argument);
+    REQUIRE_THROWS_AS(cppminidb::ColumnarReader("./data/columnar_missing.mdbc"), std::runtime_error);
+
+    // An out-of-range column type in the header is rejected, not cast
+    std::string bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), {});
+    }
+    const std::size_t typeAt = bytes.find("sensor_id") + std::string("sensor_id").size();
+    REQUIRE(bytes[typeAt] == static_cast<char>(MiniDB::ColumnType::String));
+    bytes[typeAt] = 7;
+    const std::string corrupt = "./data/columnar_bad_type.mdbc";
+    std::ofstream(corrupt, std::ios::binary) << bytes;
+    REQUIRE_THROWS_AS(cppminidb::ColumnarReader(corrupt), std::runtime_error);
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(corrupt);
+}
+
+TEST_CASE("Columnar select matches MiniDB on the same conditions", "[columnar][select]")
+{
+    std::filesystem::create_directories("./data");
+    const std::string path = "./data/columnar_semantics.mdbc";
+
+    MiniDB db("columnar_semantics");
+    db.setColumns({"timestamp_ms", "sensor_id", "value"},
+                  {MiniDB::ColumnType::Int, MiniDB::ColumnType::String, MiniDB::ColumnType::Float});
+    // Numerically equal cells with different text, and cells that do not parse
+    const std::vector<std::string> values = {"1", "1.0", "1.00", "2.5", "bad", "", "-0", "0", "nan", "3"};
+    for (int i = 0; i < 200; ++i)
+        db.insertRow({i % 37 == 0 ? "n/a" : std::to_string(i * 10), i % 3 ? "TEMP-001" : "PRES-001",
+                      values[i % values.size()]});
+    db.exportToColumnar(path, false, 16);
+    cppminidb::ColumnarReader reader(path);
+
+    const std::vector<std::vector<Condition>> queries = {
+        {{"value", "==", "1"}},
+        {{"value", "==", "1.0"}},
+        {{"value", "!=", "1"}},
+        {{"value", "==", "bad"}},
+        {{"value", "!=", "bad"}},
+        {{"value", "==", "0"}},
+        {{"value", "<=", "0"}},
+        {{"value", ">", "1"}},
+        {{"value", ">=", "1.0"}, {"sensor_id", "==", "PRES-001"}},
+        {{"timestamp_ms", "==", "n/a"}},
+        {{"timestamp_ms", "==", "1000"}},
+        {{"timestamp_ms", "==", "1000.0"}},
+        {{"timestamp_ms", "<", "500"}, {"value", "!=", "3"}},
+        {{"sensor_id", "!=", "TEMP-001"}, {"timestamp_ms", ">", "1500"}},
+    };
+    for (const auto &conditions : queries)
+        REQUIRE(reader.select(conditions) == db.selectWhereMulti(conditions, false));
+
+    // Unparseable values for ordering operators are rejected by both
+    REQUIRE_THROWS_AS(db.selectWhereMulti({{"value", ">", "abc"}}, false), std::invalid_argument);
+    REQUIRE_THROWS_AS(reader.select({{"value", ">", "abc"}}), std::invalid_argument);
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Prepared query plans are cached by shape and reused with new parameters", "[query][plan]")
+{
+    MiniDB db("plan_cache_test");
+    db.setColumns({"timestamp_ms", "sensor_id", "value"},
+                  {MiniDB::ColumnType::Int, MiniDB::ColumnType::String, MiniDB::ColumnType::Float});
+    for (int i = 0; i < 20; ++i)
+        db.insertRow({std::to_string(i * 1000), i % 2 ? "TEMP-001" : "PRES-001", std::to_string(20 + i)});
+
+    auto plan = db.prepare({{"timestamp_ms", ">=", ""}, {"sensor_id", "==", ""}});
+    REQUIRE(plan->shape() == "timestamp_ms >= ? AND sensor_id == ?");
+    REQUIRE(plan->parameterCount() == 2);
+
+    REQUIRE(db.execute(*plan, {"10000", "TEMP-001"}).size() == 5);
+    REQUIRE(db.execute(*plan, {"0", "PRES-001"}).size() == 10);
+
+    // Same shape with different values hits the cache; "=" is normalized to "=="
+    auto again = db.prepare({{"timestamp_ms", ">=", "5000"}, {"sensor_id", "=", "PRES-001"}});
+    REQUIRE(again == plan);
+    auto stats = db.planCacheStats();
+    REQUIRE(stats.hits == 1);
+    REQUIRE(stats.misses == 1);
+    REQUIRE(stats.size == 1);
+
+    // selectWhereMulti goes through the same cache
+    auto rows = db.selectWhereMulti({{"timestamp_ms", ">=", "15000"}, {"sensor_id", "==", "TEMP-001"}}, false);
+    REQUIRE(rows.size() == 3);
+    REQUIRE(rows.front().at("timestamp_ms") == "15000");
+    REQUIRE(db.planCacheStats().hits == 2);
+
+    // Disk execution matches memory execution
+    db.save();
+    REQUIRE(db.execute(*plan, {"10000", "TEMP-001"}, true) == db.execute(*plan, {"10000", "TEMP-001"}));
+    std::filesystem::remove("./data/plan_cache_test.tbl");
+}
+
+TEST_CASE("Query plans validate once and go stale when the schema changes", "[query][plan]")
+{
+    MiniDB db("plan_validation_test");
+    db.setColumns({"id", "name"}, {MiniDB::ColumnType::Int, MiniDB::ColumnType::String});
+    db.insertRow({"1", "alpha"});
+    db.insertRow({"2", "beta"});
+
+    REQUIRE_THROWS_AS(db.prepare({{"missing", "==", ""}}), std::invalid_argument);
+    REQUIRE_THROWS_AS(db.prepare({{"name", ">", ""}}), std::invalid_argument);
+    REQUIRE_THROWS_AS(db.prepare({{"id", "~", ""}}), std::invalid_argument);
+
+    auto plan = db.prepare({{"id", ">", ""}});
+    REQUIRE_THROWS_AS(db.execute(*plan, {}), std::invalid_argument);
+    REQUIRE_THROWS_AS(db.execute(*plan, {"abc"}), std::invalid_argument);
+    REQUIRE(db.execute(*plan, {"1"}).size() == 1);
+
+    db.setColumns({"id", "name", "extra"});
+    REQUIRE(db.planCacheStats().size == 0);
+    REQUIRE_THROWS_AS(db.execute(*plan, {"1"}), std::logic_error);
+
+    // LRU keeps only the most recent shapes
+    cppminidb::QueryPlanCache cache(2);
+    for (const char *shape : {"a", "b", "c"})
+        cache.insert(std::make_shared<const cppminidb::QueryPlan>(shape, std::vector<cppminidb::PlanPredicate>{}, 0));
+    REQUIRE(cache.find("a") == nullptr);
+    REQUIRE(cache.find("c") != nullptr);
+    REQUIRE(cache.stats().evictions == 1);
+}
+
+TEST_CASE("Multi-channel log rows use one value column per channel", "[log][channels]")
+{
+    const std::string dataDir = "./data/channels_test";
+    std::filesystem::remove_all(dataDir);
+
+    MiniDB db("imu_log", dataDir);
+    db.setColumns(MiniDB::logColumns(3), MiniDB::logColumnTypes(3));
+    REQUIRE(db.hasColumn("value_2"));
+    REQUIRE(db.columnTypeOf("value_1") == MiniDB::ColumnType::Float);
+
+    const double axes[] = {0.25, -0.5, 9.75};
+    db.appendLog("IMU-001", 1000, std::span<const double>(axes), {});
+    db.appendLog("TEMP-001", 1000, 24.0, {"spike"}); // scalar rows leave value_1/value_2 empty
+    REQUIRE(db.rowCount() == 2);
+    REQUIRE(db.getLogs()[0].channels == std::vector<double>{0.25, -0.5, 9.75});
+    REQUIRE(db.getLogs()[1].channels.empty());
+
+    const double tooWide[] = {1.0, 2.0, 3.0, 4.0};
+    REQUIRE_THROWS_AS(db.appendLog("IMU-002", 2000, std::span<const double>(tooWide), {}), std::invalid_argument);
+    REQUIRE(db.rowCount() == 2);
+
+    db.save();
+    db.loadLogsIntoMemory();
+    REQUIRE(db.getLogs().size() == 2);
+    REQUIRE(db.getLogs()[0].value == 0.25);
+    REQUIRE(db.getLogs()[0].channels == std::vector<double>{0.25, -0.5, 9.75});
+    REQUIRE(db.getLogs()[1].channels.empty());
+    const auto upright = db.selectWhereFromMemory("value_2", ">", "5.0");
+    REQUIRE(upright.size() == 1);
+    REQUIRE(upright[0].at("sensor_id") == "IMU-001");
+    std::filesystem::remove_all(dataDir);
+}
+
+TEST_CASE("Widening a log table keeps its rows and adds empty value columns", "[log][channels]")
+{
+    MiniDB db("widen_log");
+    db.setColumns(MiniDB::logColumns(), MiniDB::logColumnTypes());
+    db.appendLog("TEMP-001", 1000, 24.0, {});
+
+    db.widenLogColumns(1); // already wide enough
+    REQUIRE_FALSE(db.hasColumn("value_1"));
+
+    db.widenLogColumns(3);
+    REQUIRE(db.hasColumn("value_2"));
+    REQUIRE(db.columnTypeOf("value_2") == MiniDB::ColumnType::Float);
+    const double axes[] = {0.25, -0.5, 9.75};
+    db.appendLog("IMU-001", 2000, std::span<const double>(axes), {});
+    db.appendLog("TEMP-001", 3000, 25.0, {});
+
+    const auto rows = db.selectAll();
+    REQUIRE(rows.size() == 3);
+    REQUIRE(rows[0].at("value") == std::to_string(24.0));
+    REQUIRE(rows[0].at("value_1").empty());
+    REQUIRE(rows[0].at("fault_flags") == "-");
+    REQUIRE(rows[1].at("value_2") == std::to_string(9.75));
+    REQUIRE(db.selectWhereFromMemory("value_2", ">", "5.0").size() == 1);
+
+    MiniDB other("not_a_log");
+    other.setColumns({"name", "age"});
+    REQUIRE_THROWS_AS(other.widenLogColumns(3), std::logic_error);
+}
+
+TEST_CASE("Scalar log rows are placed by name outside the one-channel log schema", "[log][channels]")
+{
+    MiniDB db("reordered_log");
+    db.setColumns({"sensor_id", "timestamp_ms", "fault_flags", "value"});
+    db.appendLog("TEMP-001", 1000, 24.5, {"spike"});
+
+    const auto rows = db.selectWhereFromMemory("sensor_id", "==", "TEMP-001");
+    REQUIRE(rows.size() == 1);
+    REQUIRE(rows[0].at("timestamp_ms") == "1000");
+    REQUIRE(rows[0].at("fault_flags") == "spike");
+    REQUIRE(std::stod(rows[0].at("value")) == 24.5);
+}
+
+TEST_CASE("Logger filters by level and writes JSON records", "[logger]")
+{
+    auto &logger = cppminidb::Logger::instance();
+    std::ostringstream out, err;
+    auto *coutBuf = std::cout.rdbuf(out.rdbuf());
+    auto *cerrBuf = std::cerr.rdbuf(err.rdbuf());
+
+    logger.setLevel(cppminidb::LogLevel::Info);
+    REQUIRE_FALSE(logger.enabled(cppminidb::LogLevel::Debug));
+    cppminidb::logDebug("Test") << "hidden";
+    cppminidb::logInfo("Test") << "shown " << 42;
+    cppminidb::logWarn("Test") << "careful\n";
+
+    logger.setFormat(cppminidb::Logger::Format::Json);
+    cppminidb::logInfo("Scheduler") << "Sensor \"A\" scheduled";
+
+    logger.setFormat(cppminidb::Logger::Format::Text);
+    logger.setLevel(cppminidb::LogLevel::Debug);
+    std::cout.rdbuf(coutBuf);
+    std::cerr.rdbuf(cerrBuf);
+
+    std::istringstream lines(out.str());
+    std::string line;
+    REQUIRE(std::getline(lines, line));
+    REQUIRE(line == "[Test] shown 42");
+    REQUIRE(std::getline(lines, line));
+    const auto record = nlohmann::json::parse(line);
+    REQUIRE(record["level"] == "info");
+    REQUIRE(record["component"] == "Scheduler");
+    REQUIRE(record["msg"] == "Sensor \"A\" scheduled");
+    REQUIRE(record["ts_us"].get<uint64_t>() > 0);
+    REQUIRE_FALSE(std::getline(lines, line));
+    REQUIRE(err.str() == "[Test] careful\n"); // Warn and above go to stderr
+
+    cppminidb::LogLevel level;
+    REQUIRE(cppminidb::parseLogLevel("warn", level));
+    REQUIRE(level == cppminidb::LogLevel::Warn);
+    REQUIRE_FALSE(cppminidb::parseLogLevel("verbose", level));
+}
+
+TEST_CASE("Async logger writes every record or counts it as dropped", "[logger][async]")
+{
+    auto &logger = cppminidb::Logger::instance();
+    std::ostringstream out;
+    auto *coutBuf = std::cout.rdbuf(out.rdbuf());
+
+    const uint64_t droppedBefore = logger.dropped();
+    logger.startAsync(16);
+    REQUIRE(logger.async());
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 2000;
+    std::vector<std::thread> producers;
+    for (int t = 0; t < kThreads; ++t)
+    {
+        producers.emplace_back([t]
+                               {
+                                   for (int i = 0; i < kPerThread; ++i)
+                                       cppminidb::logInfo("Test") << "t" << t << " #" << i;
+                               });
+    }
+    for (auto &producer : producers)
+        producer.join();
+    logger.flush();
+    logger.stopAsync();
+    REQUIRE_FALSE(logger.async());
+    std::cout.rdbuf(coutBuf);
+
+    std::size_t written = 0;
+    std::istringstream lines(out.str());
+    for (std::string line; std::getline(lines, line);)
+    {
+        REQUIRE(line.rfind("[Test] t", 0) == 0);
+        ++written;
+    }
+    REQUIRE(written + (logger.dropped() - droppedBefore) == kThreads * kPerThread);
+    REQUIRE(written > 0);
+}
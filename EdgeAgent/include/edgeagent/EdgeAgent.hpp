@@ -1,11 +1,14 @@
 #pragma once
 
+#include <mutex>
 #include <vector>
 #include <cppminidb/SensorLogRow.hpp>
 #include <edgeagent/TelemetryPublisher.hpp>
 
 namespace edgeagent
 {
+    // receive() may be called from several threads at once (e.g. one sample-bus
+    // subscriber per AgentChannel); the flushes take the buffered rows under the same lock.
     class EdgeAgent
     {
     public:
@@ -16,7 +19,11 @@ namespace edgeagent
         void flushToFile(const std::string &filename);
 
     private:
+        // Moves the buffered rows out, leaving the buffer empty
+        std::vector<cppminidb::SensorLogRow> takeBuffer();
+
         TelemetryPublisher publisher_;
+        std::mutex mutex_; // guards buffer_
         std::vector<cppminidb::SensorLogRow> buffer_;
     };
 } // namespace edgeagent
\ No newline at end of file
@@ -1,41 +1,53 @@
 #include <edgeagent/EdgeAgent.hpp>
-#include <iostream>
+#include <cppminidb/Logger.hpp>
 
 namespace edgeagent
 {
     void EdgeAgent::receive(const cppminidb::SensorLogRow &row)
     {
+        std::lock_guard<std::mutex> lock(mutex_);
         buffer_.push_back(row);
     }
 
+    std::vector<cppminidb::SensorLogRow> EdgeAgent::takeBuffer()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<cppminidb::SensorLogRow> rows;
+        rows.swap(buffer_);
+        return rows;
+    }
+
     void EdgeAgent::flushToConsole()
     {
-        if (buffer_.empty())
+        const auto rows = takeBuffer();
+        if (rows.empty())
         {
-            std::cout << "[EdgeAgent] No data to flush to console.\n";
+            cppminidb::logInfo("EdgeAgent") << "No data to flush to console.";
             return;
         }
 
-        publisher_.publishToConsole(buffer_);
-        buffer_.clear();
+        publisher_.publishToConsole(rows);
     }
 
     void EdgeAgent::flushToFile(const std::string &filename)
     {
-        if (buffer_.empty())
+        auto rows = takeBuffer();
+        if (rows.empty())
         {
-            std::cerr << "[EdgeAgent] No data to flush to file: " << filename << "\n";
+            cppminidb::logWarn("EdgeAgent") << "No data to flush to file: " << filename;
             return;
         }
 
         try
         {
-            publisher_.publishToFile(buffer_, filename);
-            buffer_.clear();
+            publisher_.publishToFile(rows, filename);
         }
         catch (const std::exception &ex)
         {
-            std::cerr << "[EdgeAgent] Failed to flush to file: " << ex.what() << "\n";
+            cppminidb::logError("EdgeAgent") << "Failed to flush to file: " << ex.what();
+            // Keep the rows for the next flush, ahead of any received meanwhile
+            std::lock_guard<std::mutex> lock(mutex_);
+            buffer_.insert(buffer_.begin(), std::make_move_iterator(rows.begin()), std::make_move_iterator(rows.end()));
         }
     }
-} // namespace edgeagent
\ No newline at end of file
+} // namespace edgeagent
@@ -14,6 +14,8 @@ namespace edgeagent
             json_row["sensor_id"] = row.sensor_id;
             json_row["value"] = row.value;
             json_row["fault_flags"] = row.fault_flags;
+            if (!row.channels.empty())
+                json_row["values"] = row.channels;
 
             json_array.push_back(json_row);
         }
@@ -7,6 +7,9 @@
 #include <fstream>
 #include <system_error>
 #include <chrono>
+#include <atomic>
+#include <thread>
+#include <vector>
 
 namespace
 {
@@ -101,3 +104,42 @@ TEST_CASE("flushToFile preserves buffered data when write fails", "[edgeagent]")
 
     removeIfExists(recoveryPath);
 }
+
+TEST_CASE("receive and flushToFile can run on different threads", "[edgeagent][threads]")
+{
+    edgeagent::EdgeAgent agent;
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 500;
+    std::atomic<int> running{kThreads};
+    std::vector<std::thread> producers;
+    for (int t = 0; t < kThreads; ++t)
+    {
+        producers.emplace_back([&agent, &running, t]
+                               {
+                                   for (uint64_t i = 0; i < kPerThread; ++i)
+                                       agent.receive({i, "sensor-" + std::to_string(t), static_cast<double>(i), {}});
+                                   --running; });
+    }
+
+    std::size_t flushed = 0;
+    auto flushOnce = [&]
+    {
+        auto path = makeTempFilePath();
+        agent.flushToFile(path.string());
+        if (std::filesystem::exists(path))
+        {
+            std::ifstream file(path);
+            nlohmann::json data;
+            file >> data;
+            flushed += data.size();
+            removeIfExists(path);
+        }
+    };
+    while (running > 0)
+        flushOnce();
+    for (auto &producer : producers)
+        producer.join();
+    flushOnce();
+
+    REQUIRE(flushed == kThreads * kPerThread);
+}
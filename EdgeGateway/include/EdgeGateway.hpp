@@ -1,6 +1,8 @@
 #pragma once
 #include <IGatewayChannel.hpp>
 #include <scheduler/SensorScheduler.hpp>
+#include <scheduler/SimulationClock.hpp>
+#include <scheduler/SampleBus.hpp>
 #include <edgeagent/EdgeAgent.hpp>
 #include <atomic>
 #include <memory>
@@ -21,12 +23,21 @@ namespace gateway
         void stopLoop();
         sensor::SensorScheduler &getScheduler();
         const sensor::SensorScheduler &getScheduler() const;
+        void setClock(const sensor::SimulationClock &clock);
+        // Publishes to every channel through a SampleBus (one consumer thread per channel)
+        void enableSampleBus(std::size_t capacity, sensor::Backpressure policy);
+        const sensor::SampleBus *getSampleBus() const;
 
     private:
         std::vector<std::unique_ptr<channel::IGatewayChannel>> channels_;
         sensor::SensorScheduler scheduler_;
         std::unordered_map<std::string, std::unique_ptr<sensor::ISensor>> sensors_;
+        // Fleet sensors and pooled groups from deployFleet
+        std::vector<std::unique_ptr<sensor::ISensor>> fleetSensors_;
+        std::vector<std::unique_ptr<sensor::ISensorPool>> fleetPools_;
         edgeagent::EdgeAgent agent_;
         std::atomic<bool> running_{false};
+        sensor::SimulationClock clock_ = sensor::SimulationClock::realTime();
+        std::unique_ptr<sensor::SampleBus> bus_; // declared last: its threads stop before channels_ go
     };
 } // namespace gateway
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <vector>
+#include <sensors/AnomalyDetector.hpp>
 
 namespace channel
 {
@@ -21,8 +23,48 @@ namespace channel
 
         const std::vector<ChannelConfig> &getChannels() const;
 
+        // "scheduler": { "threads": N } — sampling worker threads, 0 = inline
+        std::size_t getSchedulerThreads() const;
+
+        // "scheduler": { "speed": "realtime" | "100x" | "afap" } — run loop pacing
+        const std::string &getSchedulerSpeed() const;
+
+        // "replay": "<capture file>" — replay recorded sensors instead of simulating them
+        const std::string &getReplayPath() const;
+
+        // "fleet": "<fleet config>" — bulk-instantiate sensors from a fleet spec file
+        const std::string &getFleetPath() const;
+
+        // "bus": { "capacity": N, "policy": "block" | "drop-oldest" | "drop-newest" } — queue
+        // samples to each channel on its own thread; capacity 0 (default) publishes inline
+        std::size_t getBusCapacity() const;
+        const std::string &getBusPolicy() const;
+
+        // "log": { "level": "info", "format": "text" | "json", "async": true } — process
+        // logger settings; an empty level leaves the logger as it is
+        const std::string &getLogLevel() const;
+        const std::string &getLogFormat() const;
+        bool getLogAsync() const;
+
+        // "anomaly": { "enabled": true, "window": 32, "z": 4.0, "flatline": 20, "epsilon": 0.0,
+        // "rate": 0.0 } — run the scheduler's anomaly detection stage; omitted keys keep the
+        // sensor::AnomalyConfig defaults
+        bool getAnomalyEnabled() const;
+        const sensor::AnomalyConfig &getAnomalyConfig() const;
+
     private:
         std::vector<ChannelConfig> channels_;
+        std::size_t schedulerThreads_ = 0;
+        std::string schedulerSpeed_ = "realtime";
+        std::string replayPath_;
+        std::string fleetPath_;
+        std::size_t busCapacity_ = 0;
+        std::string busPolicy_ = "drop-oldest";
+        std::string logLevel_;
+        std::string logFormat_ = "text";
+        bool logAsync_ = false;
+        bool anomalyEnabled_ = false;
+        sensor::AnomalyConfig anomalyConfig_;
     };
 
 } // namespace channel
\ No newline at end of file
@@ -1,5 +1,5 @@
 #include <AgentChannel.hpp>
-#include <iostream>
+#include <cppminidb/Logger.hpp>
 
 namespace channel
 {
@@ -7,7 +7,7 @@ namespace channel
         {
                 if (!agent_)
                 {
-                        std::cerr << "[AgentChannel] Warning: initialized with null EdgeAgent pointer.\n";
+                        cppminidb::logWarn("AgentChannel") << "Warning: initialized with null EdgeAgent pointer.";
                 }
         }
 
@@ -15,7 +15,7 @@ namespace channel
         {
                 if (!agent_)
                 {
-                        std::cerr << "[AgentChannel] No valid EdgeAgent instance. Skipping publish.\n";
+                        cppminidb::logWarn("AgentChannel") << "No valid EdgeAgent instance. Skipping publish.";
                         return;
                 }
                 agent_->receive(row);
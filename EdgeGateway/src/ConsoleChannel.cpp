@@ -1,11 +1,14 @@
 #include <ConsoleChannel.hpp>
-#include <iostream>
+#include <cppminidb/Logger.hpp>
 
 namespace channel
 {
     void ConsoleChannel::publish(const cppminidb::SensorLogRow &row) const
     {
-        std::cout << "[ConsoleChannel] Publishing row:\n";
-        std::cout << row.toJSON().dump(4) << "\n";
+        // One compact line per row, and no JSON work at all when Info is filtered out
+        if (cppminidb::Logger::instance().enabled(cppminidb::LogLevel::Info))
+        {
+            cppminidb::logInfo("ConsoleChannel") << row.toJSON().dump();
+        }
     }
 } // namespace channel
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include <iostream>
+#include <cppminidb/Logger.hpp>
 #include <ConsoleChannel.hpp>
 #include <FileChannel.hpp>
 #include <cppminidb/SensorLogRow.hpp>
@@ -7,17 +8,27 @@
 #include <GatewayConfig.hpp>
 #include <sensors/Spec.hpp>
 #include <sensors/SimpleSensor.hpp>
+#include <scheduler/SimulationRunner.hpp>
+#include <scheduler/ReplayCapture.hpp>
+#include <scheduler/FleetSpec.hpp>
 #include <thread>
 #include <AgentChannel.hpp>
 #include <filesystem>
+#include <sstream>
 
 namespace
 {
     std::atomic<bool> keepRunning{false};
+
+    constexpr std::string_view kComponent = "EdgeGateway";
 }
 
 namespace gateway
 {
+    using cppminidb::logError;
+    using cppminidb::logInfo;
+    using cppminidb::logWarn;
+
     void EdgeGateway::start(const std::string &configPath)
     {
         channel::GatewayConfig config(std::vector<channel::ChannelConfig>{});
@@ -30,15 +41,34 @@ namespace gateway
 
         if (!config.loadFromFile(pathToUse.string()))
         {
-            std::cerr << "[EdgeGateway] Failed to load gateway configuration from: " << pathToUse.string() << "\n";
+            logError(kComponent) << "Failed to load gateway configuration from: " << pathToUse.string();
             return;
         }
 
+        auto &logger = cppminidb::Logger::instance();
+        if (!config.getLogLevel().empty())
+        {
+            cppminidb::LogLevel level = cppminidb::LogLevel::Info;
+            if (!cppminidb::parseLogLevel(config.getLogLevel(), level))
+            {
+                logWarn(kComponent) << "Invalid log level '" << config.getLogLevel() << "', using info";
+            }
+            logger.setLevel(level);
+        }
+        logger.setFormat(config.getLogFormat() == "json" ? cppminidb::Logger::Format::Json : cppminidb::Logger::Format::Text);
+        if (config.getLogAsync())
+        {
+            logger.startAsync();
+        }
+
         const auto &channels = config.getChannels();
-        std::cout << "Loaded Channels:\n";
-        for (const auto &ch : channels)
         {
-            std::cout << "- Type: " << ch.type << ", Path: " << ch.path << "\n";
+            auto line = logInfo(kComponent);
+            line << "Loaded Channels:";
+            for (const auto &ch : channels)
+            {
+                line << "\n- Type: " << ch.type << ", Path: " << ch.path;
+            }
         }
 
         for (const auto &cfg : channels)
@@ -51,30 +81,89 @@ namespace gateway
             {
                 if (cfg.path.empty())
                 {
-                    std::cerr << "[EdgeGateway] File channel requires a 'path' in the configuration.\n";
+                    logError(kComponent) << "File channel requires a 'path' in the configuration.";
                     continue;
                 }
                 channels_.push_back(std::make_unique<channel::FileChannel>(cfg.path));
             }
             else if (cfg.type == "agent")
             {
-                std::cout << "[EdgeGateway] Adding AgentChannel...\n";
+                logInfo(kComponent) << "Adding AgentChannel...";
                 channels_.push_back(std::make_unique<channel::AgentChannel>(&agent_));
             }
             else
             {
-                std::cerr << "[EdgeGateway] Unknown channel type: " << cfg.type << "\n";
+                logError(kComponent) << "Unknown channel type: " << cfg.type;
             }
         }
 
         if (channels_.empty())
         {
-            std::cerr << "[EdgeGateway] No active channels configured.\n";
+            logError(kComponent) << "No active channels configured.";
             return;
         }
 
+        if (config.getSchedulerThreads() > 1)
+        {
+            logInfo(kComponent) << "Sampling on " << config.getSchedulerThreads() << " scheduler threads";
+        }
+        scheduler_.setWorkerThreads(config.getSchedulerThreads());
+        if (config.getAnomalyEnabled())
+        {
+            scheduler_.enableAnomalyDetection(config.getAnomalyConfig());
+            logInfo(kComponent) << "Anomaly detection enabled";
+        }
+
+        if (auto clock = sensor::SimulationClock::parse(config.getSchedulerSpeed()))
+        {
+            clock_ = *clock;
+        }
+        else
+        {
+            logWarn(kComponent) << "Invalid scheduler speed '" << config.getSchedulerSpeed() << "', using real-time";
+            clock_ = sensor::SimulationClock::realTime();
+        }
+
+        if (!config.getReplayPath().empty())
+        {
+            try
+            {
+                for (const auto &stream : sensor::readCapture(config.getReplayPath()))
+                {
+                    if (sensors_.count(stream.id) || scheduler_.getScheduledSensorAs<sensor::ISensor>(stream.id))
+                    {
+                        continue;
+                    }
+                    auto replay = sensor::makeReplaySensor(stream);
+                    scheduler_.addScheduledSensor(stream.id, replay.get(), sensor::nominalPeriodMs(stream.samples));
+                    sensors_.emplace(stream.id, std::move(replay));
+                }
+                logInfo(kComponent) << "Replaying capture: " << config.getReplayPath();
+            }
+            catch (const std::exception &e)
+            {
+                logError(kComponent) << "Failed to load replay capture: " << e.what();
+            }
+        }
+
+        if (!config.getFleetPath().empty())
+        {
+            try
+            {
+                const auto fleet = sensor::loadFleetSpec(config.getFleetPath());
+                // Ids already scheduled (e.g. by a replay) are skipped by the scheduler
+                const std::size_t added = sensor::deployFleet(fleet, scheduler_, fleetSensors_, fleetPools_);
+                logInfo(kComponent) << "Fleet loaded: " << config.getFleetPath() << " (" << added << " sensors, "
+                                    << fleetPools_.size() << " pools)";
+            }
+            catch (const std::exception &e)
+            {
+                logError(kComponent) << "Failed to load fleet: " << e.what();
+            }
+        }
+
         const std::string defaultSensorId = "TEMP-001";
-        if (!scheduler_.getScheduledSensor(defaultSensorId))
+        if (!scheduler_.getScheduledSensorAs<sensor::ISensor>(defaultSensorId))
         {
             auto spec = sensor::makeDefaultTempSpec();
             spec.id = defaultSensorId;
@@ -93,21 +182,34 @@ namespace gateway
             }
 
             scheduler_.addScheduledSensor(defaultSensorId, sensorPtr, 1000);
-            std::cout << "[EdgeGateway] Scheduled default sensor: " << defaultSensorId << "\n";
+            logInfo(kComponent) << "Scheduled default sensor: " << defaultSensorId;
         }
 
         running_.store(false);
-        scheduler_.onSample = [this](const cppminidb::SensorLogRow &row)
+        if (config.getBusCapacity() > 0)
         {
-            if (!running_.load())
+            sensor::Backpressure policy = sensor::Backpressure::DropOldest;
+            if (!sensor::parseBackpressure(config.getBusPolicy(), policy))
             {
-                return;
+                logWarn(kComponent) << "Invalid bus policy '" << config.getBusPolicy() << "', using drop-oldest";
             }
-            for (const auto &channel : channels_)
+            enableSampleBus(config.getBusCapacity(), policy);
+            logInfo(kComponent) << "Sample bus: capacity " << config.getBusCapacity() << " per channel";
+        }
+        else
+        {
+            scheduler_.onSample = [this](const cppminidb::SensorLogRow &row)
             {
-                channel->publish(row);
-            }
-        };
+                if (!running_.load())
+                {
+                    return;
+                }
+                for (const auto &channel : channels_)
+                {
+                    channel->publish(row);
+                }
+            };
+        }
         // auto spec = sensor::makeDefaultTempSpec();
         // spec.id = "TEMP-001";
         // if (scheduler_.getScheduledSensor(spec.id))
@@ -152,7 +254,9 @@ namespace gateway
 
     void EdgeGateway::injectTestSample(const cppminidb::SensorLogRow &row)
     {
-        if (scheduler_.onSample)
+        if (bus_)
+            bus_->publish(row);
+        else if (scheduler_.onSample)
             scheduler_.onSample(row);
     }
 
@@ -160,29 +264,109 @@ namespace gateway
     {
         if (keepRunning.exchange(true))
         {
-            std::cerr << "[EdgeGateway] runLoop already active. Ignoring duplicate start request.\n";
+            logWarn(kComponent) << "runLoop already active. Ignoring duplicate start request.";
             return;
         }
         running_.store(true, std::memory_order_release);
-        std::cout << "[EdgeGateway] Starting run loop. Press Ctrl+C to exit." << std::endl;
+        logInfo(kComponent) << "Starting " << clock_.describe() << " run loop. Press Ctrl+C to exit.";
         const uint64_t tick_interval_ms = 1000;
+        sensor::SimulationReport report;
+        const uint64_t samplesBefore = scheduler_.samplesEmitted();
+        const auto start = sensor::SimulationClock::WallClock::now();
         while (keepRunning.load(std::memory_order_acquire))
         {
             scheduler_.tick(tick_interval_ms);
+            report.simulated_ms += tick_interval_ms;
+            ++report.ticks;
 
-            std::this_thread::sleep_for(std::chrono::milliseconds(tick_interval_ms));
+            if (clock_.paced())
+            {
+                const auto deadline = clock_.deadline(start, report.simulated_ms);
+                std::this_thread::sleep_until(deadline);
+                report.jitter.record(sensor::SimulationClock::WallClock::now() - deadline);
+            }
+        }
+        if (bus_)
+        {
+            bus_->flush();
         }
+        report.samples = scheduler_.samplesEmitted() - samplesBefore;
+        report.wall_seconds = std::chrono::duration<double>(sensor::SimulationClock::WallClock::now() - start).count();
         running_.store(false, std::memory_order_release);
         keepRunning.store(false, std::memory_order_release);
-        std::cout << "[EdgeGateway] Run loop stopped.\n";
+        logInfo(kComponent) << "Run loop stopped.";
+        if (cppminidb::Logger::instance().enabled(cppminidb::LogLevel::Info))
+        {
+            std::ostringstream summary;
+            sensor::printReport(summary, report);
+            if (bus_)
+            {
+                for (const auto &stats : bus_->stats())
+                {
+                    summary << "Bus " << stats.name << ": " << stats.delivered << " delivered, "
+                            << stats.dropped << " dropped\n";
+                }
+            }
+            if (scheduler_.anomalyDetection())
+            {
+                sensor::printDetectorCosts(summary, scheduler_.detectorCosts());
+            }
+            cppminidb::Logger::instance().log(cppminidb::LogLevel::Info, kComponent, std::move(summary).str());
+        }
+        // Per-sensor output statistics: two lines per sensor, so Debug only on large fleets
+        if (cppminidb::Logger::instance().enabled(cppminidb::LogLevel::Debug))
+        {
+            std::ostringstream perSensor;
+            for (const auto &id : scheduler_.getSensorIds())
+            {
+                if (const auto *stats = scheduler_.getSensorStats(id))
+                    sensor::printStats(perSensor, id, *stats);
+            }
+            if (perSensor.tellp() > 0)
+                cppminidb::Logger::instance().log(cppminidb::LogLevel::Debug, kComponent, std::move(perSensor).str());
+        }
+        cppminidb::Logger::instance().flush();
     }
 
     void EdgeGateway::stopLoop()
     {
         if (keepRunning.exchange(false))
         {
-            std::cout << "[EdgeGateway] Stop requested. Waiting for loop to exit...\n";
+            logInfo(kComponent) << "Stop requested. Waiting for loop to exit...";
+        }
+    }
+
+    void EdgeGateway::enableSampleBus(std::size_t capacity, sensor::Backpressure policy)
+    {
+        if (bus_)
+        {
+            bus_->stop();
         }
+        bus_ = std::make_unique<sensor::SampleBus>();
+        for (std::size_t i = 0; i < channels_.size(); ++i)
+        {
+            const channel::IGatewayChannel *ch = channels_[i].get();
+            bus_->subscribe("channel-" + std::to_string(i), [this, ch](const cppminidb::SensorLogRow &row)
+                            {
+                                if (running_.load())
+                                {
+                                    ch->publish(row);
+                                } },
+                            capacity, policy);
+        }
+        scheduler_.onSample = nullptr;
+        scheduler_.setSampleBus(bus_.get());
+        bus_->start();
+    }
+
+    const sensor::SampleBus *EdgeGateway::getSampleBus() const
+    {
+        return bus_.get();
+    }
+
+    void EdgeGateway::setClock(const sensor::SimulationClock &clock)
+    {
+        clock_ = clock;
     }
 
     sensor::SensorScheduler &EdgeGateway::getScheduler()
@@ -1,7 +1,7 @@
 #include <FileChannel.hpp>
 #include <fstream>
 #include <nlohmann/json.hpp>
-#include <iostream>
+#include <cppminidb/Logger.hpp>
 #include <filesystem>
 #include <system_error>
 
@@ -19,7 +19,7 @@ namespace channel
             std::filesystem::create_directories(outputPath.parent_path(), ec);
             if (ec)
             {
-                std::cerr << "[FileChannel] Failed to create directories for: " << outputPath << " (" << ec.message() << ")\n";
+                cppminidb::logError("FileChannel") << "Failed to create directories for: " << outputPath << " (" << ec.message() << ")";
                 return;
             }
         }
@@ -27,7 +27,7 @@ namespace channel
         std::ofstream outFile(outputPath, std::ios::app); // append mode
         if (!outFile)
         {
-            std::cerr << "[FileChannel] Failed to open file: " << outputPath << std::endl;
+            cppminidb::logError("FileChannel") << "Failed to open file: " << outputPath;
             return;
         }
 
@@ -1,7 +1,7 @@
 #include <GatewayConfig.hpp>
 #include <fstream>
 #include <nlohmann/json.hpp>
-#include <iostream>
+#include <cppminidb/Logger.hpp>
 #include <filesystem>
 
 namespace channel
@@ -11,7 +11,7 @@ namespace channel
         std::ifstream file(path);
         if (!file)
         {
-            std::cerr << "[GatewayConfig] Failed to open file: " << path << "\n";
+            cppminidb::logError("GatewayConfig") << "Failed to open file: " << path;
             return false;
         };
 
@@ -20,7 +20,7 @@ namespace channel
 
         if (!j.contains("channels") || !j["channels"].is_array())
         {
-            std::cerr << "[GatewayConfig] Invalid config: 'channels' array missing.\n";
+            cppminidb::logError("GatewayConfig") << "Invalid config: 'channels' array missing.";
             return false;
         }
 
@@ -44,6 +44,93 @@ namespace channel
             channels_.push_back(cfg);
         }
 
+        schedulerThreads_ = 0;
+        schedulerSpeed_ = "realtime";
+        if (j.contains("scheduler") && j["scheduler"].is_object())
+        {
+            const auto &scheduler = j["scheduler"];
+            const int threads = scheduler.value("threads", 0);
+            schedulerThreads_ = threads > 0 ? static_cast<std::size_t>(threads) : 0;
+            if (scheduler.contains("speed"))
+            {
+                const auto &speed = scheduler["speed"];
+                if (speed.is_number())
+                    schedulerSpeed_ = std::to_string(speed.get<double>());
+                else if (speed.is_string())
+                    schedulerSpeed_ = speed.get<std::string>();
+                else
+                {
+                    cppminidb::logError("GatewayConfig") << "Invalid scheduler speed: expected a string or a number.";
+                    return false;
+                }
+            }
+        }
+
+        replayPath_.clear();
+        if (j.contains("replay") && j["replay"].is_string())
+        {
+            std::filesystem::path resolved(j["replay"].get<std::string>());
+            if (resolved.is_relative())
+            {
+                resolved = baseDir / resolved;
+            }
+            replayPath_ = resolved.lexically_normal().string();
+        }
+
+        busCapacity_ = 0;
+        busPolicy_ = "drop-oldest";
+        if (j.contains("bus") && j["bus"].is_object())
+        {
+            const auto &bus = j["bus"];
+            const int capacity = bus.value("capacity", 0);
+            busCapacity_ = capacity > 0 ? static_cast<std::size_t>(capacity) : 0;
+            busPolicy_ = bus.value("policy", busPolicy_);
+        }
+
+        fleetPath_.clear();
+        if (j.contains("fleet") && j["fleet"].is_string())
+        {
+            std::filesystem::path resolved(j["fleet"].get<std::string>());
+            if (resolved.is_relative())
+            {
+                resolved = baseDir / resolved;
+            }
+            fleetPath_ = resolved.lexically_normal().string();
+        }
+
+        logLevel_.clear();
+        logFormat_ = "text";
+        logAsync_ = false;
+        if (j.contains("log") && j["log"].is_object())
+        {
+            const auto &log = j["log"];
+            logLevel_ = log.value("level", logLevel_);
+            logFormat_ = log.value("format", logFormat_);
+            logAsync_ = log.value("async", logAsync_);
+        }
+
+        anomalyEnabled_ = false;
+        anomalyConfig_ = {};
+        if (j.contains("anomaly") && j["anomaly"].is_object())
+        {
+            const auto &anomaly = j["anomaly"];
+            anomalyEnabled_ = anomaly.value("enabled", true);
+            // Read as signed so a negative count is rejected rather than wrapped
+            const auto window = anomaly.value("window", static_cast<int64_t>(anomalyConfig_.window));
+            const auto flatline = anomaly.value("flatline", static_cast<int64_t>(anomalyConfig_.flatline_samples));
+            if (window < 2 || window > static_cast<int64_t>(sensor::AnomalyConfig::kMaxWindow) || flatline < 0)
+            {
+                cppminidb::logError("GatewayConfig") << "Invalid anomaly config: window must be 2.."
+                                                     << sensor::AnomalyConfig::kMaxWindow << " and flatline must not be negative.";
+                return false;
+            }
+            anomalyConfig_.window = static_cast<std::size_t>(window);
+            anomalyConfig_.z_threshold = anomaly.value("z", anomalyConfig_.z_threshold);
+            anomalyConfig_.flatline_samples = static_cast<std::size_t>(flatline);
+            anomalyConfig_.flatline_epsilon = anomaly.value("epsilon", anomalyConfig_.flatline_epsilon);
+            anomalyConfig_.max_rate_per_s = anomaly.value("rate", anomalyConfig_.max_rate_per_s);
+        }
+
         return true;
     }
 
@@ -52,4 +139,59 @@ namespace channel
         return channels_;
     }
 
+    std::size_t GatewayConfig::getSchedulerThreads() const
+    {
+        return schedulerThreads_;
+    }
+
+    const std::string &GatewayConfig::getSchedulerSpeed() const
+    {
+        return schedulerSpeed_;
+    }
+
+    const std::string &GatewayConfig::getReplayPath() const
+    {
+        return replayPath_;
+    }
+
+    const std::string &GatewayConfig::getFleetPath() const
+    {
+        return fleetPath_;
+    }
+
+    std::size_t GatewayConfig::getBusCapacity() const
+    {
+        return busCapacity_;
+    }
+
+    const std::string &GatewayConfig::getBusPolicy() const
+    {
+        return busPolicy_;
+    }
+
+    const std::string &GatewayConfig::getLogLevel() const
+    {
+        return logLevel_;
+    }
+
+    const std::string &GatewayConfig::getLogFormat() const
+    {
+        return logFormat_;
+    }
+
+    bool GatewayConfig::getLogAsync() const
+    {
+        return logAsync_;
+    }
+
+    bool GatewayConfig::getAnomalyEnabled() const
+    {
+        return anomalyEnabled_;
+    }
+
+    const sensor::AnomalyConfig &GatewayConfig::getAnomalyConfig() const
+    {
+        return anomalyConfig_;
+    }
+
 } // namespace channel
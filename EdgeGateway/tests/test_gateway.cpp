@@ -1,7 +1,12 @@
 #include <catch2/catch_test_macros.hpp>
 #include <EdgeGateway.hpp>
+#include <GatewayConfig.hpp>
 #include <IGatewayChannel.hpp>
+#include <scheduler/FleetSpec.hpp>
+#include <cppminidb/Logger.hpp>
 #include <cppminidb/SensorLogRow.hpp>
+#include <filesystem>
+#include <fstream>
 #include <memory>
 #include <vector>
 #include <string>
@@ -43,4 +48,67 @@ TEST_CASE("EdgeGateway publishes sample to all channels", "[edgegateway]")
     REQUIRE(d2->received[0].value == 42.0);
     REQUIRE(d1->received[0].fault_flags == std::vector<std::string>{"spike"});
     REQUIRE(d2->received[0].fault_flags == std::vector<std::string>{"spike"});
-}
\ No newline at end of file
+}
+
+TEST_CASE("EdgeGateway delivers samples to channels through the sample bus", "[edgegateway][bus]")
+{
+    EdgeGateway gateway;
+    auto dummy = std::make_unique<DummyChannel>();
+    DummyChannel *d = dummy.get();
+    gateway.setChannelsForTest(std::move(dummy));
+    gateway.setSampleCallbackForTest();
+    gateway.enableSampleBus(8, sensor::Backpressure::Block);
+
+    for (uint64_t i = 0; i < 100; ++i)
+        gateway.injectTestSample(SensorLogRow{i, "sensor-bus", static_cast<double>(i), {}});
+    gateway.getSampleBus()->flush();
+
+    REQUIRE(d->received.size() == 100);
+    REQUIRE(d->received.back().timestamp_ms == 99);
+    REQUIRE(gateway.getSampleBus()->stats().front().dropped == 0);
+}
+
+TEST_CASE("GatewayConfig accepts a string or numeric scheduler speed only", "[edgegateway][config]")
+{
+    const auto path = (std::filesystem::temp_directory_path() / "gateway_speed_config.json").string();
+    const auto load = [&](const std::string &speed)
+    {
+        std::ofstream(path) << R"({"channels": [], "scheduler": {"speed": )" << speed << "}}";
+        channel::GatewayConfig config;
+        const bool ok = config.loadFromFile(path);
+        return std::make_pair(ok, config.getSchedulerSpeed());
+    };
+
+    auto &logger = cppminidb::Logger::instance();
+    const auto level = logger.level();
+    logger.setLevel(cppminidb::LogLevel::Off);
+    REQUIRE(load(R"("100x")") == std::make_pair(true, std::string("100x")));
+    REQUIRE(load("50").first);
+    REQUIRE_FALSE(load("true").first);
+    REQUIRE_FALSE(load("[10]").first);
+    logger.setLevel(level);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("EdgeGateway deploys pooled fleet groups as sensor pools", "[edgegateway][fleet]")
+{
+    const auto dir = std::filesystem::temp_directory_path() / "gateway_fleet_test";
+    std::filesystem::create_directories(dir);
+    std::ofstream(dir / "fleet.json") << R"({"groups": [
+        {"preset": "temp", "id": "POOL-{n:02}", "count": 8, "period_ms": 500, "pool": true},
+        {"preset": "pressure", "id": "PRES-{n:02}", "count": 2}]})";
+    std::ofstream(dir / "gateway.json") << R"({"channels": [{"type": "console"}], "fleet": "fleet.json"})";
+
+    auto &logger = cppminidb::Logger::instance();
+    const auto level = logger.level();
+    logger.setLevel(cppminidb::LogLevel::Off);
+    EdgeGateway gateway;
+    gateway.start((dir / "gateway.json").string());
+    logger.setLevel(level);
+
+    auto &scheduler = gateway.getScheduler();
+    REQUIRE(scheduler.getScheduledSensorAs<sensor::FleetPoolSensor>("POOL-01") != nullptr);
+    REQUIRE(scheduler.getScheduledSensorAs<sensor::FleetPoolSensor>("POOL-08") != nullptr);
+    REQUIRE(scheduler.getScheduledSensorAs<sensor::SimpleSensor>("PRES-02") != nullptr);
+    std::filesystem::remove_all(dir);
+}
@@ -1,9 +1,11 @@
 #include "cli/EdgeShell.hpp"
+#include <cppminidb/Database.hpp>
 
 int main()
 {
     sensor::EdgeShell shell;
-    MiniDB db("sensor_simulator_logs");
+    cppminidb::Database catalog("./data");
+    MiniDB &db = catalog.openTable("sensor_simulator_logs");
     shell.setDatabase(&db);
     shell.run();
     return 0;
@@ -0,0 +1,199 @@
+/**
+ * @file bench_sensors.cpp
+ * @brief Google Benchmark suite for sensor synthesis hot paths.
+ *
+ * Every benchmark reports items_per_second (samples produced per second).
+ *
+ *  - GenerateBatch<Exact|Vectorized> : SimpleSensor::generateBatch with the default
+ *    temperature spec (sine + Gaussian + uniform + drift noise), one 4096-sample batch
+ *  - Waveform fill per shape
+ *  - The Gaussian block kernel on its own
+ *  - SchedulerTick/<0|1> : one simulated second of 2000 sensors at 100 Hz, with anomaly
+ *    detection off (0) or on (1); on also reports the scheduler's per-detector ns/check
+ *  - DetectorStage/<0..2> : one AnomalyDetector stage (zscore, flatline, rate) per value
+ *
+ * The vectorized numbers depend on the build: configure with
+ * -DCMAKE_BUILD_TYPE=Release (-O3) so the SignalKernels.hpp loops are vectorized.
+ * Run a subset with e.g. `./bench_sensors --benchmark_filter=GenerateBatch`.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "scheduler/SensorScheduler.hpp"
+#include "sensors/AnomalyDetector.hpp"
+#include "sensors/SignalKernels.hpp"
+#include "sensors/SimpleSensor.hpp"
+#include "sensors/Spec.hpp"
+#include "sensors/Waveform.hpp"
+
+#include <cppminidb/Logger.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t kBatch = 4096;
+    constexpr int64_t kPeriodMs = 10;
+
+    void setCounters(benchmark::State &state, std::size_t samples)
+    {
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(samples));
+    }
+
+    void generateBatch(benchmark::State &state, sensor::BatchSynthesis mode)
+    {
+        auto spec = sensor::makeDefaultTempSpec();
+        spec.noise.uniform_range = 0.05;
+        spec.noise.drift_ppm = 50.0;
+        sensor::SimpleSensor s(spec);
+        s.reset(42);
+        s.setBatchSynthesis(mode);
+        sensor::SampleBatch batch;
+        batch.resize(kBatch);
+
+        int64_t t = 0;
+        for (auto _ : state)
+        {
+            s.generateBatch(t, kPeriodMs, kBatch, batch.view());
+            benchmark::DoNotOptimize(batch.values.data());
+            t += static_cast<int64_t>(kBatch) * kPeriodMs;
+        }
+        setCounters(state, kBatch);
+    }
+
+    void BM_GenerateBatchExact(benchmark::State &state)
+    {
+        generateBatch(state, sensor::BatchSynthesis::Exact);
+    }
+
+    void BM_GenerateBatchVectorized(benchmark::State &state)
+    {
+        generateBatch(state, sensor::BatchSynthesis::Vectorized);
+    }
+
+    void BM_WaveformFill(benchmark::State &state)
+    {
+        static const char *const kShapes[] = {"sine", "square", "sawtooth", "ramp"};
+        auto spec = sensor::makeDefaultTempSpec();
+        spec.base = kShapes[state.range(0)];
+        spec.ramp_per_s = 0.1;
+        const auto wave = sensor::Waveform::fromSpec(spec);
+        std::vector<double> out(kBatch);
+
+        int64_t t = 0;
+        for (auto _ : state)
+        {
+            wave.fill(t, kPeriodMs, kBatch, out.data());
+            benchmark::DoNotOptimize(out.data());
+            t += static_cast<int64_t>(kBatch) * kPeriodMs;
+        }
+        state.SetLabel(kShapes[state.range(0)]);
+        setCounters(state, kBatch);
+    }
+
+    void BM_GaussianBlock(benchmark::State &state)
+    {
+        std::mt19937_64 rng(42);
+        std::vector<double> out(sensor::kernels::kBlockSize, 0.0);
+        std::vector<double> scratch(sensor::kernels::kBlockSize + 1);
+        for (auto _ : state)
+        {
+            sensor::kernels::addGaussianBlock(rng, 0.1, out.size(), out.data(), scratch.data());
+            benchmark::DoNotOptimize(out.data());
+        }
+        setCounters(state, out.size());
+    }
+
+    // Thresholds that flag nothing on a clean temperature sensor, so every sample runs
+    // all three stages and none adds fault names
+    sensor::AnomalyConfig detectionConfig()
+    {
+        sensor::AnomalyConfig config;
+        config.window = 32;
+        config.z_threshold = 6.0;
+        config.flatline_samples = 20;
+        config.max_rate_per_s = 100.0;
+        return config;
+    }
+
+    void BM_SchedulerTick(benchmark::State &state)
+    {
+        constexpr int kSensors = 2000;
+        cppminidb::Logger::instance().setLevel(cppminidb::LogLevel::Warn);
+        sensor::SensorScheduler scheduler;
+        scheduler.setEchoSamples(false);
+        std::vector<std::unique_ptr<sensor::SimpleSensor>> sensors;
+        for (int i = 0; i < kSensors; ++i)
+        {
+            auto spec = sensor::makeDefaultTempSpec();
+            spec.id = "BENCH-" + std::to_string(i);
+            sensors.push_back(std::make_unique<sensor::SimpleSensor>(spec));
+            sensors.back()->reset(static_cast<uint64_t>(i));
+            scheduler.addScheduledSensor(spec.id, sensors.back().get(), kPeriodMs);
+        }
+        if (state.range(0))
+            scheduler.enableAnomalyDetection(detectionConfig());
+
+        const uint64_t before = scheduler.samplesEmitted();
+        for (auto _ : state)
+            scheduler.tick(1'000);
+        state.SetItemsProcessed(static_cast<int64_t>(scheduler.samplesEmitted() - before));
+
+        if (state.range(0))
+        {
+            const auto &costs = scheduler.detectorCosts();
+            for (std::size_t stage = 0; stage < sensor::AnomalyDetector::kStages; ++stage)
+                state.counters[std::string(sensor::AnomalyDetector::kStageNames[stage]) + "_ns"] =
+                    costs[stage].nsPerCheck();
+        }
+    }
+
+    void BM_DetectorStage(benchmark::State &state)
+    {
+        const auto stage = static_cast<std::size_t>(state.range(0));
+        sensor::AnomalyDetector detector(detectionConfig());
+        std::mt19937_64 rng(42);
+        std::normal_distribution<double> normal(22.0, 0.1);
+        std::vector<double> values(kBatch);
+        for (double &v : values)
+            v = normal(rng);
+
+        int64_t t = 0;
+        for (auto _ : state)
+        {
+            uint8_t flags = 0;
+            for (const double v : values)
+            {
+                t += kPeriodMs;
+                switch (stage)
+                {
+                case sensor::AnomalyDetector::ZScore:
+                    flags |= detector.zscore(v);
+                    break;
+                case sensor::AnomalyDetector::Flatline:
+                    flags |= detector.flatline(v);
+                    break;
+                default:
+                    flags |= detector.rate(t, v);
+                    break;
+                }
+            }
+            benchmark::DoNotOptimize(flags);
+        }
+        state.SetLabel(sensor::AnomalyDetector::kStageNames[stage]);
+        setCounters(state, kBatch);
+    }
+} // namespace
+
+BENCHMARK(BM_GenerateBatchExact);
+BENCHMARK(BM_GenerateBatchVectorized);
+BENCHMARK(BM_WaveformFill)->DenseRange(0, 3);
+BENCHMARK(BM_GaussianBlock);
+BENCHMARK(BM_SchedulerTick)->DenseRange(0, 1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DetectorStage)->DenseRange(0, 2);
+
+BENCHMARK_MAIN();
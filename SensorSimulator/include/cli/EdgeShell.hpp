@@ -4,7 +4,9 @@
 #include <memory>
 #include <string>
 #include "../sensors/SimpleSensor.hpp"
+#include "../sensors/MultiChannelSensor.hpp"
 #include "../scheduler/SensorScheduler.hpp"
+#include "../scheduler/ReplayCapture.hpp"
 #include "commands/CommandRegistry.hpp"
 #include <thread>
 #include <atomic>
@@ -29,7 +31,11 @@ namespace sensor
         void printHelp() const;
         void injectFault(const std::string &faultType, const std::string &sensorId, const std::vector<std::string> &params);
         void resetSensor(const std::string &sensorId);
-        void addScheduledSensor(const std::string &sensorId, uint64_t period_ms);
+        // TEMP/PRES sensors use `sampling` for their random faults (see FaultSampling)
+        void addScheduledSensor(const std::string &sensorId, uint64_t period_ms,
+                                FaultSampling sampling = FaultSampling::PerSample);
+        // Schedules a ReplaySensor per stream at the recording's own period
+        void addReplaySensors(const std::vector<RecordedStream> &streams, double speed);
         void tickTime(uint64_t delta_ms);
         void plotSensorData(const std::string &sensorId) const;
         void setDatabase(MiniDB *db);
@@ -41,6 +47,7 @@ namespace sensor
     private:
         void handleCommand(const std::string &line);
         void addDefaultSensor();
+        void widenLog(const ISensor &sensor);
         sensor::SensorScheduler &activeScheduler()
         {
             return external_scheduler_ ? *external_scheduler_ : scheduler_;
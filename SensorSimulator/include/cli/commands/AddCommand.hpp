@@ -18,7 +18,7 @@ namespace cli
         {
             if (args.empty())
             {
-                std::cout << "add <id> <period_ms>" << std::endl;
+                std::cout << "add <id> [period_ms] [per_sample|timeline]" << std::endl;
                 return;
             }
             std::string sensorId = args[0];
@@ -39,7 +39,14 @@ namespace cli
                 }
             }
 
-            shell_.addScheduledSensor(sensorId, period_ms);
+            sensor::FaultSampling sampling = sensor::FaultSampling::PerSample;
+            if (args.size() > 2 && !sensor::parseFaultSampling(args[2], sampling))
+            {
+                std::cerr << "Invalid fault sampling: " << args[2] << " (per_sample or timeline)\n";
+                return;
+            }
+
+            shell_.addScheduledSensor(sensorId, period_ms, sampling);
         }
 
     private:
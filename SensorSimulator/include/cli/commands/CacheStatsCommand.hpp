@@ -0,0 +1,41 @@
+#pragma once
+
+#include "ICommand.hpp"
+#include "../../CppMiniDB/include/cppminidb/MiniDB.hpp"
+#include <iostream>
+#include <iomanip>
+
+namespace cli
+{
+    class CacheStatsCommand : public ICommand
+    {
+    public:
+        CacheStatsCommand(MiniDB *db) : db_(db) {}
+
+        std::string name() const override
+        {
+            return "cachestats";
+        }
+
+        void execute(const std::vector<std::string> &args) override
+        {
+            if (!db_)
+            {
+                std::cout << "Database is not initialized.\n";
+                return;
+            }
+
+            const auto stats = db_->pageCacheStats();
+            std::cout << "Page cache (disk reads):\n"
+                      << "  hits:          " << stats.hits << "\n"
+                      << "  misses:        " << stats.misses << "\n"
+                      << "  hit ratio:     " << std::fixed << std::setprecision(1) << stats.hitRatio() * 100.0 << " %\n"
+                      << "  evictions:     " << stats.evictions << "\n"
+                      << "  invalidations: " << stats.invalidations << "\n"
+                      << "  resident:      " << stats.residentPages << " pages, " << stats.residentBytes << " bytes\n";
+        }
+
+    private:
+        MiniDB *db_;
+    };
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "ICommand.hpp"
+#include "scheduler/FaultCampaign.hpp"
+#include <iostream>
+
+namespace cli
+{
+    // campaign <file>  |  campaign report
+    // Queues a fault campaign on the scheduled sensors (times relative to now); the
+    // report compares injected faults with the fault onsets found in the log.
+    class CampaignCommand : public ICommand
+    {
+    public:
+        CampaignCommand(sensor::SensorScheduler &scheduler, MiniDB *db) : scheduler_(scheduler), db_(db) {}
+
+        std::string name() const override
+        {
+            return "campaign";
+        }
+
+        void execute(const std::vector<std::string> &args) override
+        {
+            if (args.empty())
+            {
+                std::cout << "Usage: campaign <campaign-file>\n"
+                          << "       campaign report\n";
+                return;
+            }
+
+            if (args[0] == "report")
+            {
+                if (!db_)
+                {
+                    std::cout << "Database not initialized.\n";
+                    return;
+                }
+                sensor::printCampaignSummary(std::cout,
+                                             sensor::summarizeCampaign(scheduler_.injectedFaults(), db_->getLogsSnapshot()));
+                return;
+            }
+
+            try
+            {
+                const auto campaign = sensor::loadFaultCampaign(args[0], scheduler_.getSensorIds(), scheduler_.getNowUs());
+                const std::size_t queued = scheduler_.scheduleFaults(campaign.events);
+                std::cout << "Campaign loaded: " << queued << " faults queued ("
+                          << scheduler_.pendingFaults() << " pending)\n";
+            }
+            catch (const std::exception &e)
+            {
+                std::cout << "Campaign failed: " << e.what() << "\n";
+            }
+        }
+
+    private:
+        sensor::SensorScheduler &scheduler_;
+        MiniDB *db_;
+    };
+}
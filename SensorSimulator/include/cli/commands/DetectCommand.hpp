@@ -0,0 +1,111 @@
+#pragma once
+
+#include "ICommand.hpp"
+#include "scheduler/SensorScheduler.hpp"
+#include "scheduler/SimulationRunner.hpp"
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+namespace cli
+{
+    // detect on [window=N] [z=K] [flatline=N] [epsilon=E] [rate=R]  |  detect off  |  detect
+    // Switches the scheduler's anomaly detection stage; without arguments prints the
+    // per-detector counts and cost.
+    class DetectCommand : public ICommand
+    {
+    public:
+        explicit DetectCommand(sensor::SensorScheduler &scheduler) : scheduler_(scheduler) {}
+
+        std::string name() const override
+        {
+            return "detect";
+        }
+
+        void execute(const std::vector<std::string> &args) override
+        {
+            if (args.empty())
+            {
+                if (!scheduler_.anomalyDetection())
+                {
+                    std::cout << "Anomaly detection is off.\n";
+                    return;
+                }
+                sensor::printDetectorCosts(std::cout, scheduler_.detectorCosts());
+                return;
+            }
+
+            if (args[0] == "off")
+            {
+                scheduler_.disableAnomalyDetection();
+                std::cout << "Anomaly detection disabled.\n";
+                return;
+            }
+            if (args[0] != "on")
+            {
+                printUsage();
+                return;
+            }
+
+            try
+            {
+                const sensor::AnomalyConfig config = parseConfig(args);
+                scheduler_.enableAnomalyDetection(config);
+                std::cout << "Anomaly detection enabled (window " << config.window << ", z " << config.z_threshold
+                          << ", flatline " << config.flatline_samples << ", rate " << config.max_rate_per_s << "/s)\n";
+            }
+            catch (const std::exception &)
+            {
+                printUsage();
+            }
+        }
+
+    private:
+        // Parses the key=value arguments after "on"; throws std::invalid_argument or
+        // std::out_of_range on a malformed or out-of-range value
+        static sensor::AnomalyConfig parseConfig(const std::vector<std::string> &args)
+        {
+            sensor::AnomalyConfig config;
+            for (std::size_t i = 1; i < args.size(); ++i)
+            {
+                const auto eqPos = args[i].find('=');
+                if (eqPos == std::string::npos)
+                    throw std::invalid_argument(args[i]);
+                const std::string key = args[i].substr(0, eqPos);
+                const std::string val = args[i].substr(eqPos + 1);
+                if (key == "window")
+                    config.window = parseCount(val, 2, sensor::AnomalyConfig::kMaxWindow);
+                else if (key == "z")
+                    config.z_threshold = std::stod(val);
+                else if (key == "flatline")
+                    config.flatline_samples = parseCount(val, 0, std::numeric_limits<uint32_t>::max());
+                else if (key == "epsilon")
+                    config.flatline_epsilon = std::stod(val);
+                else if (key == "rate")
+                    config.max_rate_per_s = std::stod(val);
+                else
+                    throw std::invalid_argument(args[i]);
+            }
+            return config;
+        }
+
+        // Signed parse, so "-1" is rejected rather than wrapped to a huge unsigned value
+        static std::size_t parseCount(const std::string &val, long long lo, long long hi)
+        {
+            std::size_t pos = 0;
+            const long long n = std::stoll(val, &pos);
+            if (pos != val.size() || n < lo || n > hi)
+                throw std::out_of_range(val);
+            return static_cast<std::size_t>(n);
+        }
+
+        static void printUsage()
+        {
+            std::cout << "Usage: detect on [window=N] [z=K] [flatline=N] [epsilon=E] [rate=R]\n"
+                      << "       detect off\n"
+                      << "       detect\n";
+        }
+
+        sensor::SensorScheduler &scheduler_;
+    };
+}
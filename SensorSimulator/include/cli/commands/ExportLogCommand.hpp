@@ -26,8 +26,9 @@ namespace cli
                 return;
             }
 
-            std::string filename = "./data/logs.json";
+            std::string filename;
             std::string source = "memory";
+            std::string format = "json";
 
             for (const auto &arg : args)
             {
@@ -39,6 +40,36 @@ namespace cli
                 {
                     source = arg.substr(7);
                 }
+                else if (arg.rfind("format=", 0) == 0)
+                {
+                    format = arg.substr(7);
+                }
+            }
+
+            if (format != "json" && format != "columnar")
+            {
+                std::cout << "Unknown format: " << format << " (expected json or columnar)\n";
+                return;
+            }
+
+            if (filename.empty())
+            {
+                filename = (format == "columnar") ? "./data/logs.mdbc" : "./data/logs.json";
+            }
+
+            if (format == "columnar")
+            {
+                try
+                {
+                    const std::size_t rows = db_->exportToColumnar(filename, source == "disk");
+                    std::cout << "Exported " << rows << " rows to " << filename
+                              << " (source=" << source << ", format=columnar)\n";
+                }
+                catch (const std::exception &e)
+                {
+                    std::cout << "Columnar export failed: " << e.what() << "\n";
+                }
+                return;
             }
 
             std::string jsonOutput;
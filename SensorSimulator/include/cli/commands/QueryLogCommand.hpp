@@ -21,6 +21,7 @@ namespace cli
             }
 
             std::vector<Condition> conditions;
+            std::vector<std::string> params;
             std::string source = "memory";
 
             for (size_t i = 0; i + 2 < args.size(); i += 3)
@@ -33,8 +34,8 @@ namespace cli
                     Condition cond;
                     cond.column = args[i].substr(7);
                     cond.op = args[i + 1].substr(3);
-                    cond.value = args[i + 2].substr(6);
                     conditions.push_back(cond);
+                    params.push_back(args[i + 2].substr(6));
                 }
             }
 
@@ -48,7 +49,10 @@ namespace cli
 
             try
             {
-                auto results = db_->selectWhereMulti(conditions, source == "disk");
+                // Same shapes are issued repeatedly (e.g. by monitoring), so the
+                // validated plan comes from the table's plan cache after the first call.
+                auto plan = db_->prepare(conditions);
+                auto results = db_->execute(*plan, params, source == "disk");
 
                 if (results.empty())
                 {
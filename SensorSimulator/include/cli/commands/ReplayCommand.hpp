@@ -0,0 +1,99 @@
+#pragma once
+
+#include "ICommand.hpp"
+#include "../EdgeShell.hpp"
+#include "scheduler/ReplayCapture.hpp"
+#include <cstdlib>
+#include <iostream>
+
+namespace cli
+{
+    // replay <capture-file|log> [speed]  |  replay save <capture-file>
+    // Adds one ReplaySensor per recorded sensor; combine with `simulate ... afap` to
+    // push a recording through the scheduler at full speed.
+    class ReplayCommand : public ICommand
+    {
+    public:
+        ReplayCommand(sensor::EdgeShell &shell, MiniDB *db) : shell_(shell), db_(db) {}
+
+        std::string name() const override
+        {
+            return "replay";
+        }
+
+        void execute(const std::vector<std::string> &args) override
+        {
+            if (args.empty())
+            {
+                printUsage();
+                return;
+            }
+
+            try
+            {
+                if (args[0] == "save")
+                {
+                    if (args.size() < 2 || !db_)
+                    {
+                        printUsage();
+                        return;
+                    }
+                    const auto streams = sensor::streamsFromLogs(db_->getLogsSnapshot());
+                    sensor::writeCapture(args[1], streams);
+                    std::cout << "Capture written: " << args[1] << " (" << streams.size() << " sensors)\n";
+                    return;
+                }
+
+                double speed = 1.0;
+                if (args.size() > 1)
+                {
+                    char *end = nullptr;
+                    speed = std::strtod(args[1].c_str(), &end);
+                    if (*end == 'x')
+                        ++end;
+                    if (*end != '\0' || !(speed > 0.0))
+                    {
+                        printUsage();
+                        return;
+                    }
+                }
+
+                std::vector<sensor::RecordedStream> streams;
+                if (args[0] == "log")
+                {
+                    if (!db_)
+                    {
+                        std::cout << "Database not initialized.\n";
+                        return;
+                    }
+                    streams = sensor::streamsFromLogs(db_->getLogsSnapshot());
+                }
+                else
+                {
+                    streams = sensor::readCapture(args[0]);
+                }
+
+                if (streams.empty())
+                {
+                    std::cout << "Nothing to replay.\n";
+                    return;
+                }
+                shell_.addReplaySensors(streams, speed);
+            }
+            catch (const std::exception &e)
+            {
+                std::cout << "Replay failed: " << e.what() << "\n";
+            }
+        }
+
+    private:
+        static void printUsage()
+        {
+            std::cout << "Usage: replay <capture-file|log> [speed]\n"
+                      << "       replay save <capture-file>\n";
+        }
+
+        sensor::EdgeShell &shell_;
+        MiniDB *db_;
+    };
+}
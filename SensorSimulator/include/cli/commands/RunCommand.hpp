@@ -3,6 +3,7 @@
 #include "ICommand.hpp"
 #include <unordered_map>
 #include "scheduler/SensorScheduler.hpp"
+#include "scheduler/SimulationRunner.hpp"
 #include <thread>
 
 namespace cli
@@ -24,17 +25,49 @@ namespace cli
                 return;
             }
 
+            auto clock = sensor::SimulationClock::realTime();
+            if (!args.empty())
+            {
+                auto parsed = sensor::SimulationClock::parse(args[0]);
+                if (!parsed)
+                {
+                    std::cout << "Usage: run [realtime|<factor>x|afap]\n";
+                    return;
+                }
+                clock = *parsed;
+            }
+
             is_running_ = true;
-            run_thread_ = std::thread([this]()
+            run_thread_ = std::thread([this, clock]()
                                       {
-                                        const int tick_ms = 1000;
-                                        std::unique_lock<std::mutex> lock(cv_mutex_);
+                                        const uint64_t tick_ms = 1000;
+                                        sensor::SimulationReport report;
+                                        const uint64_t samplesBefore = scheduler_.samplesEmitted();
+                                        const auto start = sensor::SimulationClock::WallClock::now();
                                         while (is_running_)
                                         {
                                             scheduler_.tick(tick_ms);
-                                            cv_.wait_for(lock, std::chrono::seconds(1), [this]() { return !is_running_; });
+                                            report.simulated_ms += tick_ms;
+                                            ++report.ticks;
+                                            if (clock.paced())
+                                            {
+                                                // Absolute deadlines: time spent in tick() does not accumulate as drift
+                                                const auto deadline = clock.deadline(start, report.simulated_ms);
+                                                std::unique_lock<std::mutex> lock(cv_mutex_);
+                                                if (!cv_.wait_until(lock, deadline, [this]() { return !is_running_; }))
+                                                    report.jitter.record(sensor::SimulationClock::WallClock::now() - deadline);
+                                            }
+                                        }
+                                        if (clock.mode() != sensor::SimulationClock::Mode::RealTime)
+                                        {
+                                            report.samples = scheduler_.samplesEmitted() - samplesBefore;
+                                            report.wall_seconds = std::chrono::duration<double>(sensor::SimulationClock::WallClock::now() - start).count();
+                                            sensor::printReport(std::cout, report);
                                         } });
-            std::cout << "Started real-time simulation. Use 'stop' to halt.\n";
+            if (clock.mode() == sensor::SimulationClock::Mode::RealTime)
+                std::cout << "Started real-time simulation. Use 'stop' to halt.\n";
+            else
+                std::cout << "Started " << clock.describe() << " simulation. Use 'stop' to halt.\n";
         }
 
     private:
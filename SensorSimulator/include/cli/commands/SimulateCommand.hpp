@@ -0,0 +1,71 @@
+#pragma once
+
+#include "ICommand.hpp"
+#include "scheduler/SensorScheduler.hpp"
+#include "scheduler/SimulationRunner.hpp"
+#include <cstdlib>
+#include <iostream>
+
+namespace cli
+{
+    // simulate <duration> [realtime|<factor>x|afap] [tick_ms]
+    // Runs a bounded simulation in the foreground and prints a throughput report.
+    class SimulateCommand : public ICommand
+    {
+    public:
+        SimulateCommand(sensor::SensorScheduler &scheduler, std::atomic<bool> &is_running)
+            : scheduler_(scheduler), is_running_(is_running) {}
+
+        std::string name() const override
+        {
+            return "simulate";
+        }
+
+        void execute(const std::vector<std::string> &args) override
+        {
+            if (args.empty())
+            {
+                printUsage();
+                return;
+            }
+            if (is_running_)
+            {
+                std::cout << "Stop the running simulation first.\n";
+                return;
+            }
+
+            const auto duration = sensor::parseDurationMs(args[0]);
+            const auto clock = args.size() > 1 ? sensor::SimulationClock::parse(args[1])
+                                               : std::optional<sensor::SimulationClock>(sensor::SimulationClock::asFastAsPossible());
+            const uint64_t tick_ms = args.size() > 2 ? std::strtoull(args[2].c_str(), nullptr, 10) : 1000;
+            if (!duration || *duration == 0 || !clock || tick_ms == 0)
+            {
+                printUsage();
+                return;
+            }
+
+            std::cout << "Simulating " << *duration << " ms (" << clock->describe() << ", tick " << tick_ms << " ms)...\n";
+
+            // Per-sample console lines would dominate an accelerated run
+            const bool echo = scheduler_.echoSamples();
+            scheduler_.setEchoSamples(false);
+            sensor::SimulationRunner runner(scheduler_, *clock, tick_ms);
+            const auto report = runner.run(*duration);
+            scheduler_.setEchoSamples(echo);
+
+            sensor::printReport(std::cout, report);
+            if (scheduler_.anomalyDetection())
+                sensor::printDetectorCosts(std::cout, scheduler_.detectorCosts());
+        }
+
+    private:
+        static void printUsage()
+        {
+            std::cout << "Usage: simulate <duration>[ms|s|m|h|d] [realtime|<factor>x|afap] [tick_ms]\n"
+                      << "       e.g. simulate 1d afap\n";
+        }
+
+        sensor::SensorScheduler &scheduler_;
+        std::atomic<bool> &is_running_;
+    };
+}
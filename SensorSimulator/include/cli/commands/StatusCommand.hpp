@@ -2,6 +2,7 @@
 
 #include "ICommand.hpp"
 #include "scheduler/SensorScheduler.hpp"
+#include "scheduler/SimulationRunner.hpp"
 #include "sensors/SimpleSensor.hpp"
 #include <iostream>
 
@@ -27,7 +28,7 @@ namespace cli
             }
 
             const std::string &sensorId = args[0];
-            auto sensor = scheduler_.getScheduledSensorAs<sensor::SimpleSensor>(sensorId);
+            auto sensor = scheduler_.getScheduledSensorAs<sensor::ISensor>(sensorId);
             if (!sensor)
             {
                 std::cout << "Sensor not found: " << sensorId << "\n";
@@ -35,6 +36,7 @@ namespace cli
             }
 
             auto faults = sensor->getActiveFaults(scheduler_.getNow());
+            auto simple = dynamic_cast<sensor::SimpleSensor *>(sensor);
             if (faults.empty())
             {
                 std::cout << "Status: Normal - No active faults on " << sensorId << "\n";
@@ -43,23 +45,30 @@ namespace cli
             {
                 for (const auto &f : faults)
                 {
-                    if (f == "spike")
+                    if (!simple)
+                    {
+                        std::cout << " * " << f << "\n";
+                    }
+                    else if (f == "spike")
                     {
                         std::cout << " * spike — transient fault active until "
-                                  << sensor->getActiveSpike().end_time_ms << " ms\n";
+                                  << simple->getActiveSpike().end_time_ms << " ms\n";
                     }
                     else if (f == "stuck")
                     {
                         std::cout << " * stuck — output fixed until "
-                                  << sensor->getActiveStuck().end_time_ms << " ms\n";
+                                  << simple->getActiveStuck().end_time_ms << " ms\n";
                     }
                     else if (f == "dropout")
                     {
                         std::cout << " * dropout — signal lost (NaN) until "
-                                  << sensor->getActiveDropout().end_time_ms << " ms\n";
+                                  << simple->getActiveDropout().end_time_ms << " ms\n";
                     }
                 }
             }
+
+            if (const auto *stats = scheduler_.getSensorStats(sensorId))
+                sensor::printStats(std::cout, sensorId, *stats);
         }
 
     private:
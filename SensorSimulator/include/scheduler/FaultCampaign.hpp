@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include <cppminidb/MiniDB.hpp>
+#include "scheduler/SensorScheduler.hpp"
+
+namespace sensor
+{
+    /**
+     * Fault-injection campaign (e.g. `config/fault_campaign.json`):
+     *
+     *   {
+     *     "seed": 1,
+     *     "events": [
+     *       { "at_ms": 1000, "sensor": "TEMP-0001", "fault": "spike", "mag": 5.0, "sigma": 0.3 },
+     *       { "at_ms": 5000, "sensor": "PRES-*", "fault": "dropout", "duration_ms": 2000 }
+     *     ],
+     *     "random": [
+     *       { "fault": "stuck", "sensor": "TEMP-*", "count": 1000, "from_ms": 0, "to_ms": 60000,
+     *         "duration_ms": [200, 2000] }
+     *     ]
+     *   }
+     *
+     * "sensor" is an id, "*" or a "PREFIX*" pattern matched against the scheduled
+     * sensors; an explicit event applies to every match, a random block picks one match
+     * per event. Random blocks draw times uniformly in [from_ms, to_ms); their numeric
+     * parameters may be [lo, hi] ranges. Defaults follow the `inject` command: spike
+     * mag 3.0 / sigma 0.5, stuck 1000 ms, dropout 2000 ms. Times are relative to the
+     * scheduler time at load.
+     */
+    struct FaultCampaign
+    {
+        std::vector<SensorScheduler::FaultEvent> events;
+    };
+
+    // @throws std::invalid_argument on unknown fault kinds or malformed entries, including a negative count or duration_ms
+    FaultCampaign parseFaultCampaign(const nlohmann::json &config, const std::vector<std::string> &sensorIds,
+                                     uint64_t origin_us = 0);
+
+    // @throws std::runtime_error if the file cannot be opened or parsed
+    FaultCampaign loadFaultCampaign(const std::string &path, const std::vector<std::string> &sensorIds,
+                                    uint64_t origin_us = 0);
+
+    // Injected faults against what reached the log. A fault is observed once per onset:
+    // a row that carries the fault flag after a row of the same sensor that did not.
+    // Overlapping injections on one sensor therefore show up as a single onset.
+    struct CampaignSummary
+    {
+        SensorScheduler::FaultCounts injected;
+        SensorScheduler::FaultCounts observed;
+        std::size_t sensors_affected = 0; // sensors with at least one observed fault
+        std::size_t faulted_rows = 0;
+    };
+
+    CampaignSummary summarizeCampaign(const SensorScheduler::FaultCounts &injected, const std::vector<LogEntry> &logs);
+
+    void printCampaignSummary(std::ostream &out, const CampaignSummary &summary);
+} // namespace sensor
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include <scheduler/SensorPool.hpp>
+#include <sensors/BasicSensor.hpp>
+#include <sensors/ISensor.hpp>
+#include <sensors/SimpleSensor.hpp>
+#include <sensors/Spec.hpp>
+
+namespace sensor
+{
+    class SensorScheduler;
+
+    // One sensor of a fleet: its spec and scheduling period
+    struct FleetEntry
+    {
+        SensorSpec spec;
+        uint64_t period_us;
+        std::size_t group = 0; // index of the config group it came from
+        bool pooled = false;   // the group asked for "pool": true
+        FaultSampling fault_sampling = FaultSampling::PerSample;
+    };
+
+    // Sensor type of pooled fleet groups (see deployFleet)
+    using FleetPoolSensor = BasicSensor<policy::WaveSignal, policy::SpecNoise, policy::RandomFaults>;
+
+    /**
+     * Fleet config (e.g. `config/fleet_config.json`):
+     *
+     *   {
+     *     "seed": 42,
+     *     "templates": { "room": { "preset": "temp", "noise": { "gaussian_sigma": 0.1 } } },
+     *     "groups": [
+     *       { "template": "room", "id": "TEMP-{n:04}", "count": 1000, "period_ms": 1000,
+     *         "base_level": [18.0, 26.0] }
+     *     ]
+     *   }
+     *
+     * A group is its template's fields overlaid with its own. "preset" starts from
+     * makeDefault{Temp,Pressure,Imu}Spec ("temp", "pressure", "imu"); otherwise a
+     * default SensorSpec. Any numeric field may be a [lo, hi] range, spread linearly
+     * across the group's `count` sensors. "{n}" / "{n:W}" in the id is the instance
+     * number from "start" (default 1), zero-padded to W digits. The period defaults to
+     * 1 / rate_hz; "period_ms" or "period_us" override it. "base" is any Waveform
+     * shape; "wave_table" is a plain array of offsets. "fault_sampling" ("per_sample"
+     * or "timeline", at the top level or per group) selects the SimpleSensor
+     * FaultSampling mode.
+     *
+     * "pool": true marks a homogeneous group for deployFleet, which then schedules it as
+     * one SensorPool<FleetPoolSensor>. A pooled group must be single-channel, share one
+     * period and have no random stuck faults (BasicSensor does not model them). Pooled
+     * sensors always draw their random faults from a FaultTimeline.
+     */
+    struct FleetSpec
+    {
+        uint64_t seed = 42;
+        std::vector<FleetEntry> sensors;
+    };
+
+    // @throws std::invalid_argument on malformed groups or templates
+    FleetSpec parseFleetSpec(const nlohmann::json &config);
+
+    // @throws std::runtime_error if the file cannot be opened or parsed
+    FleetSpec loadFleetSpec(const std::string &path);
+
+    // SimpleSensor, or MultiChannelSensor for specs with channels; sensor i is reset
+    // with seed + i so a fleet is reproducible
+    std::vector<std::unique_ptr<ISensor>> makeFleetSensors(const FleetSpec &fleet);
+
+    // Builds the sensors and schedules them with one SensorScheduler::addScheduledSensors
+    // call, then each pooled group with SensorScheduler::addSensorPool. `owned` and
+    // `pools` receive the sensors and pools (they are appended to, not cleared). Returns
+    // the number scheduled.
+    std::size_t deployFleet(const FleetSpec &fleet, SensorScheduler &scheduler,
+                            std::vector<std::unique_ptr<ISensor>> &owned,
+                            std::vector<std::unique_ptr<ISensorPool>> &pools);
+} // namespace sensor
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <sensors/ReplaySensor.hpp>
+#include <cppminidb/MiniDB.hpp>
+#include <cppminidb/SensorLogRow.hpp>
+
+namespace sensor
+{
+    // The recorded samples of one sensor, oldest first
+    struct RecordedStream
+    {
+        std::string id;
+        std::string type;
+        std::vector<RecordedSample> samples;
+    };
+
+    /**
+     * Binary capture format (`.cap`), host byte order:
+     *
+     *   "SEPCAP01" | stream count (u32)
+     *   per stream: id length (u32) | id | type length (u32) | type | sample count (u64)
+     *               then per sample: ts_ms (i64) | value (f64) | quality (u8)
+     *
+     * Unlike the text log it keeps the exact double values and the QF_* flags.
+     */
+    void writeCapture(const std::string &path, const std::vector<RecordedStream> &streams);
+
+    // @throws std::runtime_error if the file cannot be read, is not a capture, or holds
+    //         stream/sample counts larger than the file can contain
+    std::vector<RecordedStream> readCapture(const std::string &path);
+
+    // Groups MiniDB log entries by sensor (first-appearance order), sorted by timestamp
+    std::vector<RecordedStream> streamsFromLogs(const std::vector<LogEntry> &logs);
+
+    // Replay sensor for a stream; rate_hz is derived from nominalPeriodMs()
+    std::unique_ptr<ReplaySensor> makeReplaySensor(const RecordedStream &stream);
+
+    // Collects emitted rows (e.g. from SensorScheduler::onSample) into streams for writeCapture()
+    class CaptureRecorder
+    {
+    public:
+        void record(const cppminidb::SensorLogRow &row);
+
+        const std::vector<RecordedStream> &streams() const { return streams_; }
+        void clear();
+
+    private:
+        std::vector<RecordedStream> streams_;
+        std::unordered_map<std::string, std::size_t> index_; // id -> streams_ position
+    };
+} // namespace sensor
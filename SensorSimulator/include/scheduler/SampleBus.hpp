@@ -0,0 +1,236 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cppminidb/BoundedQueue.hpp>
+#include <cppminidb/MiniDB.hpp>
+#include <cppminidb/SensorLogRow.hpp>
+
+namespace sensor
+{
+    using cppminidb::BoundedQueue;
+
+    // What publish() does when a subscriber's queue is full
+    enum class Backpressure
+    {
+        Block,      // wait for the consumer (sampling slows to the consumer's pace)
+        DropOldest, // evict the oldest queued row to make room
+        DropNewest  // discard the row being published
+    };
+
+    // "block", "drop-oldest" or "drop-newest"; false for anything else
+    inline bool parseBackpressure(const std::string &text, Backpressure &out)
+    {
+        if (text == "block")
+            out = Backpressure::Block;
+        else if (text == "drop-oldest")
+            out = Backpressure::DropOldest;
+        else if (text == "drop-newest")
+            out = Backpressure::DropNewest;
+        else
+            return false;
+        return true;
+    }
+
+    /**
+     * Fan-out bus between the scheduler and slow consumers (MiniDB writer, gateway
+     * channels, the agent). Each subscriber owns a bounded lock-free queue and a thread
+     * that drains it into its handler, so file or console I/O no longer stalls tick().
+     *
+     * Subscribe before start(). publish() may be called from several producer threads.
+     * stop() delivers what is already queued, then joins the consumer threads.
+     */
+    class SampleBus
+    {
+    public:
+        using Handler = std::function<void(const cppminidb::SensorLogRow &)>;
+
+        struct Stats
+        {
+            std::string name;
+            uint64_t published = 0; // rows offered to this subscriber
+            uint64_t delivered = 0; // rows handed to its handler
+            uint64_t dropped = 0;   // rows lost to DropOldest / DropNewest
+            std::size_t queued = 0;
+        };
+
+        SampleBus() = default;
+        SampleBus(const SampleBus &) = delete;
+        SampleBus &operator=(const SampleBus &) = delete;
+
+        ~SampleBus()
+        {
+            stop();
+        }
+
+        // @throws std::logic_error once the bus is running
+        void subscribe(const std::string &name, Handler handler, std::size_t capacity = 4096,
+                       Backpressure policy = Backpressure::DropOldest)
+        {
+            if (running_.load(std::memory_order_acquire))
+                throw std::logic_error("SampleBus: subscribe before start()");
+            subscribers_.push_back(std::make_unique<Subscriber>(name, std::move(handler), capacity, policy));
+        }
+
+        void start()
+        {
+            if (running_.exchange(true, std::memory_order_acq_rel))
+                return;
+            for (auto &sub : subscribers_)
+            {
+                sub->stopping.store(false, std::memory_order_relaxed);
+                sub->thread = std::thread([s = sub.get()]
+                                          { drain(*s); });
+            }
+        }
+
+        void stop()
+        {
+            if (!running_.exchange(false, std::memory_order_acq_rel))
+                return;
+            for (auto &sub : subscribers_)
+            {
+                sub->stopping.store(true, std::memory_order_release);
+                sub->signal.fetch_add(1, std::memory_order_release);
+                sub->signal.notify_one();
+            }
+            for (auto &sub : subscribers_)
+            {
+                if (sub->thread.joinable())
+                    sub->thread.join();
+            }
+        }
+
+        bool running() const { return running_.load(std::memory_order_acquire); }
+
+        void publish(const cppminidb::SensorLogRow &row)
+        {
+            for (auto &sub : subscribers_)
+            {
+                Subscriber &s = *sub;
+                s.published.fetch_add(1, std::memory_order_relaxed);
+                if (!s.queue.tryPush(row))
+                {
+                    switch (s.policy)
+                    {
+                    case Backpressure::Block:
+                        while (!s.queue.tryPush(row))
+                        {
+                            if (!running())
+                            {
+                                s.dropped.fetch_add(1, std::memory_order_relaxed);
+                                break;
+                            }
+                            std::this_thread::yield();
+                        }
+                        break;
+                    case Backpressure::DropOldest:
+                    {
+                        cppminidb::SensorLogRow evicted;
+                        while (!s.queue.tryPush(row))
+                        {
+                            if (s.queue.tryPop(evicted))
+                                s.dropped.fetch_add(1, std::memory_order_relaxed);
+                        }
+                        break;
+                    }
+                    case Backpressure::DropNewest:
+                        s.dropped.fetch_add(1, std::memory_order_relaxed);
+                        continue;
+                    }
+                }
+                s.signal.fetch_add(1, std::memory_order_release);
+                s.signal.notify_one();
+            }
+        }
+
+        // Blocks until every subscriber has handled what was published so far
+        void flush() const
+        {
+            for (const auto &sub : subscribers_)
+            {
+                while (sub->queue.size() > 0 || sub->busy.load(std::memory_order_acquire))
+                {
+                    if (!running())
+                        break;
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        std::vector<Stats> stats() const
+        {
+            std::vector<Stats> out;
+            out.reserve(subscribers_.size());
+            for (const auto &sub : subscribers_)
+            {
+                out.push_back({sub->name, sub->published.load(std::memory_order_relaxed),
+                               sub->delivered.load(std::memory_order_relaxed),
+                               sub->dropped.load(std::memory_order_relaxed), sub->queue.size()});
+            }
+            return out;
+        }
+
+        // Handler that appends rows to a MiniDB log the way SensorScheduler::setDatabase does
+        static Handler databaseWriter(MiniDB &db)
+        {
+            return [&db](const cppminidb::SensorLogRow &row)
+            {
+                if (row.channels.size() > 1)
+                    db.appendLog(row.sensor_id, row.timestamp_ms, std::span<const double>(row.channels), row.fault_flags);
+                else
+                    db.appendLog(row.sensor_id, row.timestamp_ms, row.value, row.fault_flags);
+            };
+        }
+
+    private:
+        struct Subscriber
+        {
+            Subscriber(const std::string &n, Handler h, std::size_t capacity, Backpressure p)
+                : name(n), handler(std::move(h)), queue(capacity), policy(p) {}
+
+            std::string name;
+            Handler handler;
+            BoundedQueue<cppminidb::SensorLogRow> queue;
+            Backpressure policy;
+            std::thread thread;
+            std::atomic<uint32_t> signal{0}; // bumped per publish; the consumer waits on it when idle
+            std::atomic<bool> stopping{false};
+            std::atomic<bool> busy{false};
+            std::atomic<uint64_t> published{0};
+            std::atomic<uint64_t> delivered{0};
+            std::atomic<uint64_t> dropped{0};
+        };
+
+        static void drain(Subscriber &s)
+        {
+            cppminidb::SensorLogRow row;
+            for (;;)
+            {
+                const uint32_t seen = s.signal.load(std::memory_order_acquire);
+                s.busy.store(true, std::memory_order_release);
+                while (s.queue.tryPop(row))
+                {
+                    if (s.handler)
+                        s.handler(row);
+                    s.delivered.fetch_add(1, std::memory_order_relaxed);
+                }
+                s.busy.store(false, std::memory_order_release);
+                if (s.stopping.load(std::memory_order_acquire) && s.queue.size() == 0)
+                    return;
+                s.signal.wait(seen, std::memory_order_acquire);
+            }
+        }
+
+        std::vector<std::unique_ptr<Subscriber>> subscribers_;
+        std::atomic<bool> running_{false};
+    };
+} // namespace sensor
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <sensors/BasicSensor.hpp>
+
+namespace sensor
+{
+    // Type-erased view of a SensorPool for SensorScheduler: one virtual call per pool
+    // per due time, however many sensors the pool holds.
+    class ISensorPool
+    {
+    public:
+        struct Output
+        {
+            double value;
+            uint8_t fault_flags; // activeFaultFlags(), only filled when requested
+        };
+
+        virtual ~ISensorPool() = default;
+
+        virtual std::size_t size() const = 0;
+        virtual ISensor &member(std::size_t i) = 0;
+
+        // Samples every member i with live[i] != 0 at ts_ms into out[i]; removed members
+        // are skipped, so their state and RNG streams do not advance
+        virtual void sampleAll(int64_t ts_ms, bool wantFaults, const uint8_t *live, Output *out) = 0;
+
+        // Set by SensorScheduler::addSensorPool; members can no longer be added
+        void seal() { sealed_ = true; }
+        bool sealed() const { return sealed_; }
+
+    private:
+        bool sealed_ = false;
+    };
+
+    /**
+     * Contiguous storage for sensors of one concrete type (e.g. a BasicSensor
+     * instantiation), scheduled as a unit with SensorScheduler::addSensorPool. The
+     * sampling loop calls S::sample() directly, so it is inlined per sensor type instead
+     * of going through ISensor's virtual calls. Members keep their ISensor interface for
+     * lookup and fault injection by id.
+     */
+    template <typename S>
+    class SensorPool final : public ISensorPool
+    {
+    public:
+        SensorPool() = default;
+        SensorPool(const SensorPool &) = delete;
+        SensorPool &operator=(const SensorPool &) = delete;
+
+        void reserve(std::size_t n) { sensors_.reserve(n); }
+
+        // @throws std::logic_error once the pool is scheduled (members must not move)
+        S &emplace(const SensorSpec &spec)
+        {
+            if (sealed())
+                throw std::logic_error("SensorPool: add sensors before scheduling the pool");
+            return sensors_.emplace_back(spec);
+        }
+
+        std::size_t size() const override { return sensors_.size(); }
+        S &operator[](std::size_t i) { return sensors_[i]; }
+        S &member(std::size_t i) override { return sensors_[i]; }
+
+        void sampleAll(int64_t ts_ms, bool wantFaults, const uint8_t *live, Output *out) override
+        {
+            const std::size_t n = sensors_.size();
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                if (live[i])
+                    out[i].value = sensors_[i].sample(ts_ms).value;
+            }
+            if (wantFaults)
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    if (live[i])
+                        out[i].fault_flags = sensors_[i].activeFaultFlags(ts_ms);
+                }
+            }
+        }
+
+    private:
+        std::vector<S> sensors_;
+    };
+} // namespace sensor
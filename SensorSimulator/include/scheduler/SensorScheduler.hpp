@@ -1,27 +1,137 @@
 #pragma once
 
 #include <unordered_map>
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
 #include <memory>
+#include <mutex>
+#include <queue>
+#include <span>
 #include <string>
+#include <thread>
 #include <vector>
+#include <sensors/AnomalyDetector.hpp>
+#include <sensors/OnlineStats.hpp>
 #include <sensors/SimpleSensor.hpp>
+#include <scheduler/SensorPool.hpp>
 #include <cppminidb/MiniDB.hpp>
 #include <functional>
 #include <cppminidb/SensorLogRow.hpp>
 
 namespace sensor
 {
+    class SampleBus;
+
+    /**
+     * Event-driven sampling scheduler.
+     *
+     * Every scheduled sensor has exactly one pending event in a min-heap keyed
+     * by its next sample time. tick() pops only the events that are due, so the
+     * cost of a tick is O(due * log n) regardless of how many sensors are idle.
+     * Time is kept in microseconds so kHz sensors are scheduled exactly; the
+     * millisecond API is a thin wrapper.
+     * A tick that spans several periods emits every missed sample, and samples
+     * from all sensors are emitted in timestamp order (registration order
+     * breaks ties).
+     *
+     * With setWorkerThreads(n > 1) sensors are partitioned across n shards, each
+     * with its own heap and worker thread. Workers generate their due samples in
+     * parallel; tick() then merges the shard outputs and emits them (console,
+     * MiniDB, onSample) on the calling thread in the same order as inline mode.
+     * Sensors added by a callback during the merge are sampled in a further round
+     * of the same tick, as inline mode does. An exception thrown by a sensor on a
+     * worker is rethrown from tick() after the samples due before it are emitted;
+     * sensors that workers had already sampled past it are sampled again next tick.
+     */
     class SensorScheduler
     {
     public:
+        SensorScheduler();
+        ~SensorScheduler();
+        SensorScheduler(const SensorScheduler &) = delete;
+        SensorScheduler &operator=(const SensorScheduler &) = delete;
+
         // Adds a new sensor to the scheduler with a given sampling period (in ms)
         void addScheduledSensor(const std::string &id, ISensor *sensor, uint64_t period_ms);
 
+        // Same with a microsecond period (e.g. 500 for a 2 kHz sensor)
+        void addScheduledSensorUs(const std::string &id, ISensor *sensor, uint64_t period_us);
+
+        // Schedules at the sensor's nominal rateHz() (period rounded to the nearest µs)
+        void addScheduledSensorAtRate(const std::string &id, ISensor *sensor);
+
+        struct BulkSensor
+        {
+            std::string id;
+            ISensor *sensor;
+            uint64_t period_us;
+        };
+
+        // Schedules many sensors in one pass (e.g. a fleet at startup): storage is reserved
+        // up front, each shard heap is built once and a single summary line is printed.
+        // Duplicate ids, null sensors and zero periods are skipped. Returns the number added.
+        std::size_t addScheduledSensors(std::span<const BulkSensor> sensors);
+
+        // Pre-sizes the sensor table for `sensors` entries in total
+        void reserve(std::size_t sensors);
+
+        // Schedules every member of `pool` (see SensorPool) with one shared period and a
+        // single heap event: when it is due, all members are sampled in one typed loop,
+        // then emitted in pool order. Members are registered by id like other sensors
+        // (duplicate ids are skipped) and can be looked up, faulted and removed one by
+        // one. Seals the pool; it must outlive the scheduler. Returns the number added.
+        std::size_t addSensorPool(ISensorPool &pool, uint64_t period_us);
+
+        enum class FaultKind
+        {
+            Spike,
+            Stuck,
+            Dropout
+        };
+
+        // A fault to trigger on a sensor at a simulation time (µs)
+        struct FaultEvent
+        {
+            uint64_t at_us;
+            std::string sensor_id;
+            FaultKind kind;
+            double mag = 3.0;         // spike
+            double sigma = 0.5;       // spike
+            int64_t duration_ms = 0;  // stuck / dropout
+        };
+
+        struct FaultCounts
+        {
+            std::size_t spike = 0;
+            std::size_t stuck = 0;
+            std::size_t dropout = 0;
+
+            std::size_t total() const { return spike + stuck + dropout; }
+        };
+
+        // Queues timed faults (e.g. a campaign). Sensor ids are resolved once here; events
+        // for unknown ids are skipped. tick() splits at each event time, so samples before
+        // it are emitted first, and dispatches due events from a min-heap in O(log n) each.
+        // Events for sensors removed in the meantime are dropped. Returns the number queued.
+        std::size_t scheduleFaults(std::span<const FaultEvent> events);
+
+        // Triggers a fault on a scheduled sensor now; false if the id is unknown
+        bool injectFault(const FaultEvent &event);
+
+        std::size_t pendingFaults() const { return fault_queue_.size(); }
+
+        // Faults triggered so far via scheduleFaults() or injectFault()
+        const FaultCounts &injectedFaults() const { return injected_faults_; }
+
         // Removes a sensor from the scheduler
         void removeSensor(const std::string &id);
 
-        // Advances internal time and samples sensors whose time has come
+        // Advances internal time and emits every sample due at or before the new time,
+        // stamped with its scheduled time
         void tick(uint64_t delta_ms);
+        void tickUs(uint64_t delta_us);
 
         // Lists current sensor IDs and their next sample time
         void listSensorStates() const;
@@ -29,36 +139,219 @@ namespace sensor
         SimpleSensor *getScheduledSensor(const std::string &id) const;
         std::vector<std::string> getSensorIds() const;
 
-        // Returns the current simulation time
+        // Returns the current simulation time (ms, truncated)
         uint64_t getNow() const;
+        uint64_t getNowUs() const;
 
         void setDatabase(MiniDB *db);
 
+        // Also publish every emitted row to `bus` (nullptr to detach). Unlike setDatabase and
+        // onSample, bus subscribers run on their own threads and cannot stall tick().
+        void setSampleBus(SampleBus *bus);
+
         void removeScheduledSensor(const std::string &id);
 
+        // Number of sampling worker threads; 0 or 1 samples inline on the tick() caller.
+        // A sensor is only touched by its shard's worker during the generation phase,
+        // so sensors must not be shared between scheduler entries in sharded mode.
+        // Must not be called from onSample.
+        void setWorkerThreads(std::size_t threads);
+        std::size_t workerThreads() const;
+
+        // Total samples emitted since construction (for throughput reports)
+        uint64_t samplesEmitted() const { return samples_emitted_; }
+
+        // Per-sample "[Tick @ ...]" lines, logged at Debug; disable for long accelerated runs
+        void setEchoSamples(bool echo) { echo_samples_ = echo; }
+        bool echoSamples() const { return echo_samples_; }
+
+        // Running statistics of every value the scheduler has emitted for a sensor (see
+        // OnlineStats), updated in O(1) per sample and reset when the sensor is removed.
+        // nullptr if the id is not scheduled; the pointer is valid until the next tick.
+        const OnlineStats *getSensorStats(const std::string &id) const;
+
+        // On by default; off skips the per-sample update (the last values are kept)
+        void setStatsEnabled(bool enabled) { stats_enabled_ = enabled; }
+        bool statsEnabled() const { return stats_enabled_; }
+
+        // Runs an AnomalyDetector per sensor on every emitted value (after the sensor, before
+        // MiniDB, the bus and onSample) and appends its findings ("noisy", "flatline", "rate")
+        // to the row's fault flags. Multi-channel sensors are checked on channel 0 (`value`)
+        // only. Enabling again restarts every detector with `config`.
+        void enableAnomalyDetection(const AnomalyConfig &config = {});
+        void disableAnomalyDetection();
+        bool anomalyDetection() const { return detect_; }
+
+        // Work done by one detector stage since detection was enabled. One sample in
+        // kDetectorTimingInterval is timed stage by stage (less the cost of reading the
+        // clock), so nsPerCheck() is an estimate.
+        struct DetectorCost
+        {
+            uint64_t checks = 0;
+            uint64_t flagged = 0;
+            uint64_t timed = 0;
+            uint64_t timed_ns = 0;
+
+            double nsPerCheck() const { return timed ? static_cast<double>(timed_ns) / timed : 0.0; }
+        };
+
+        static constexpr uint64_t kDetectorTimingInterval = 64;
+
+        // Indexed by AnomalyDetector::Stage
+        const std::array<DetectorCost, AnomalyDetector::kStages> &detectorCosts() const { return detector_costs_; }
+
         template <typename T>
         T *getScheduledSensorAs(const std::string &id) const
         {
-            auto it = schedule_.find(id);
-            if (it != schedule_.end())
-            {
-                return dynamic_cast<T *>(it->second.sensor);
-            }
-            return nullptr;
+            return dynamic_cast<T *>(findSensor(id));
         }
 
         std::function<void(const cppminidb::SensorLogRow &)> onSample;
 
     private:
+        static constexpr std::size_t kNoPool = SIZE_MAX;
+
         struct SensorEntry
         {
-            ISensor *sensor;
-            uint64_t period_ms;
-            uint64_t next_sample_time_ms;
+            std::string id;
+            SensorHandle handle = kInvalidSensorHandle;
+            ISensor *sensor = nullptr; // nullptr marks a free slot
+            uint64_t period_us = 0;
+            uint64_t next_sample_time_us = 0;
+            uint64_t order = 0;      // registration sequence, breaks timestamp ties
+            uint64_t generation = 0; // bumped on removal so queued events go stale
+            std::size_t pool = kNoPool; // pool members have no heap event of their own
+            std::size_t pool_member = 0; // index in the pool, when pool != kNoPool
+        };
+
+        struct DueEvent
+        {
+            uint64_t due_us;
+            uint64_t order;
+            std::size_t slot;
+            uint64_t generation;
+            std::size_t pool = kNoPool; // set for a pool's shared event (slot unused)
+        };
+
+        struct PoolEntry
+        {
+            ISensorPool *pool;
+            std::vector<std::size_t> slots; // per member; kNoPool for skipped duplicates
+            std::vector<uint64_t> generations;
+            std::vector<uint8_t> live_mask; // per member: 1 while scheduled, passed to sampleAll()
+            std::size_t live = 0;           // members still scheduled
+            uint64_t period_us;
+            uint64_t next_sample_time_us;
+            uint64_t order;
+            std::vector<ISensorPool::Output> out; // sampleAll() scratch
+        };
+
+        struct LaterFirst
+        {
+            bool operator()(const DueEvent &a, const DueEvent &b) const
+            {
+                return a.due_us != b.due_us ? a.due_us > b.due_us : a.order > b.order;
+            }
         };
 
-        uint64_t current_time_ms_ = 0;
-        std::unordered_map<std::string, SensorEntry> schedule_;
+        // A sample generated by a shard worker, waiting for the merge stage
+        struct GeneratedSample
+        {
+            DueEvent event;
+            double value;
+            std::vector<std::string> faults;
+            std::array<double, kMaxChannels> channels; // multi-channel sensors only
+            std::size_t channel_count = 0;
+        };
+
+        struct Shard
+        {
+            std::priority_queue<DueEvent, std::vector<DueEvent>, LaterFirst> queue;
+            std::size_t stale_events = 0; // events of removed sensors still in queue
+            std::vector<GeneratedSample> generated;
+            DueEvent current{};         // event being generated, identifies a failure
+            std::exception_ptr error;   // thrown by a sensor during generation
+        };
+
+        struct QueuedFault
+        {
+            uint64_t at_us;
+            uint64_t order; // queue sequence, keeps same-time events in file order
+            std::size_t slot;
+            uint64_t generation;
+            FaultKind kind;
+            double mag;
+            double sigma;
+            int64_t duration_ms;
+        };
+
+        struct LaterFault
+        {
+            bool operator()(const QueuedFault &a, const QueuedFault &b) const
+            {
+                return a.at_us != b.at_us ? a.at_us > b.at_us : a.order > b.order;
+            }
+        };
+
+        ISensor *findSensor(const std::string &id) const;
+        bool unschedule(const std::string &id);
+        bool isLive(const DueEvent &event) const;
+        Shard &shardFor(std::size_t slot) { return shards_[slot % shards_.size()]; }
+        Shard &shardForPool(std::size_t pool) { return shards_[pool % shards_.size()]; }
+        bool memberLive(const PoolEntry &pool, std::size_t member) const;
+        // Fault names are only looked up when a row consumer or the stats will see them
+        bool faultsWanted() const { return db_ || bus_ || onSample || stats_enabled_; }
+        void emitSample(std::size_t slot, uint64_t timestamp_us);
+        void emitPool(std::size_t pool, uint64_t timestamp_us);
+        void publishSample(std::size_t slot, uint64_t timestamp_us, double value,
+                           const std::vector<std::string> &faults, std::span<const double> channels);
+        uint8_t runDetector(AnomalyDetector &detector, int64_t ts_ms, double value);
+        void compactQueue(Shard &shard);
+        void advanceTo(uint64_t now_us);
+        void dispatchFaults(uint64_t now_us);
+        void triggerFault(ISensor &sensor, FaultKind kind, double mag, double sigma, int64_t duration_ms,
+                          uint64_t at_us);
+
+        void tickSharded();
+        void mergeShards();
+        void requeueUnmerged(const DueEvent &failed);
+        bool shardsDue() const;
+        void generateShard(Shard &shard, uint64_t now_us);
+        void workerLoop(std::size_t shard, uint64_t seen);
+        void stopWorkers();
+
+        uint64_t current_time_us_ = 0;
+        std::unordered_map<std::string, std::size_t> index_; // id -> slot
+        std::vector<SensorEntry> slots_;
+        std::vector<std::size_t> free_slots_;
+        std::vector<Shard> shards_; // exactly one in inline mode
+        std::vector<PoolEntry> pools_;
+        std::vector<std::string> pool_faults_; // reused per pooled emission
+        uint64_t next_order_ = 0;
         MiniDB *db_ = nullptr;
+        SampleBus *bus_ = nullptr;
+        cppminidb::SensorLogRow row_; // reused for every emission, so strings keep their capacity
+        uint64_t samples_emitted_ = 0;
+        bool echo_samples_ = true;
+        std::vector<OnlineStats> stats_; // by slot, grown on first emission
+        bool stats_enabled_ = true;
+        std::vector<AnomalyDetector> detectors_; // by slot, grown on first emission
+        AnomalyConfig detector_config_;
+        std::array<DetectorCost, AnomalyDetector::kStages> detector_costs_{};
+        uint64_t detector_samples_ = 0;
+        uint64_t timer_overhead_ns_ = 0;
+        bool detect_ = false;
+        std::priority_queue<QueuedFault, std::vector<QueuedFault>, LaterFault> fault_queue_;
+        uint64_t next_fault_order_ = 0;
+        FaultCounts injected_faults_;
+
+        // Sharded mode: workers_[i] serves shards_[i]
+        std::vector<std::thread> workers_;
+        std::mutex pool_mtx_;
+        std::condition_variable work_cv_;
+        std::condition_variable done_cv_;
+        uint64_t epoch_ = 0;    // bumped once per sharded tick
+        std::size_t busy_ = 0;  // workers still generating for the current epoch
+        bool stopping_ = false;
     };
 }
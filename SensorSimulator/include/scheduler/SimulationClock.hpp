@@ -0,0 +1,133 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <string>
+
+namespace sensor
+{
+    // Wake-up lateness of paced ticks (actual wake time minus deadline), in µs.
+    // Welford running mean/variance, so recording is O(1) and allocation-free.
+    class JitterStats
+    {
+    public:
+        void record(std::chrono::steady_clock::duration lateness)
+        {
+            const double us = std::chrono::duration<double, std::micro>(lateness).count();
+            ++count_;
+            const double delta = us - mean_;
+            mean_ += delta / static_cast<double>(count_);
+            m2_ += delta * (us - mean_);
+            min_ = count_ == 1 ? us : std::min(min_, us);
+            max_ = count_ == 1 ? us : std::max(max_, us);
+        }
+
+        uint64_t count() const { return count_; }
+        double meanUs() const { return mean_; }
+        double minUs() const { return min_; }
+        double maxUs() const { return max_; }
+        double stddevUs() const { return count_ > 1 ? std::sqrt(m2_ / static_cast<double>(count_ - 1)) : 0.0; }
+
+    private:
+        uint64_t count_ = 0;
+        double mean_ = 0.0;
+        double m2_ = 0.0;
+        double min_ = 0.0;
+        double max_ = 0.0;
+    };
+
+    /**
+     * Maps simulated time onto wall-clock time for the run loops.
+     *
+     *  - RealTime:          1 simulated second per wall second
+     *  - Scaled:            `factor` simulated seconds per wall second (e.g. 100x)
+     *  - AsFastAsPossible:  no pacing; ticks run back to back
+     *
+     * Deadlines are absolute (start + simulated / factor), so time spent processing a
+     * tick is absorbed by the next wait instead of accumulating as drift.
+     */
+    class SimulationClock
+    {
+    public:
+        enum class Mode
+        {
+            RealTime,
+            Scaled,
+            AsFastAsPossible
+        };
+
+        using WallClock = std::chrono::steady_clock;
+
+        static SimulationClock realTime() { return SimulationClock(Mode::RealTime, 1.0); }
+        static SimulationClock scaled(double factor)
+        {
+            return factor == 1.0 ? realTime() : SimulationClock(Mode::Scaled, factor);
+        }
+        static SimulationClock asFastAsPossible() { return SimulationClock(Mode::AsFastAsPossible, 0.0); }
+
+        // Parses "realtime", "afap"/"max", or a speed factor such as "100" or "100x".
+        // Returns nullopt for anything else, including non-positive factors.
+        static std::optional<SimulationClock> parse(const std::string &text)
+        {
+            if (text == "realtime" || text == "rt")
+                return realTime();
+            if (text == "afap" || text == "max")
+                return asFastAsPossible();
+
+            std::string number = text;
+            if (!number.empty() && (number.back() == 'x' || number.back() == 'X'))
+                number.pop_back();
+            if (number.empty())
+                return std::nullopt;
+
+            char *end = nullptr;
+            const double factor = std::strtod(number.c_str(), &end);
+            if (end != number.c_str() + number.size() || !(factor > 0.0))
+                return std::nullopt;
+            return scaled(factor);
+        }
+
+        Mode mode() const { return mode_; }
+        double factor() const { return factor_; }
+        bool paced() const { return mode_ != Mode::AsFastAsPossible; }
+
+        // Wall-clock time at which `simulated_ms` of simulated time should have elapsed
+        WallClock::time_point deadline(WallClock::time_point start, uint64_t simulated_ms) const
+        {
+            if (!paced())
+                return start;
+            const auto wall = std::chrono::duration<double, std::milli>(static_cast<double>(simulated_ms) / factor_);
+            return start + std::chrono::duration_cast<WallClock::duration>(wall);
+        }
+
+        std::string describe() const
+        {
+            switch (mode_)
+            {
+            case Mode::RealTime:
+                return "real-time";
+            case Mode::Scaled:
+            {
+                std::string f = std::to_string(factor_);
+                f.erase(f.find_last_not_of('0') + 1);
+                if (!f.empty() && f.back() == '.')
+                    f.pop_back();
+                return f + "x";
+            }
+            case Mode::AsFastAsPossible:
+                return "as-fast-as-possible";
+            }
+            return "?";
+        }
+
+    private:
+        SimulationClock(Mode mode, double factor) : mode_(mode), factor_(factor) {}
+
+        Mode mode_;
+        double factor_;
+    };
+} // namespace sensor
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string>
+#include "SensorScheduler.hpp"
+#include "SimulationClock.hpp"
+
+namespace sensor
+{
+    // Outcome of a simulation run; rates are per wall-clock second.
+    struct SimulationReport
+    {
+        uint64_t simulated_ms = 0;
+        uint64_t ticks = 0;
+        uint64_t samples = 0;
+        double wall_seconds = 0.0;
+        JitterStats jitter; // paced modes only
+
+        double samplesPerSecond() const { return wall_seconds > 0.0 ? samples / wall_seconds : 0.0; }
+        double speedup() const { return wall_seconds > 0.0 ? simulated_ms / 1000.0 / wall_seconds : 0.0; }
+    };
+
+    void printReport(std::ostream &os, const SimulationReport &report);
+
+    // Two-line summary of a sensor's OnlineStats, e.g. for `status` and the gateway report
+    void printStats(std::ostream &os, const std::string &id, const OnlineStats &stats);
+
+    // One line per anomaly detector stage: checks, samples flagged and estimated ns per check
+    void printDetectorCosts(std::ostream &os, const std::array<SensorScheduler::DetectorCost, AnomalyDetector::kStages> &costs);
+
+    // Parses "1500", "1500ms", "90s", "15m", "6h" or "1d" into milliseconds; nullopt for
+    // other text or a duration too long to count in microseconds.
+    std::optional<uint64_t> parseDurationMs(const std::string &text);
+
+    /**
+     * Drives a SensorScheduler in fixed ticks of simulated time, paced by a
+     * SimulationClock. Used for bounded runs (e.g. a simulated day as fast as
+     * possible for soak tests) that end with a throughput report.
+     */
+    class SimulationRunner
+    {
+    public:
+        SimulationRunner(SensorScheduler &scheduler, SimulationClock clock, uint64_t tick_ms = 1000)
+            : scheduler_(scheduler), clock_(clock), tick_ms_(tick_ms > 0 ? tick_ms : 1) {}
+
+        // Advances the scheduler by duration_ms of simulated time, or until stop() when
+        // duration_ms is 0. The last tick is shortened so the run ends exactly on time.
+        SimulationReport run(uint64_t duration_ms);
+
+        // Thread-safe; also interrupts a paced wait.
+        void stop();
+
+    private:
+        SensorScheduler &scheduler_;
+        SimulationClock clock_;
+        uint64_t tick_ms_;
+        std::mutex mtx_;
+        std::condition_variable cv_;
+        bool stop_ = false;
+    };
+} // namespace sensor
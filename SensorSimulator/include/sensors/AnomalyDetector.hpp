@@ -0,0 +1,187 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "sensors/Sample.hpp"
+
+namespace sensor
+{
+    // Thresholds of an AnomalyDetector; a zero threshold disables that detector
+    struct AnomalyConfig
+    {
+        static constexpr std::size_t kMaxWindow = 65536;
+
+        std::size_t window = 32;           // z-score: rolling window, in samples (2..kMaxWindow)
+        double z_threshold = 4.0;          // z-score: |value - mean| > z_threshold * stddev → QF_NOISY
+        std::size_t flatline_samples = 20; // flatline: this many equal values in a row → QF_FLATLINE
+        double flatline_epsilon = 0.0;     // flatline: largest distance from the run's first value
+        double flatline_relative = 1e-9;   // flatline: or this fraction of |first value|, if larger,
+                                           // so rounding-level jitter on a stuck value stays flat
+        double max_rate_per_s = 0.0;       // rate: |dv/dt| above this (units per second) → QF_RATE
+    };
+
+    /**
+     * Per-sensor streaming anomaly checks, run on each value after it is sampled:
+     *
+     *   zscore   — distance from the mean of the last `window` values in standard deviations
+     *   flatline — `flatline_samples` values in a row within epsilon (or the relative
+     *              tolerance) of the first of them
+     *   rate     — change since the previous value faster than `max_rate_per_s`
+     *
+     * Each stage is O(1) per value and keeps its own state; the window is allocated once
+     * at construction. The z-score stage only fires once the window is full, and keeps
+     * running sums relative to a reference that is moved to the window mean every
+     * `window` values (sums recomputed exactly), so rounding does not build up and a
+     * large or drifting level costs no precision.
+     */
+    class AnomalyDetector
+    {
+    public:
+        enum Stage : std::size_t
+        {
+            ZScore,
+            Flatline,
+            Rate,
+            kStages
+        };
+
+        static constexpr const char *kStageNames[kStages] = {"zscore", "flatline", "rate"};
+
+        explicit AnomalyDetector(const AnomalyConfig &config = {})
+            : config_(config),
+              window_(config.window >= 2 && config.z_threshold > 0.0 ? config.window : 0)
+        {
+        }
+
+        // Quality bits (QF_NOISY | QF_FLATLINE | QF_RATE) for one value; NaN (dropouts) is skipped
+        uint8_t check(int64_t ts_ms, double value)
+        {
+            if (std::isnan(value))
+                return QF_OK;
+            return zscore(value) | flatline(value) | rate(ts_ms, value);
+        }
+
+        // The stages of check(), callable one by one (e.g. to time them). Not NaN-safe.
+
+        uint8_t zscore(double value)
+        {
+            if (window_.empty())
+                return QF_OK;
+            uint8_t flags = QF_OK;
+            if (filled_ == window_.size())
+            {
+                const double n = static_cast<double>(filled_);
+                const double mean = sum_ / n;
+                const double variance = (sum_sq_ - sum_ * mean) / (n - 1.0);
+                const double d = value - ref_ - mean;
+                if (variance > 0.0 && d * d > config_.z_threshold * config_.z_threshold * variance)
+                    flags = QF_NOISY;
+            }
+            push(value);
+            return flags;
+        }
+
+        uint8_t flatline(double value)
+        {
+            if (config_.flatline_samples == 0)
+                return QF_OK;
+            // Against the value that started the run, so a slow drift of less than epsilon
+            // per sample still ends it
+            if (flat_count_ > 0 && std::abs(value - flat_start_) <= flat_tolerance_)
+            {
+                ++flat_count_;
+            }
+            else
+            {
+                flat_count_ = 1;
+                flat_start_ = value;
+                flat_tolerance_ = std::max(config_.flatline_epsilon, config_.flatline_relative * std::abs(value));
+            }
+            return flat_count_ >= config_.flatline_samples ? QF_FLATLINE : QF_OK;
+        }
+
+        uint8_t rate(int64_t ts_ms, double value)
+        {
+            if (config_.max_rate_per_s <= 0.0)
+                return QF_OK;
+            uint8_t flags = QF_OK;
+            if (has_rate_ && ts_ms > rate_ts_ms_ &&
+                std::abs(value - rate_last_) > config_.max_rate_per_s * static_cast<double>(ts_ms - rate_ts_ms_) / 1000.0)
+                flags = QF_RATE;
+            rate_last_ = value;
+            rate_ts_ms_ = ts_ms;
+            has_rate_ = true;
+            return flags;
+        }
+
+        void reset()
+        {
+            filled_ = 0;
+            head_ = 0;
+            sum_ = sum_sq_ = ref_ = 0.0;
+            flat_count_ = 0;
+            has_rate_ = false;
+        }
+
+        const AnomalyConfig &config() const { return config_; }
+
+    private:
+        void push(double value)
+        {
+            if (filled_ == 0)
+                ref_ = value;
+            const double x = value - ref_;
+            if (filled_ == window_.size())
+            {
+                const double old = window_[head_];
+                sum_ -= old;
+                sum_sq_ -= old * old;
+            }
+            else
+            {
+                ++filled_;
+            }
+            window_[head_] = x;
+            sum_ += x;
+            sum_sq_ += x * x;
+            if (++head_ == window_.size())
+            {
+                head_ = 0;
+                recenter();
+            }
+        }
+
+        void recenter()
+        {
+            const double shift = sum_ / static_cast<double>(filled_);
+            ref_ += shift;
+            sum_ = sum_sq_ = 0.0;
+            for (double &x : window_)
+            {
+                x -= shift;
+                sum_ += x;
+                sum_sq_ += x * x;
+            }
+        }
+
+        AnomalyConfig config_;
+
+        // zscore: window_ holds value - ref_
+        std::vector<double> window_;
+        std::size_t filled_ = 0;
+        std::size_t head_ = 0;
+        double sum_ = 0.0;
+        double sum_sq_ = 0.0;
+        double ref_ = 0.0;
+
+        std::size_t flat_count_ = 0; // values within epsilon of flat_start_ in a row, including it
+        double flat_start_ = 0.0;
+        double flat_tolerance_ = 0.0; // for the current run, fixed when it starts
+
+        bool has_rate_ = false;
+        double rate_last_ = 0.0;
+        int64_t rate_ts_ms_ = 0;
+    };
+} // namespace sensor
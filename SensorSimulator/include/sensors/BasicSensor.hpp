@@ -0,0 +1,354 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+#include "sensors/FaultTimeline.hpp"
+#include "sensors/ISensor.hpp"
+#include "sensors/Waveform.hpp"
+
+namespace sensor
+{
+    /**
+     * Stage policies for BasicSensor. Each is configured from the SensorSpec on reset()
+     * and called without virtual dispatch, so a sensor with NoNoise / NoFaults compiles
+     * down to its signal.
+     *
+     *   Signal: double at(int64_t now_ms) const
+     *   Noise:  double draw(std::mt19937_64 &rng, int64_t now_ms)
+     *   Faults: kEnabled, reset(spec, seed), dropout / stuck / spike stages, activeFlags()
+     *           and the triggers
+     */
+    namespace policy
+    {
+        struct ConstantSignal
+        {
+            double level = 0.0;
+
+            void reset(const SensorSpec &spec) { level = spec.base_level; }
+            double at(int64_t) const { return level; }
+        };
+
+        // Any SensorSpec::base shape (see Waveform)
+        struct WaveSignal
+        {
+            Waveform wave;
+
+            void reset(const SensorSpec &spec) { wave = Waveform::fromSpec(spec); }
+            double at(int64_t now_ms) const { return wave.at(now_ms); }
+        };
+
+        struct NoNoise
+        {
+            void reset(const SensorSpec &) {}
+            double draw(std::mt19937_64 &, int64_t) { return 0.0; }
+        };
+
+        // Gaussian, uniform and drift terms of SensorSpec::noise, as in SimpleSensor
+        struct SpecNoise
+        {
+            std::normal_distribution<double> gaussian{0.0, 1.0};
+            std::uniform_real_distribution<double> uniform{0.0, 0.0};
+            double sigma = 0.0;
+            double range = 0.0;
+            double drift_rate = 0.0; // units per second before saturation
+
+            void reset(const SensorSpec &spec)
+            {
+                sigma = spec.noise.gaussian_sigma;
+                range = spec.noise.uniform_range;
+                gaussian = std::normal_distribution<double>(0.0, sigma > 0.0 ? sigma : 1.0);
+                uniform = std::uniform_real_distribution<double>(-range, range);
+                drift_rate = spec.noise.drift_ppm * spec.base_level / 1'000'000.0;
+            }
+
+            double draw(std::mt19937_64 &rng, int64_t now_ms)
+            {
+                double noise = 0.0;
+                if (sigma > 0.0)
+                    noise += gaussian(rng);
+                if (range > 0.0)
+                    noise += uniform(rng);
+                if (drift_rate != 0.0)
+                {
+                    const double t_sec = now_ms / 1000.0;
+                    noise += drift_rate * t_sec / (1.0 + t_sec / 300.0);
+                }
+                return noise;
+            }
+        };
+
+        // No faults at all; fault triggers are ignored
+        struct NoFaults
+        {
+            static constexpr bool kEnabled = false;
+
+            void reset(const SensorSpec &, uint64_t) {}
+            bool dropout(int64_t, std::mt19937_64 &) { return false; }
+            bool stuck(int64_t, double &) { return false; }
+            void spike(int64_t, double &, uint8_t &, std::mt19937_64 &) {}
+            uint8_t activeFlags(int64_t) const { return 0; }
+            void triggerSpike(double, double, int64_t) {}
+            void triggerStuck(int64_t, int64_t, double) {}
+            void triggerDropout(int64_t, int64_t) {}
+        };
+
+        // Faults triggered from outside (shell, campaigns), with SimpleSensor's window rules
+        struct InjectedFaults
+        {
+            static constexpr bool kEnabled = true;
+
+            int64_t spike_end_ms = -1;
+            double spike_sigma = 0.0;
+            double spike_mag = 0.0;
+            int64_t stuck_end_ms = -1;
+            double frozen = 0.0;
+            int64_t dropout_start_ms = 0;
+            int64_t dropout_end_ms = -1;
+            bool spike_on = false;
+            bool stuck_on = false;
+            bool dropout_on = false;
+
+            void reset(const SensorSpec &, uint64_t) { *this = InjectedFaults{}; }
+
+            bool dropout(int64_t now_ms, std::mt19937_64 &)
+            {
+                return dropout_on && now_ms >= dropout_start_ms && now_ms <= dropout_end_ms;
+            }
+
+            bool stuck(int64_t now_ms, double &v)
+            {
+                if (!stuck_on)
+                    return false;
+                if (now_ms <= stuck_end_ms)
+                {
+                    v = frozen;
+                    return true;
+                }
+                stuck_on = false;
+                return false;
+            }
+
+            void spike(int64_t now_ms, double &v, uint8_t &quality, std::mt19937_64 &rng)
+            {
+                if (!spike_on)
+                    return;
+                if (now_ms > spike_end_ms)
+                {
+                    spike_on = false;
+                    return;
+                }
+                quality |= QF_SPIKE;
+                v += spike_sigma > 0.0 ? std::normal_distribution<double>(0.0, spike_sigma)(rng)
+                                       : (2.0 * spike_mag) * (rng() / (double)rng.max() - 0.5);
+            }
+
+            uint8_t activeFlags(int64_t now_ms) const
+            {
+                uint8_t flags = 0;
+                if (spike_on && now_ms <= spike_end_ms)
+                    flags |= QF_SPIKE;
+                if (stuck_on && now_ms <= stuck_end_ms)
+                    flags |= QF_STUCK;
+                if (dropout_on && now_ms <= dropout_end_ms)
+                    flags |= QF_DROPOUT;
+                return flags;
+            }
+
+            void triggerSpike(double mag, double sigma, int64_t now_ms)
+            {
+                spike_mag = mag;
+                spike_sigma = sigma;
+                spike_end_ms = now_ms + static_cast<int64_t>(50.0 * sigma * 1000);
+                spike_on = true;
+            }
+
+            void triggerStuck(int64_t duration_ms, int64_t now_ms, double current_value)
+            {
+                stuck_end_ms = now_ms + duration_ms;
+                frozen = current_value;
+                stuck_on = true;
+            }
+
+            void triggerDropout(int64_t now_ms, int64_t duration_ms)
+            {
+                dropout_start_ms = now_ms;
+                dropout_end_ms = now_ms + duration_ms;
+                dropout_on = true;
+            }
+        };
+
+        // Injected faults plus random dropouts and spikes at SensorSpec::fault probabilities
+        // (random stuck faults are not modelled, as in MultiChannelSensor). The random
+        // faults are FaultTimeline arrivals on SimpleSensor's fault stream, so between
+        // arrivals a sample costs one timestamp compare per kind, as in FaultSampling::Timeline
+        struct RandomFaults : InjectedFaults
+        {
+            FaultTimeline dropout_timeline;
+            FaultTimeline spike_timeline;
+            int64_t fault_clock_ms = -1;
+            double random_mag = 0.0;
+            double random_sigma = 0.0;
+
+            void reset(const SensorSpec &spec, uint64_t seed)
+            {
+                InjectedFaults::reset(spec, seed);
+                const double period_ms = spec.rate_hz > 0 ? 1000.0 / spec.rate_hz : 1000.0;
+                // SimpleSensor's fault stream and draw slots (kSlotDropout, kSlotSpikeTrial)
+                const CounterRng faults(seed, CounterRng::streamFor(spec.id) ^ 0x46544C31u);
+                dropout_timeline = FaultTimeline(std::clamp(spec.fault.dropout_prob, 0.0, 1.0), period_ms, faults, 0);
+                spike_timeline = FaultTimeline(std::clamp(spec.fault.spike_prob, 0.0, 1.0), period_ms, faults, 4);
+                fault_clock_ms = -1;
+                random_mag = spec.fault.spike_mag;
+                random_sigma = spec.fault.spike_sigma;
+            }
+
+            // Called first for every sample, so it also follows the actual sample spacing
+            bool dropout(int64_t now_ms, std::mt19937_64 &rng)
+            {
+                if (fault_clock_ms >= 0 && now_ms > fault_clock_ms)
+                {
+                    const double spacing = static_cast<double>(now_ms - fault_clock_ms);
+                    const double from = static_cast<double>(fault_clock_ms);
+                    dropout_timeline.retime(spacing, from);
+                    spike_timeline.retime(spacing, from);
+                }
+                fault_clock_ms = now_ms;
+                return InjectedFaults::dropout(now_ms, rng) || dropout_timeline.fires(now_ms);
+            }
+
+            void spike(int64_t now_ms, double &v, uint8_t &quality, std::mt19937_64 &rng)
+            {
+                if (spike_on)
+                {
+                    InjectedFaults::spike(now_ms, v, quality, rng);
+                    return;
+                }
+                if (!spike_timeline.fires(now_ms))
+                    return;
+                quality |= QF_SPIKE;
+                if (random_sigma > 0.0)
+                    v += std::normal_distribution<double>(0.0, random_sigma)(rng);
+                else if (random_mag > 0.0)
+                    v += (2.0 * random_mag) * (rng() / (double)rng.max() - 0.5);
+            }
+        };
+    } // namespace policy
+
+    /**
+     * Single-channel sensor composed at compile time from a signal, a noise and a fault
+     * policy. The pipeline (dropout → signal + noise → stuck → spike) is the same as
+     * SimpleSensor's, but sample() is non-virtual and the class is final, so typed code
+     * (SensorPool) inlines the whole thing. ISensor is implemented on top for the
+     * shell, campaigns and any code that mixes sensor types.
+     *
+     *   using TempSensor = BasicSensor<policy::WaveSignal, policy::SpecNoise, policy::InjectedFaults>;
+     */
+    template <typename Signal, typename Noise = policy::NoNoise, typename Faults = policy::NoFaults>
+    class BasicSensor final : public ISensor
+    {
+    public:
+        explicit BasicSensor(const SensorSpec &spec)
+            : spec_(spec),
+              history_(kMaxPlotSamples),
+              handle_(internSensorId(spec_.id))
+        {
+            reset(0);
+        }
+
+        void reset(uint64_t seed) override
+        {
+            seq_ = 0;
+            rng_.seed(seed);
+            handle_ = internSensorId(spec_.id);
+            signal_.reset(spec_);
+            noise_.reset(spec_);
+            faults_.reset(spec_, seed);
+        }
+
+        Sample sample(int64_t now_ms)
+        {
+            Sample s{now_ms, ++seq_, handle_, 0.0, QF_OK};
+            if (faults_.dropout(now_ms, rng_))
+            {
+                s.quality |= QF_DROPOUT;
+                s.value = std::numeric_limits<double>::quiet_NaN();
+                return s;
+            }
+
+            double v = signal_.at(now_ms) + noise_.draw(rng_, now_ms);
+            if (faults_.stuck(now_ms, v))
+            {
+                s.quality |= QF_STUCK;
+                s.value = v; // stuck values are not recorded, as in SimpleSensor
+                return s;
+            }
+            faults_.spike(now_ms, v, s.quality, rng_);
+            s.value = v;
+            history_.push_back(v);
+            return s;
+        }
+
+        // QF_SPIKE / QF_STUCK / QF_DROPOUT for the fault windows open at now_ms
+        uint8_t activeFaultFlags(int64_t now_ms) const
+        {
+            if constexpr (Faults::kEnabled)
+                return faults_.activeFlags(now_ms);
+            else
+                return 0;
+        }
+
+        Signal &signal() { return signal_; }
+        Noise &noise() { return noise_; }
+        Faults &faults() { return faults_; }
+
+        // ISensor adapter
+
+        Sample nextSample(int64_t now) override { return sample(now); }
+
+        int rateHz() const override { return spec_.rate_hz; }
+        std::string id() const override { return spec_.id; }
+        std::string type() const override { return spec_.type; }
+        SensorHandle handle() const override { return handle_; }
+
+        // Edits take effect on the next reset()
+        SensorSpec &getSpec() override { return spec_; }
+
+        HistoryView getHistory() const override { return history_.view(); }
+        void recordSample(double value) override { history_.push_back(value); }
+
+        void triggerSpikeFault(double mag, double sigma, int64_t now_ms) override
+        {
+            faults_.triggerSpike(mag, sigma, now_ms);
+        }
+
+        void triggerStuckFault(int64_t duration_ms, int64_t now_ms, double current_value) override
+        {
+            faults_.triggerStuck(duration_ms, now_ms, current_value);
+        }
+
+        void triggerDropoutFault(int64_t now_ms, int64_t duration_ms) override
+        {
+            faults_.triggerDropout(now_ms, duration_ms);
+        }
+
+        std::vector<std::string> getActiveFaults(int64_t now_ms) const override
+        {
+            std::vector<std::string> names;
+            appendFaultNames(activeFaultFlags(now_ms), names);
+            return names;
+        }
+
+    private:
+        SensorSpec spec_;
+        uint64_t seq_ = 0;
+        std::mt19937_64 rng_;
+        Signal signal_;
+        Noise noise_;
+        Faults faults_;
+        RingBuffer<double> history_;
+        SensorHandle handle_;
+    };
+} // namespace sensor
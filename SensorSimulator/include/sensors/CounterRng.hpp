@@ -0,0 +1,79 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace sensor
+{
+    // Philox4x32-10 (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3").
+    // A keyed bijection on 128-bit counters: output depends only on (counter, key),
+    // so any element of a stream can be computed directly and from any thread.
+    struct Philox4x32
+    {
+        using Counter = std::array<uint32_t, 4>;
+        using Key = std::array<uint32_t, 2>;
+
+        static Counter generate(Counter ctr, Key key)
+        {
+            for (int round = 0; round < 10; ++round)
+            {
+                if (round > 0)
+                {
+                    key[0] += 0x9E3779B9u;
+                    key[1] += 0xBB67AE85u;
+                }
+                const uint64_t p0 = uint64_t{0xD2511F53u} * ctr[0];
+                const uint64_t p1 = uint64_t{0xCD9E8D57u} * ctr[2];
+                ctr = {static_cast<uint32_t>(p1 >> 32) ^ ctr[1] ^ key[0], static_cast<uint32_t>(p1),
+                       static_cast<uint32_t>(p0 >> 32) ^ ctr[3] ^ key[1], static_cast<uint32_t>(p0)};
+            }
+            return ctr;
+        }
+    };
+
+    // Random draws addressed by (seed, stream, sequence number, slot).
+    // Each slot yields one double; a Philox block covers two consecutive slots.
+    class CounterRng
+    {
+    public:
+        CounterRng() = default;
+        CounterRng(uint64_t seed, uint32_t stream)
+            : key_{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)}, stream_(stream) {}
+
+        // Uniform in [0, 1) with 53 random bits
+        double uniform(uint64_t seq, uint32_t slot) const
+        {
+            const auto out = Philox4x32::generate(
+                {static_cast<uint32_t>(seq), static_cast<uint32_t>(seq >> 32), slot / 2, stream_}, key_);
+            const std::size_t i = (slot % 2) * 2;
+            const uint64_t bits = (uint64_t{out[i]} << 32) | out[i + 1];
+            return static_cast<double>(bits >> 11) * 0x1.0p-53;
+        }
+
+        // Standard normal from slots `slot` and `slot + 1` (Box-Muller, no cached state)
+        double normal(uint64_t seq, uint32_t slot) const
+        {
+            const double u1 = 1.0 - uniform(seq, slot); // (0, 1]
+            const double u2 = uniform(seq, slot + 1);
+            return std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * M_PI * u2);
+        }
+
+        // Stable 32-bit stream id for a sensor id (FNV-1a folded)
+        static uint32_t streamFor(std::string_view id)
+        {
+            uint64_t h = 0xcbf29ce484222325ULL;
+            for (unsigned char c : id)
+            {
+                h ^= c;
+                h *= 0x100000001b3ULL;
+            }
+            return static_cast<uint32_t>(h ^ (h >> 32));
+        }
+
+    private:
+        Philox4x32::Key key_{};
+        uint32_t stream_ = 0;
+    };
+} // namespace sensor
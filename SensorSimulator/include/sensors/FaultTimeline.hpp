@@ -0,0 +1,143 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "sensors/CounterRng.hpp"
+
+namespace sensor
+{
+    /**
+     * Pre-drawn arrivals of one fault kind as a Poisson process, replacing a Bernoulli
+     * trial per sample. A per-sample probability p at a nominal period T becomes the rate
+     * lambda = -ln(1 - p) / T, so a period contains at least one arrival with probability
+     * exactly p and periods are independent, as with the per-sample trials. T starts at
+     * the spec's rate and follows the actual sample spacing through retime().
+     *
+     * fires(ts) is true when an arrival falls in the sample's own window (ts - T, ts];
+     * arrivals in windows that were never asked about (e.g. the spike stage of a dropped
+     * sample) are discarded rather than carried over. Until the next arrival the check
+     * is a single comparison and no random numbers are drawn.
+     *
+     * Arrival k is derived from CounterRng(seed, stream) at (k, slot), so the whole
+     * timeline can be listed ahead of time (events()) without disturbing it.
+     */
+    class FaultTimeline
+    {
+    public:
+        // Never fires
+        FaultTimeline() = default;
+
+        FaultTimeline(double per_sample_prob, double period_ms, CounterRng rng, uint32_t slot)
+            : rng_(rng), slot_(slot), period_ms_(period_ms > 0.0 ? period_ms : 1000.0)
+        {
+            if (per_sample_prob >= 1.0)
+            {
+                always_ = true;
+                next_ms_ = -std::numeric_limits<double>::infinity();
+            }
+            else if (per_sample_prob > 0.0)
+            {
+                ms_per_event_ = period_ms_ / -std::log1p(-per_sample_prob);
+                next_ms_ = -std::numeric_limits<double>::infinity(); // anchored by the first query
+            }
+        }
+
+        bool fires(int64_t ts_ms)
+        {
+            if (static_cast<double>(ts_ms) < next_ms_)
+                return false;
+            return advance(static_cast<double>(ts_ms));
+        }
+
+        // Anchors the first arrival window at origin_ms; otherwise the first fires(ts)
+        // anchors at ts - period so that sample already has probability p
+        void anchor(int64_t origin_ms)
+        {
+            if (!always_ && ms_per_event_ > 0.0 && !anchored_)
+            {
+                anchored_ = true;
+                next_ms_ = static_cast<double>(origin_ms) + gap(event_);
+            }
+        }
+
+        bool anchored() const { return anchored_; }
+
+        // Switches to a new sample period from the sample at from_ms on. Arrivals are
+        // memoryless, so the pending wait is rescaled and p per sample holds at the new
+        // spacing without redrawing anything.
+        void retime(double period_ms, double from_ms)
+        {
+            if (period_ms <= 0.0 || period_ms == period_ms_)
+                return;
+            const double scale = period_ms / period_ms_;
+            period_ms_ = period_ms;
+            if (always_ || ms_per_event_ <= 0.0)
+                return;
+            ms_per_event_ *= scale;
+            if (anchored_)
+                next_ms_ = from_ms + (next_ms_ - from_ms) * scale;
+        }
+
+        double periodMs() const { return period_ms_; }
+
+        // Time of the next pending arrival (+inf if the fault never fires)
+        double nextEventMs() const { return next_ms_; }
+
+        // Mean arrivals per second
+        double eventsPerSecond() const
+        {
+            if (always_)
+                return std::numeric_limits<double>::infinity();
+            return ms_per_event_ > 0.0 ? 1000.0 / ms_per_event_ : 0.0;
+        }
+
+        // Pending arrival times up to until_ms (requires an anchored timeline)
+        std::vector<double> events(int64_t until_ms) const
+        {
+            std::vector<double> out;
+            if (always_ || !anchored_)
+                return out;
+            uint64_t k = event_;
+            for (double t = next_ms_; t <= static_cast<double>(until_ms); t += gap(++k))
+                out.push_back(t);
+            return out;
+        }
+
+    private:
+        bool advance(double ts)
+        {
+            if (always_)
+                return true;
+            if (!anchored_)
+            {
+                anchored_ = true;
+                next_ms_ = ts - period_ms_ + gap(event_);
+            }
+
+            const double window_start = ts - period_ms_;
+            bool fired = false;
+            while (next_ms_ <= ts)
+            {
+                fired |= next_ms_ > window_start;
+                next_ms_ += gap(++event_);
+            }
+            return fired;
+        }
+
+        // Exponential inter-arrival gap k
+        double gap(uint64_t k) const
+        {
+            return -std::log1p(-rng_.uniform(k, slot_)) * ms_per_event_;
+        }
+
+        CounterRng rng_;
+        uint32_t slot_ = 0;
+        double period_ms_ = 1000.0;
+        double ms_per_event_ = 0.0; // 1 / lambda
+        double next_ms_ = std::numeric_limits<double>::infinity();
+        uint64_t event_ = 0;
+        bool anchored_ = false;
+        bool always_ = false;
+    };
+} // namespace sensor
@@ -3,10 +3,19 @@
 #include <string>
 #include "../sensors/Sample.hpp"
 #include "../sensors/Spec.hpp"
-#include <deque>
+#include "../sensors/SampleBatch.hpp"
+#include "../sensors/RingBuffer.hpp"
+#include <span>
+#include <vector>
 
 namespace sensor
 {
+    // Recent recorded values, oldest first (see ISensor::getHistory)
+    using HistoryView = RingView<double>;
+
+    // Default number of recent values a sensor keeps for plotting
+    static constexpr size_t kMaxPlotSamples = 100;
+
     // Polymorphic base class for all sensors
     class ISensor
     {
@@ -19,14 +28,43 @@ namespace sensor
         // Produce the next sample for the given time (ms or ns). Pure w.r.t. internal state + now.
         virtual Sample nextSample(int64_t now) = 0;
 
+        // Produce `count` samples at start_ms, start_ms + period_ms, ... into SoA buffers.
+        // Equivalent to calling nextSample() for each timestamp in order; returns the number
+        // of samples written (bounded by out.capacity()). Sensors override this to skip the
+        // per-sample Sample construction.
+        virtual std::size_t generateBatch(int64_t start_ms, int64_t period_ms, std::size_t count, SampleBatchView out)
+        {
+            count = std::min(count, out.capacity());
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const Sample s = nextSample(start_ms + static_cast<int64_t>(i) * period_ms);
+                out.timestamps[i] = s.ts;
+                out.values[i] = s.value;
+                out.quality[i] = s.quality;
+            }
+            return count;
+        }
+
+        // Values per sample; > 1 for multi-channel sensors such as a 3-axis IMU
+        virtual std::size_t channelCount() const { return 1; }
+
+        // Every channel of the last nextSample() (Sample::value is channel 0).
+        // Empty for single-channel sensors; valid until the next nextSample().
+        virtual std::span<const double> channelValues() const { return {}; }
+
         // Nominal rate in Hertz (for schedulers)
         virtual int rateHz() const = 0;
 
         // Stable identity and logical type
         virtual std::string id() const = 0;   // e.g., "TEMP-01"
         virtual std::string type() const = 0; // e.g., "TEMP", "PRES", "IMU-AXIS"
+
+        // Interned id() stamped on every Sample; override to cache it
+        virtual SensorHandle handle() const { return internSensorId(id()); }
+
         virtual SensorSpec &getSpec() = 0;
-        virtual const std::deque<double> &getHistory() const = 0;
+        // Non-owning view of the recent values; valid until the next recorded sample
+        virtual HistoryView getHistory() const = 0;
         virtual void recordSample(double value) = 0;
         virtual void triggerSpikeFault(double mag, double sigma, int64_t now_ms) = 0;
         virtual void triggerStuckFault(int64_t duration_ms, int64_t now_ms, double current_value) = 0;
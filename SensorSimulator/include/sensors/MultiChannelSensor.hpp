@@ -0,0 +1,227 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include "sensors/SimpleSensor.hpp"
+#include "sensors/Waveform.hpp"
+
+namespace sensor
+{
+    /**
+     * A sensor that produces N values per instant (e.g. the x/y/z axes of an IMU) from
+     * one nextSample() call, so a 3-axis device is one scheduler entry, one log row and
+     * one channel message instead of three.
+     *
+     * Each channel follows its ChannelSpec (level + sine); spec.noise is added to every
+     * channel independently. Faults act on the device as a whole: a spike perturbs all
+     * channels, a stuck fault freezes all of them and a dropout blanks them. Random faults
+     * use spec.fault.dropout_prob and spike_prob; random stuck faults are not modelled.
+     */
+    class MultiChannelSensor : public ISensor
+    {
+    public:
+        // @throws std::invalid_argument unless spec.channels holds 1..kMaxChannels channels
+        explicit MultiChannelSensor(const SensorSpec &spec)
+            : spec_(spec),
+              history_(kMaxPlotSamples),
+              handle_(internSensorId(spec_.id))
+        {
+            if (spec_.channels.empty() || spec_.channels.size() > kMaxChannels)
+                throw std::invalid_argument("MultiChannelSensor needs 1 to " + std::to_string(kMaxChannels) + " channels");
+            values_.fill(0.0);
+            reset(0);
+        }
+
+        void reset(uint64_t seed) override
+        {
+            seq_ = 0;
+            rng_.seed(seed);
+            handle_ = internSensorId(spec_.id);
+            count_ = std::min(spec_.channels.size(), kMaxChannels);
+            for (std::size_t c = 0; c < count_; ++c)
+            {
+                const ChannelSpec &ch = spec_.channels[c];
+                waves_[c] = Waveform::sine(ch.base_level, ch.sine_amp, ch.sine_freq_hz, ch.phase_rad);
+            }
+            gaussian_ = std::normal_distribution<double>(0.0, spec_.noise.gaussian_sigma);
+            uniform_ = std::uniform_real_distribution<double>(-spec_.noise.uniform_range, spec_.noise.uniform_range);
+            dropout_ = std::bernoulli_distribution(std::clamp(spec_.fault.dropout_prob, 0.0, 1.0));
+            spike_ = std::bernoulli_distribution(std::clamp(spec_.fault.spike_prob, 0.0, 1.0));
+            active_spike_ = {};
+            active_stuck_ = {};
+            active_dropout_ = {};
+        }
+
+        Sample nextSample(int64_t now_ms) override
+        {
+            Sample s{};
+            s.ts = now_ms;
+            s.seq = ++seq_;
+            s.sensor = handle_;
+            s.quality = QF_OK;
+
+            if ((active_dropout_.active && now_ms >= active_dropout_.start_time_ms && now_ms <= active_dropout_.end_time_ms) ||
+                dropout_(rng_))
+            {
+                s.quality |= QF_DROPOUT;
+                values_.fill(std::numeric_limits<double>::quiet_NaN());
+                s.value = values_[0];
+                return s;
+            }
+
+            if (active_stuck_.active && now_ms <= active_stuck_.end_time_ms)
+            {
+                s.quality |= QF_STUCK;
+                values_ = frozen_;
+                s.value = values_[0];
+                recordSample(s.value);
+                return s;
+            }
+            active_stuck_.active = false;
+
+            for (std::size_t c = 0; c < count_; ++c)
+            {
+                double v = waves_[c].at(now_ms);
+                if (spec_.noise.gaussian_sigma > 0.0)
+                    v += gaussian_(rng_);
+                if (spec_.noise.uniform_range > 0.0)
+                    v += uniform_(rng_);
+                values_[c] = v;
+            }
+            applySpike(s);
+
+            frozen_ = values_;
+            s.value = values_[0];
+            recordSample(s.value);
+            return s;
+        }
+
+        std::size_t channelCount() const override { return count_; }
+
+        std::span<const double> channelValues() const override
+        {
+            return std::span<const double>(values_.data(), count_);
+        }
+
+        const std::string &channelName(std::size_t channel) const { return spec_.channels.at(channel).name; }
+
+        int rateHz() const override
+        {
+            return spec_.rate_hz;
+        }
+
+        std::string id() const override
+        {
+            return spec_.id;
+        }
+
+        std::string type() const override
+        {
+            return spec_.type;
+        }
+
+        SensorHandle handle() const override
+        {
+            return handle_;
+        }
+
+        // Edits to spec.channels take effect on the next reset()
+        SensorSpec &getSpec() override
+        {
+            return spec_;
+        }
+
+        // Channel 0 only
+        HistoryView getHistory() const override
+        {
+            return history_.view();
+        }
+
+        void recordSample(double value) override
+        {
+            history_.push_back(value);
+        }
+
+        void triggerSpikeFault(double mag, double sigma, int64_t now_ms) override
+        {
+            active_spike_.mag = mag;
+            active_spike_.sigma = sigma;
+            active_spike_.start_time_ms = now_ms;
+            active_spike_.end_time_ms = now_ms + static_cast<int64_t>(50.0 * sigma * 1000);
+            active_spike_.active = true;
+        }
+
+        // Freezes every channel at its last value; `current_value` is ignored
+        void triggerStuckFault(int64_t duration_ms, int64_t now_ms, double /*current_value*/) override
+        {
+            active_stuck_.start_time_ms = now_ms;
+            active_stuck_.end_time_ms = now_ms + duration_ms;
+            active_stuck_.active = true;
+        }
+
+        void triggerDropoutFault(int64_t now_ms, int64_t duration_ms) override
+        {
+            active_dropout_.start_time_ms = now_ms;
+            active_dropout_.end_time_ms = now_ms + duration_ms;
+            active_dropout_.active = true;
+        }
+
+        std::vector<std::string> getActiveFaults(int64_t now_ms) const override
+        {
+            std::vector<std::string> active_faults;
+            if (active_spike_.active && now_ms <= active_spike_.end_time_ms)
+                active_faults.push_back("spike");
+            if (active_stuck_.active && now_ms <= active_stuck_.end_time_ms)
+                active_faults.push_back("stuck");
+            if (active_dropout_.active && now_ms <= active_dropout_.end_time_ms)
+                active_faults.push_back("dropout");
+            return active_faults;
+        }
+
+    private:
+        void applySpike(Sample &s)
+        {
+            double mag = spec_.fault.spike_mag;
+            double sigma = spec_.fault.spike_sigma;
+            if (active_spike_.active && s.ts >= active_spike_.start_time_ms && s.ts <= active_spike_.end_time_ms)
+            {
+                mag = active_spike_.mag;
+                sigma = active_spike_.sigma;
+            }
+            else
+            {
+                if (active_spike_.active && s.ts > active_spike_.end_time_ms)
+                    active_spike_.active = false;
+                if (!spike_(rng_))
+                    return;
+            }
+
+            s.quality |= QF_SPIKE;
+            std::normal_distribution<double> gauss(0.0, sigma > 0.0 ? sigma : 1.0);
+            std::uniform_real_distribution<double> unit(-1.0, 1.0);
+            for (std::size_t c = 0; c < count_; ++c)
+                values_[c] += sigma > 0.0 ? gauss(rng_) : mag * unit(rng_);
+        }
+
+        SensorSpec spec_;
+        RingBuffer<double> history_;
+        SensorHandle handle_;
+        std::size_t count_ = 0;
+        uint64_t seq_ = 0;
+
+        std::array<Waveform, kMaxChannels> waves_; // per-channel level + sine, rebuilt by reset()
+        std::array<double, kMaxChannels> values_;
+        std::array<double, kMaxChannels> frozen_{}; // last good values, replayed while stuck
+
+        std::mt19937_64 rng_;
+        std::normal_distribution<double> gaussian_;
+        std::uniform_real_distribution<double> uniform_;
+        std::bernoulli_distribution dropout_;
+        std::bernoulli_distribution spike_;
+
+        SpikeFaultInstance active_spike_;
+        StuckFaultInstance active_stuck_;
+        DropoutFaultInstance active_dropout_;
+    };
+} // namespace sensor
@@ -0,0 +1,179 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace sensor
+{
+    /**
+     * Streaming estimate of one quantile with the P² algorithm (Jain & Chlamtac, 1985):
+     * five markers whose heights are adjusted by piecewise-parabolic interpolation as
+     * values arrive. O(1) time and memory per value, no stored samples; exact for the
+     * first five values and typically within a fraction of a percent of rank after that.
+     */
+    class P2Quantile
+    {
+    public:
+        explicit P2Quantile(double p = 0.5) : p_(p) {}
+
+        void add(double x)
+        {
+            if (count_ < 5)
+            {
+                q_[count_++] = x;
+                std::sort(q_.begin(), q_.begin() + count_);
+                if (count_ == 5)
+                {
+                    n_ = {0, 1, 2, 3, 4};
+                    np_ = {0.0, 2.0 * p_, 4.0 * p_, 2.0 + 2.0 * p_, 4.0};
+                }
+                return;
+            }
+            ++count_;
+
+            std::size_t k;
+            if (x < q_[0])
+            {
+                q_[0] = x;
+                k = 0;
+            }
+            else if (x >= q_[4])
+            {
+                q_[4] = x;
+                k = 3;
+            }
+            else
+            {
+                k = 0;
+                while (x >= q_[k + 1])
+                    ++k;
+            }
+
+            for (std::size_t i = k + 1; i < 5; ++i)
+                ++n_[i];
+            const std::array<double, 5> dn = {0.0, p_ / 2.0, p_, (1.0 + p_) / 2.0, 1.0};
+            for (std::size_t i = 0; i < 5; ++i)
+                np_[i] += dn[i];
+
+            for (std::size_t i = 1; i < 4; ++i)
+            {
+                const double d = np_[i] - static_cast<double>(n_[i]);
+                if ((d >= 1.0 && n_[i + 1] - n_[i] > 1) || (d <= -1.0 && n_[i - 1] - n_[i] < -1))
+                {
+                    const int step = d > 0.0 ? 1 : -1;
+                    const double qp = parabolic(i, step);
+                    q_[i] = q_[i - 1] < qp && qp < q_[i + 1] ? qp : linear(i, step);
+                    n_[i] += step;
+                }
+            }
+        }
+
+        // NaN until the first value
+        double value() const
+        {
+            if (count_ == 0)
+                return std::numeric_limits<double>::quiet_NaN();
+            if (count_ < 5)
+            {
+                const auto rank = static_cast<std::size_t>(std::lround(p_ * static_cast<double>(count_ - 1)));
+                return q_[rank];
+            }
+            return q_[2];
+        }
+
+        double p() const { return p_; }
+
+    private:
+        double parabolic(std::size_t i, int d) const
+        {
+            const double n0 = n_[i - 1], n1 = n_[i], n2 = n_[i + 1];
+            return q_[i] + d / (n2 - n0) *
+                               ((n1 - n0 + d) * (q_[i + 1] - q_[i]) / (n2 - n1) +
+                                (n2 - n1 - d) * (q_[i] - q_[i - 1]) / (n1 - n0));
+        }
+
+        double linear(std::size_t i, int d) const
+        {
+            return q_[i] + d * (q_[i + d] - q_[i]) / static_cast<double>(n_[i + d] - n_[i]);
+        }
+
+        double p_;
+        uint64_t count_ = 0;
+        std::array<double, 5> q_{};   // marker heights
+        std::array<int64_t, 5> n_{};  // marker positions
+        std::array<double, 5> np_{};  // desired positions
+    };
+
+    /**
+     * Running summary of a sensor's output, updated in O(1) per sample: count, Welford
+     * mean / variance, min / max, an exponentially weighted mean that tracks the recent
+     * level, and P² estimates of the median, p95 and p99. NaN values (dropouts) are
+     * counted as missing and otherwise ignored.
+     */
+    class OnlineStats
+    {
+    public:
+        explicit OnlineStats(double ewma_alpha = 0.1) : alpha_(ewma_alpha) {}
+
+        void add(double value, bool faulted = false)
+        {
+            faulted_ += faulted;
+            if (std::isnan(value))
+            {
+                ++missing_;
+                return;
+            }
+
+            ++count_;
+            last_ = value;
+            const double delta = value - mean_;
+            mean_ += delta / static_cast<double>(count_);
+            m2_ += delta * (value - mean_);
+            min_ = std::min(min_, value);
+            max_ = std::max(max_, value);
+            ewma_ = count_ == 1 ? value : ewma_ + alpha_ * (value - ewma_);
+            p50_.add(value);
+            p95_.add(value);
+            p99_.add(value);
+        }
+
+        void reset() { *this = OnlineStats(alpha_); }
+
+        uint64_t count() const { return count_; }     // valid values
+        uint64_t missing() const { return missing_; } // NaN values (dropouts)
+        uint64_t faulted() const { return faulted_; } // samples that carried a fault flag
+
+        double mean() const { return count_ ? mean_ : nan(); }
+        // Sample variance (n - 1); 0 for a single value
+        double variance() const { return count_ > 1 ? m2_ / static_cast<double>(count_ - 1) : count_ ? 0.0 : nan(); }
+        double stddev() const { return std::sqrt(variance()); }
+        double min() const { return count_ ? min_ : nan(); }
+        double max() const { return count_ ? max_ : nan(); }
+        double last() const { return count_ ? last_ : nan(); }
+        double ewma() const { return count_ ? ewma_ : nan(); }
+        double ewmaAlpha() const { return alpha_; }
+
+        double p50() const { return p50_.value(); }
+        double p95() const { return p95_.value(); }
+        double p99() const { return p99_.value(); }
+
+    private:
+        static double nan() { return std::numeric_limits<double>::quiet_NaN(); }
+
+        double alpha_;
+        uint64_t count_ = 0;
+        uint64_t missing_ = 0;
+        uint64_t faulted_ = 0;
+        double mean_ = 0.0;
+        double m2_ = 0.0;
+        double min_ = std::numeric_limits<double>::infinity();
+        double max_ = -std::numeric_limits<double>::infinity();
+        double last_ = 0.0;
+        double ewma_ = 0.0;
+        P2Quantile p50_{0.5};
+        P2Quantile p95_{0.95};
+        P2Quantile p99_{0.99};
+    };
+} // namespace sensor
@@ -0,0 +1,255 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+#include "sensors/ISensor.hpp"
+
+namespace sensor
+{
+    // One recorded reading: time, value and QF_* flags
+    struct RecordedSample
+    {
+        int64_t ts_ms;
+        double value;
+        uint8_t quality = QF_OK;
+    };
+
+    // Fault names as reported by getActiveFaults() <-> QF_* bits
+    inline uint8_t qualityFromFaults(const std::vector<std::string> &faults)
+    {
+        uint8_t quality = QF_OK;
+        for (const auto &fault : faults)
+        {
+            if (fault == "spike")
+                quality |= QF_SPIKE;
+            else if (fault == "stuck")
+                quality |= QF_STUCK;
+            else if (fault == "dropout")
+                quality |= QF_DROPOUT;
+        }
+        return quality;
+    }
+
+    inline std::vector<std::string> faultsFromQuality(uint8_t quality)
+    {
+        std::vector<std::string> faults;
+        if (quality & QF_SPIKE)
+            faults.push_back("spike");
+        if (quality & QF_STUCK)
+            faults.push_back("stuck");
+        if (quality & QF_DROPOUT)
+            faults.push_back("dropout");
+        return faults;
+    }
+
+    // Median spacing of a recording, used as its scheduling period (1000 ms if unknown)
+    inline uint64_t nominalPeriodMs(const std::vector<RecordedSample> &samples)
+    {
+        std::vector<int64_t> gaps;
+        gaps.reserve(samples.size());
+        for (std::size_t i = 1; i < samples.size(); ++i)
+        {
+            if (samples[i].ts_ms > samples[i - 1].ts_ms)
+                gaps.push_back(samples[i].ts_ms - samples[i - 1].ts_ms);
+        }
+        if (gaps.empty())
+            return 1000;
+        std::nth_element(gaps.begin(), gaps.begin() + gaps.size() / 2, gaps.end());
+        return static_cast<uint64_t>(gaps[gaps.size() / 2]);
+    }
+
+    /**
+     * Plays back a recorded stream (MiniDB log or binary capture, see scheduler/ReplayCapture.hpp)
+     * through the ISensor interface, so it can be scheduled like a simulated sensor.
+     *
+     * The recording is anchored to the time of the first nextSample() call after reset()
+     * or seek(); from then on recording time advances `playback speed` times as fast as
+     * the caller's clock. Each call returns the latest recorded sample at or before the
+     * mapped time (sample-and-hold), with its recorded faults. Before the first recorded
+     * sample the reading is a NaN dropout; past the end the last sample is held and
+     * finished() turns true. No randomness is involved, so replays are bit-identical.
+     */
+    class ReplaySensor : public ISensor
+    {
+    public:
+        // `samples` must be sorted by timestamp
+        ReplaySensor(const SensorSpec &spec, std::vector<RecordedSample> samples)
+            : spec_(spec),
+              samples_(std::move(samples)),
+              history_(kMaxPlotSamples),
+              handle_(internSensorId(spec_.id))
+        {
+            rewind();
+        }
+
+        // Rewinds to the start of the recording, keeping the playback speed; the seed is unused
+        void reset(uint64_t /*seed*/) override
+        {
+            handle_ = internSensorId(spec_.id);
+            history_.clear();
+            rewind();
+        }
+
+        Sample nextSample(int64_t now_ms) override
+        {
+            if (!anchored_)
+            {
+                anchor_now_ms_ = now_ms;
+                anchored_ = true;
+            }
+            last_now_ms_ = now_ms;
+            const double elapsed = static_cast<double>(now_ms - anchor_now_ms_) * speed_;
+            position_ms_ = anchor_rec_ms_ + static_cast<int64_t>(std::floor(elapsed));
+            locate(position_ms_);
+
+            Sample s{};
+            s.ts = now_ms;
+            s.seq = ++seq_;
+            s.sensor = handle_;
+            if (cursor_ == 0)
+            {
+                s.value = std::numeric_limits<double>::quiet_NaN();
+                s.quality = QF_DROPOUT;
+                current_quality_ = QF_DROPOUT;
+                return s;
+            }
+
+            const RecordedSample &rec = samples_[cursor_ - 1];
+            s.value = rec.value;
+            s.quality = rec.quality;
+            current_quality_ = rec.quality;
+            if (!(rec.quality & QF_DROPOUT))
+                recordSample(rec.value);
+            return s;
+        }
+
+        // Positions playback at recording time `ts_ms`; the next nextSample() call plays it
+        void seek(int64_t ts_ms)
+        {
+            anchor_rec_ms_ = ts_ms;
+            anchored_ = false;
+        }
+
+        // Recording milliseconds per caller millisecond (e.g. 10 plays ten times faster).
+        // Takes effect from the current position; non-positive values are ignored.
+        void setPlaybackSpeed(double speed)
+        {
+            if (!(speed > 0.0))
+                return;
+            if (anchored_)
+            {
+                anchor_rec_ms_ = position_ms_;
+                anchor_now_ms_ = last_now_ms_;
+            }
+            speed_ = speed;
+        }
+
+        double playbackSpeed() const { return speed_; }
+
+        // Recording time of the last nextSample() call
+        int64_t position() const { return position_ms_; }
+
+        int64_t startTime() const { return samples_.empty() ? 0 : samples_.front().ts_ms; }
+        int64_t endTime() const { return samples_.empty() ? 0 : samples_.back().ts_ms; }
+
+        // Number of recorded samples at or before position()
+        std::size_t played() const { return cursor_; }
+
+        bool finished() const { return cursor_ == samples_.size(); }
+
+        const std::vector<RecordedSample> &recording() const { return samples_; }
+
+        int rateHz() const override
+        {
+            return spec_.rate_hz;
+        }
+
+        std::string id() const override
+        {
+            return spec_.id;
+        }
+
+        std::string type() const override
+        {
+            return spec_.type;
+        }
+
+        SensorHandle handle() const override
+        {
+            return handle_;
+        }
+
+        SensorSpec &getSpec() override
+        {
+            return spec_;
+        }
+
+        HistoryView getHistory() const override
+        {
+            return history_.view();
+        }
+
+        void recordSample(double value) override
+        {
+            history_.push_back(value);
+        }
+
+        // A recording already carries the faults that happened; injection is ignored
+        void triggerSpikeFault(double, double, int64_t) override {}
+        void triggerStuckFault(int64_t, int64_t, double) override {}
+        void triggerDropoutFault(int64_t, int64_t) override {}
+
+        // Faults recorded with the sample returned by the last nextSample() call
+        std::vector<std::string> getActiveFaults(int64_t /*now_ms*/) const override
+        {
+            return faultsFromQuality(current_quality_);
+        }
+
+    private:
+        void rewind()
+        {
+            seq_ = 0;
+            cursor_ = 0;
+            anchored_ = false;
+            anchor_rec_ms_ = startTime();
+            position_ms_ = anchor_rec_ms_;
+            current_quality_ = QF_OK;
+        }
+
+        // Moves cursor_ to one past the last sample with ts_ms <= t. Forward playback walks
+        // (amortised O(1) per call); a backward seek falls back to a binary search.
+        void locate(int64_t t)
+        {
+            if (cursor_ > 0 && samples_[cursor_ - 1].ts_ms > t)
+            {
+                cursor_ = static_cast<std::size_t>(
+                    std::upper_bound(samples_.begin(), samples_.end(), t,
+                                     [](int64_t ts, const RecordedSample &r)
+                                     { return ts < r.ts_ms; }) -
+                    samples_.begin());
+                return;
+            }
+            while (cursor_ < samples_.size() && samples_[cursor_].ts_ms <= t)
+                ++cursor_;
+        }
+
+        SensorSpec spec_;
+        std::vector<RecordedSample> samples_;
+        RingBuffer<double> history_;
+        SensorHandle handle_;
+
+        uint64_t seq_ = 0;
+        std::size_t cursor_ = 0; // samples_[0, cursor_) are at or before position_ms_
+        double speed_ = 1.0;
+        bool anchored_ = false;
+        int64_t anchor_now_ms_ = 0;
+        int64_t last_now_ms_ = 0;
+        int64_t anchor_rec_ms_ = 0;
+        int64_t position_ms_ = 0;
+        uint8_t current_quality_ = QF_OK;
+    };
+} // namespace sensor
@@ -0,0 +1,142 @@
+#pragma once
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <vector>
+
+namespace sensor
+{
+    // Read-only view of a RingBuffer's contents, oldest first. The elements are the
+    // concatenation of two contiguous spans, so iterating or copying them touches at
+    // most two linear memory ranges. Iterators point into the buffer itself, not into the
+    // view, so they outlive a temporary view; both are invalidated by the next push.
+    template <typename T>
+    class RingView
+    {
+    public:
+        class const_iterator
+        {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T *;
+            using reference = const T &;
+
+            const_iterator() = default;
+            const_iterator(std::span<const T> first, std::span<const T> second, std::size_t pos)
+                : first_(first), second_(second), pos_(pos) {}
+
+            reference operator*() const { return at(pos_); }
+            reference operator[](difference_type n) const { return at(pos_ + n); }
+            const_iterator &operator++() { ++pos_; return *this; }
+            const_iterator operator++(int) { auto tmp = *this; ++pos_; return tmp; }
+            const_iterator &operator--() { --pos_; return *this; }
+            const_iterator operator--(int) { auto tmp = *this; --pos_; return tmp; }
+            const_iterator &operator+=(difference_type n) { pos_ += n; return *this; }
+            const_iterator &operator-=(difference_type n) { pos_ -= n; return *this; }
+            friend const_iterator operator+(const_iterator it, difference_type n) { return it += n; }
+            friend const_iterator operator+(difference_type n, const_iterator it) { return it += n; }
+            friend const_iterator operator-(const_iterator it, difference_type n) { return it -= n; }
+            friend difference_type operator-(const const_iterator &a, const const_iterator &b)
+            {
+                return static_cast<difference_type>(a.pos_) - static_cast<difference_type>(b.pos_);
+            }
+            friend bool operator==(const const_iterator &a, const const_iterator &b) { return a.pos_ == b.pos_; }
+            friend auto operator<=>(const const_iterator &a, const const_iterator &b) { return a.pos_ <=> b.pos_; }
+
+        private:
+            reference at(std::size_t i) const
+            {
+                return i < first_.size() ? first_[i] : second_[i - first_.size()];
+            }
+
+            std::span<const T> first_;
+            std::span<const T> second_;
+            std::size_t pos_ = 0;
+        };
+
+        RingView() = default;
+        RingView(std::span<const T> older, std::span<const T> newer) : first_(older), second_(newer) {}
+
+        std::size_t size() const { return first_.size() + second_.size(); }
+        bool empty() const { return size() == 0; }
+
+        const T &operator[](std::size_t i) const
+        {
+            return i < first_.size() ? first_[i] : second_[i - first_.size()];
+        }
+        const T &front() const { return (*this)[0]; }
+        const T &back() const { return (*this)[size() - 1]; }
+
+        // The two contiguous segments, oldest first
+        std::span<const T> first() const { return first_; }
+        std::span<const T> second() const { return second_; }
+
+        const_iterator begin() const { return const_iterator(first_, second_, 0); }
+        const_iterator end() const { return const_iterator(first_, second_, size()); }
+
+    private:
+        std::span<const T> first_;
+        std::span<const T> second_;
+    };
+
+    // Fixed-capacity circular buffer that overwrites its oldest element when full.
+    // Storage is allocated once, on construction or setCapacity(); push_back never allocates.
+    template <typename T>
+    class RingBuffer
+    {
+    public:
+        explicit RingBuffer(std::size_t capacity = 0) : storage_(capacity) {}
+
+        std::size_t capacity() const { return storage_.size(); }
+        std::size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+
+        void push_back(const T &value)
+        {
+            if (storage_.empty())
+                return;
+            storage_[head_] = value;
+            head_ = head_ + 1 == storage_.size() ? 0 : head_ + 1;
+            if (size_ < storage_.size())
+                ++size_;
+        }
+
+        void clear()
+        {
+            head_ = 0;
+            size_ = 0;
+        }
+
+        // Reallocates, keeping the newest min(size(), capacity) elements
+        void setCapacity(std::size_t capacity)
+        {
+            if (capacity == storage_.size())
+                return;
+            const RingView<T> current = view();
+            const std::size_t keep = std::min(current.size(), capacity);
+            std::vector<T> next(capacity);
+            for (std::size_t i = 0; i < keep; ++i)
+                next[i] = current[current.size() - keep + i];
+            storage_ = std::move(next);
+            size_ = keep;
+            head_ = capacity == 0 || keep == capacity ? 0 : keep;
+        }
+
+        RingView<T> view() const
+        {
+            const std::span<const T> all(storage_);
+            const std::size_t start = size_ < storage_.size() ? 0 : head_;
+            const std::size_t firstLen = std::min(size_, storage_.size() - start);
+            return RingView<T>(all.subspan(start, firstLen), all.subspan(0, size_ - firstLen));
+        }
+
+    private:
+        std::vector<T> storage_;
+        std::size_t head_ = 0; // next write position
+        std::size_t size_ = 0;
+    };
+} // namespace sensor
@@ -1,6 +1,9 @@
 #pragma once
+#include <cstddef>
 #include <cstdint>
 #include <string>
+#include <vector>
+#include "sensors/SensorHandle.hpp"
 
 namespace sensor
 {
@@ -9,8 +12,7 @@ namespace sensor
     {
         int64_t ts;       // timestamp (e.g., ns or ms since epoch)
         uint64_t seq;     // per-sensor monotonically increasing counter
-        std::string id;   // sensor unique id (e.g., "TEMP-01")
-        std::string type; // e.g., "TEMP", "PRES", "IMU-AXIS"
+        SensorHandle sensor; // interned sensor id (e.g., "TEMP-01"); see sensorName()
         double value;     // numeric reading
         uint8_t quality;  // bitmask flags (bit0: ok, bit1: clipped, bit2: dropout, ...)
     };
@@ -19,6 +21,29 @@ namespace sensor
     constexpr uint8_t QF_DROPOUT = 0x01; // missing sample
     constexpr uint8_t QF_SPIKE = 0x02;   // outlier
     constexpr uint8_t QF_STUCK = 0x04;   // sensor stuck/frozen
-    constexpr uint8_t QF_NOISY = 0x08;   // excessive noise detected
+    constexpr uint8_t QF_NOISY = 0x08;   // excessive noise detected (AnomalyDetector z-score)
+    constexpr uint8_t QF_FLATLINE = 0x10; // value unchanged for too long (AnomalyDetector)
+    constexpr uint8_t QF_RATE = 0x20;     // rate of change above limit (AnomalyDetector)
+
+    // Quality flags as fault names: injected faults in getActiveFaults() order ("spike",
+    // "stuck", "dropout"), then detector findings ("noisy", "flatline", "rate")
+    inline void appendFaultNames(uint8_t flags, std::vector<std::string> &out)
+    {
+        if (flags & QF_SPIKE)
+            out.emplace_back("spike");
+        if (flags & QF_STUCK)
+            out.emplace_back("stuck");
+        if (flags & QF_DROPOUT)
+            out.emplace_back("dropout");
+        if (flags & QF_NOISY)
+            out.emplace_back("noisy");
+        if (flags & QF_FLATLINE)
+            out.emplace_back("flatline");
+        if (flags & QF_RATE)
+            out.emplace_back("rate");
+    }
+
+    // Upper bound on values per sample of a multi-channel sensor
+    constexpr std::size_t kMaxChannels = 8;
 
 } // namespace sensor
\ No newline at end of file
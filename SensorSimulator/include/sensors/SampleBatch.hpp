@@ -0,0 +1,43 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace sensor
+{
+    // Structure-of-arrays output for ISensor::generateBatch.
+    // Element i of every span describes the same sample.
+    struct SampleBatchView
+    {
+        std::span<int64_t> timestamps;
+        std::span<double> values;
+        std::span<uint8_t> quality; // QF_* bitmask per sample
+
+        // Number of samples all three spans can hold
+        std::size_t capacity() const
+        {
+            return std::min({timestamps.size(), values.size(), quality.size()});
+        }
+    };
+
+    // Owning SoA buffer; reuse one across calls to avoid reallocations.
+    struct SampleBatch
+    {
+        std::vector<int64_t> timestamps;
+        std::vector<double> values;
+        std::vector<uint8_t> quality;
+
+        void resize(std::size_t n)
+        {
+            timestamps.resize(n);
+            values.resize(n);
+            quality.resize(n);
+        }
+
+        std::size_t size() const { return timestamps.size(); }
+
+        SampleBatchView view() { return SampleBatchView{timestamps, values, quality}; }
+    };
+} // namespace sensor
@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace sensor
+{
+    // Compact interned sensor id carried by Sample instead of the id string.
+    // Resolve it with sensorName() only where text is needed (JSON, shell output).
+    using SensorHandle = uint32_t;
+    constexpr SensorHandle kInvalidSensorHandle = 0;
+
+    // Process-wide id <-> handle table. Handles are never reused, and names stay at a
+    // stable address, so sensorName() references remain valid for the process lifetime.
+    class SensorRegistry
+    {
+    public:
+        static SensorRegistry &instance()
+        {
+            static SensorRegistry registry;
+            return registry;
+        }
+
+        SensorHandle intern(std::string_view id)
+        {
+            {
+                std::shared_lock<std::shared_mutex> lock(mtx_);
+                auto it = index_.find(id);
+                if (it != index_.end())
+                    return it->second;
+            }
+
+            std::unique_lock<std::shared_mutex> lock(mtx_);
+            auto it = index_.find(id);
+            if (it != index_.end())
+                return it->second;
+
+            names_.emplace_back(id);
+            const auto handle = static_cast<SensorHandle>(names_.size()); // 0 stays invalid
+            index_.emplace(names_.back(), handle);
+            return handle;
+        }
+
+        const std::string &name(SensorHandle handle) const
+        {
+            static const std::string kUnknown;
+            std::shared_lock<std::shared_mutex> lock(mtx_);
+            if (handle == kInvalidSensorHandle || handle > names_.size())
+                return kUnknown;
+            return names_[handle - 1];
+        }
+
+    private:
+        SensorRegistry() = default;
+
+        mutable std::shared_mutex mtx_;
+        std::deque<std::string> names_; // handle - 1 -> id
+        std::unordered_map<std::string_view, SensorHandle> index_; // views into names_
+    };
+
+    inline SensorHandle internSensorId(std::string_view id)
+    {
+        return SensorRegistry::instance().intern(id);
+    }
+
+    inline const std::string &sensorName(SensorHandle handle)
+    {
+        return SensorRegistry::instance().name(handle);
+    }
+} // namespace sensor
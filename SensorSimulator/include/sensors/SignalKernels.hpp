@@ -0,0 +1,160 @@
+#pragma once
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+// Block kernels for bulk signal synthesis (see SimpleSensor::BatchSynthesis::Vectorized).
+//
+// Random numbers are drawn from the sensor's own engine in a separate scalar pass
+// (fillUniform), so results are deterministic for a given seed. The math loops that
+// follow are written for the auto-vectorizer: no branches (selects on integer bits
+// compile to blends), no libm calls other than sqrt, and integer-to-double conversions
+// only from 32-bit values. Transcendentals use polynomial approximations accurate to
+// ~1e-11 relative, far below any configured noise level.
+//
+// GCC and Clang vectorize the math loops at -O3 (the Release configuration), with SSE2
+// or wider. sqrt only becomes one vector instruction when it does not have to set errno,
+// so sensor_core builds with -fno-math-errno (see SensorSimulator/CMakeLists.txt).
+// bench_sensors measures the effect.
+namespace sensor::kernels
+{
+    constexpr std::size_t kBlockSize = 256;
+    constexpr double kTwoPi = 6.283185307179586476925286766559;
+    constexpr double kHalfPi = 1.5707963267948966192313216916398;
+    constexpr double kPi = 3.1415926535897932384626433832795;
+
+    // Round-to-nearest without calling nearbyint(); valid for |x| < 2^51.
+    inline double roundNearest(double x)
+    {
+        constexpr double kMagic = 6755399441055744.0; // 1.5 * 2^52
+        return (x + kMagic) - kMagic;
+    }
+
+    // Selects below are made on integer bits only: a floating-point compare may raise an
+    // FP exception, so GCC does not if-convert it under the default -ftrapping-math.
+
+    // sin(2*pi*x) for any x in turns (cycles), |x| < 2^49
+    inline double sinTurns(double x)
+    {
+        // Nearest quarter turn k and the remainder f in [-pi/4, pi/4]; 1.5 * 2^52 + 4x
+        // holds k in its low mantissa bits (two's complement), so k mod 4 is integer work
+        constexpr double kMagic = 6755399441055744.0;
+        const double shifted = 4.0 * x + kMagic;
+        const uint64_t quadrant = std::bit_cast<uint64_t>(shifted);
+        const double f = (4.0 * x - (shifted - kMagic)) * kHalfPi;
+        const double f2 = f * f;
+
+        // Taylor series; error < 1e-13 on [-pi/4, pi/4]
+        double ps = 1.6059043836821614599e-10;   //  1/13!
+        ps = ps * f2 - 2.5052108385441718775e-08; // -1/11!
+        ps = ps * f2 + 2.7557319223985890653e-06; //  1/9!
+        ps = ps * f2 - 1.9841269841269841270e-04; // -1/7!
+        ps = ps * f2 + 8.3333333333333333333e-03; //  1/5!
+        ps = ps * f2 - 1.6666666666666666667e-01; // -1/3!
+        const double sin_f = f + f * f2 * ps;
+
+        double pc = -1.1470745597729724714e-11;   // -1/14!
+        pc = pc * f2 + 2.0876756987868098979e-09; //  1/12!
+        pc = pc * f2 - 2.7557319223985890653e-07; // -1/10!
+        pc = pc * f2 + 2.4801587301587301587e-05; //  1/8!
+        pc = pc * f2 - 1.3888888888888888889e-03; // -1/6!
+        pc = pc * f2 + 4.1666666666666666667e-02; //  1/4!
+        pc = pc * f2 - 0.5;                       // -1/2!
+        const double cos_f = 1.0 + f2 * pc;
+
+        // sin(k*pi/2 + f): k = 0, 1, 2, 3 -> sin f, cos f, -sin f, -cos f, picked with masks
+        const uint64_t odd = 0 - (quadrant & 1);
+        const uint64_t v = (std::bit_cast<uint64_t>(cos_f) & odd) | (std::bit_cast<uint64_t>(sin_f) & ~odd);
+        return std::bit_cast<double>(v ^ ((quadrant & 2) << 62));
+    }
+
+    // Natural log for x > 0 (normal numbers)
+    inline double logPositive(double x)
+    {
+        constexpr double kLn2 = 0.69314718055994530941723212145818;
+        constexpr uint64_t kMantissa = 0x000fffffffffffffULL;
+        constexpr uint64_t kSqrt2Mantissa = 0x6a09e667f3bcdULL; // sqrt(2) = 1.6a09e667f3bcd * 2^0
+
+        // x = m * 2^e with m in [sqrt(2)/2, sqrt(2))
+        const uint64_t bits = std::bit_cast<uint64_t>(x);
+        // 1 when m would be >= sqrt(2) in [1, 2): the add carries into bit 52 (a 64-bit
+        // compare would need SSE4.2)
+        const uint64_t high = ((bits & kMantissa) + (kMantissa - kSqrt2Mantissa)) >> 52;
+        const double e = static_cast<double>(static_cast<int32_t>((bits >> 52) & 0x7ff) - 1023 + static_cast<int32_t>(high));
+        const double m = std::bit_cast<double>((bits & kMantissa) | ((0x3ffULL - high) << 52));
+
+        // log(m) = 2 atanh(s), s = (m-1)/(m+1), |s| < 0.172
+        const double s = (m - 1.0) / (m + 1.0);
+        const double s2 = s * s;
+        double p = 1.0 / 15.0;
+        p = p * s2 + 1.0 / 13.0;
+        p = p * s2 + 1.0 / 11.0;
+        p = p * s2 + 1.0 / 9.0;
+        p = p * s2 + 1.0 / 7.0;
+        p = p * s2 + 1.0 / 5.0;
+        p = p * s2 + 1.0 / 3.0;
+        p = p * s2 + 1.0;
+        return e * kLn2 + 2.0 * s * p;
+    }
+
+    // Fills u[0..n) with uniforms in [0, 1) from 53 random bits each
+    inline void fillUniform(std::mt19937_64 &rng, std::size_t n, double *u)
+    {
+        for (std::size_t i = 0; i < n; ++i)
+            u[i] = static_cast<double>(rng() >> 11) * 0x1.0p-53;
+    }
+
+    inline void constantBlock(std::size_t n, double base, double *out)
+    {
+        for (std::size_t i = 0; i < n; ++i)
+            out[i] = base;
+    }
+
+    // Adds N(0, sigma) noise with a batched Box-Muller transform; scratch needs n + 1 slots.
+    // Pair j turns scratch[j] and scratch[pairs + j] into two normals in the same slots.
+    inline void addGaussianBlock(std::mt19937_64 &rng, double sigma, std::size_t n, double *out, double *scratch)
+    {
+        const std::size_t pairs = (n + 1) / 2;
+        fillUniform(rng, 2 * pairs, scratch);
+        double *radius = scratch;
+        double *angle = scratch + pairs;
+        for (std::size_t j = 0; j < pairs; ++j)
+        {
+            const double u1 = 1.0 - radius[j]; // (0, 1]
+            const double u2 = angle[j];
+            const double r = sigma * std::sqrt(-2.0 * logPositive(u1));
+            radius[j] = r * sinTurns(u2 + 0.25); // cos
+            angle[j] = r * sinTurns(u2);
+        }
+        for (std::size_t i = 0; i < n; ++i)
+            out[i] += scratch[i];
+    }
+
+    // Adds U(-range, +range) noise; scratch needs n slots
+    inline void addUniformBlock(std::mt19937_64 &rng, double range, std::size_t n, double *out, double *scratch)
+    {
+        fillUniform(rng, n, scratch);
+        for (std::size_t i = 0; i < n; ++i)
+            out[i] += (2.0 * scratch[i] - 1.0) * range;
+    }
+
+    // Adds the saturating drift term used by SimpleSensor::generateNoise
+    inline void addDriftBlock(int64_t start_ms, int64_t period_ms, std::size_t n,
+                              double drift_ppm, double base_level, double *out)
+    {
+        constexpr double kSaturationSeconds = 300.0;
+        const double rate = drift_ppm * base_level / 1'000'000.0;
+        const double start = static_cast<double>(start_ms);
+        const double period = static_cast<double>(period_ms);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            // Blocks are far below 2^31 samples; int32 -> double vectorizes, int64 -> double
+            // does not before AVX-512
+            const double t_sec = (start + period * static_cast<int32_t>(i)) / 1000.0;
+            const double decay = 1.0 / (1.0 + t_sec / kSaturationSeconds);
+            out[i] += decay * rate * t_sec;
+        }
+    }
+} // namespace sensor::kernels
@@ -1,16 +1,19 @@
 #pragma once
 #include <random>
 #include <cmath>
+#include "sensors/CounterRng.hpp"
+#include "sensors/FaultTimeline.hpp"
 #include "sensors/ISensor.hpp"
+#include "sensors/SignalKernels.hpp"
 #include "sensors/Spec.hpp"
+#include "sensors/Waveform.hpp"
 #include <iostream>
-#include <deque>
 #include <cstddef>
+#include <stdexcept>
+#include <string_view>
 
 namespace sensor
 {
-    static constexpr size_t kMaxPlotSamples = 100;
-
     struct SpikeFaultInstance
     {
         double mag = 0.0;
@@ -35,6 +38,51 @@ namespace sensor
         int64_t end_time_ms = 0;
     };
 
+    // How SimpleSensor::generateBatch synthesizes values.
+    //   Exact:      identical to repeated nextSample() calls (default)
+    //   Vectorized: block kernels from SignalKernels.hpp; deterministic per seed, but the
+    //               RNG stream is consumed in a different order, so values differ from Exact
+    enum class BatchSynthesis
+    {
+        Exact,
+        Vectorized
+    };
+
+    // Random source for SimpleSensor.
+    //   Sequential:   std::mt19937_64 stepped once per draw (default)
+    //   CounterBased: Philox keyed by (seed, sensor id); every draw is addressed by the
+    //                 sample's sequence number, so sample N is computable without
+    //                 replaying samples 1..N-1 (see generateAt)
+    enum class RngMode
+    {
+        Sequential,
+        CounterBased
+    };
+
+    // How SimpleSensor decides whether a random dropout, spike or stuck fault starts.
+    //   PerSample: a Bernoulli trial per sample and fault kind (default)
+    //   Timeline:  arrivals pre-drawn per fault kind as a Poisson process at the same
+    //              per-sample probability (see FaultTimeline); a sample between arrivals
+    //              costs one comparison per fault kind and no RNG draws. Different draws,
+    //              so values differ from PerSample for the same seed.
+    enum class FaultSampling
+    {
+        PerSample,
+        Timeline
+    };
+
+    // "per_sample" or "timeline"; false for anything else
+    inline bool parseFaultSampling(std::string_view text, FaultSampling &out)
+    {
+        if (text == "per_sample")
+            out = FaultSampling::PerSample;
+        else if (text == "timeline")
+            out = FaultSampling::Timeline;
+        else
+            return false;
+        return true;
+    }
+
     // A simple sensor simulator that supports sine wave generation and Gaussian noise
     class SimpleSensor : public ISensor
     {
@@ -49,7 +97,10 @@ namespace sensor
               dropout_dist_(0.0),
               stuck_until_ms_(std::numeric_limits<int64_t>::max()),
               spike_dist_(0.0),
-              uniform_dist_(0.0)
+              uniform_dist_(-spec_.noise.uniform_range, +spec_.noise.uniform_range),
+              history_(kMaxPlotSamples),
+              handle_(internSensorId(spec_.id)),
+              waveform_(Waveform::fromSpec(spec_))
         {
         }
         // Resets the sensor state and reseeds the random number generator
@@ -57,6 +108,9 @@ namespace sensor
         {
             seq_ = 0;
             rng_.seed(seed);
+            handle_ = internSensorId(spec_.id); // the spec may have been edited via getSpec()
+            waveform_ = Waveform::fromSpec(spec_);
+            counter_ = CounterRng(seed, CounterRng::streamFor(spec_.id));
 
             // noise
             gaussian_sigma_ = spec_.noise.gaussian_sigma;
@@ -90,6 +144,15 @@ namespace sensor
             double drift_offset_ = 0.0;
             drift_per_sample_ = spec_.noise.drift_ppm * spec_.base_level / 1'000'000.0;
 
+            // fault timelines, on their own counter stream so they leave rng_ untouched; the
+            // rate's period is retimed to the actual sample spacing once samples arrive
+            const double period_ms = spec_.rate_hz > 0 ? 1000.0 / spec_.rate_hz : 1000.0;
+            const CounterRng faults(seed, CounterRng::streamFor(spec_.id) ^ 0x46544C31u);
+            dropout_timeline_ = FaultTimeline(p, period_ms, faults, kSlotDropout);
+            spike_timeline_ = FaultTimeline(spike_prob, period_ms, faults, kSlotSpikeTrial);
+            stuck_timeline_ = FaultTimeline(stuck_prob, period_ms, faults, kSlotStuckTrial);
+            fault_clock_ms_ = -1;
+
             stuck_until_ms_ = -1;
             last_value_ = std::numeric_limits<double>::quiet_NaN();
         }
@@ -98,23 +161,86 @@ namespace sensor
         Sample nextSample(int64_t now_ms) override
         {
             Sample s = initializeSample(now_ms);
-            if (applyDropout(s))
+            if (synthesize(s))
+                recordSample(s.value); // Add to history_
+            return s;
+        }
+
+        // Bulk variant of nextSample(): same values, RNG draws and fault behaviour, but
+        // without building a Sample (and its id/type strings) per element. Only the
+        // samples that can still be visible in history_ are recorded.
+        std::size_t generateBatch(int64_t start_ms, int64_t period_ms, std::size_t count, SampleBatchView out) override
+        {
+            count = std::min(count, out.capacity());
+            if (batch_synthesis_ == BatchSynthesis::Vectorized && rng_mode_ == RngMode::Sequential)
             {
-                recordSample(s.value);
-                return s;
+                generateBlocks(start_ms, period_ms, count, out);
+                recordBatchTail(out, count);
+                return count;
             }
 
-            double v = generateBaseSignal(now_ms);
-            v += generateNoise(now_ms);
+            Sample s{};
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                s.ts = start_ms + static_cast<int64_t>(i) * period_ms;
+                s.quality = QF_OK;
+                s.value = 0.0;
+                s.seq = ++seq_;
+
+                synthesize(s);
+                out.timestamps[i] = s.ts;
+                out.values[i] = s.value;
+                out.quality[i] = s.quality;
+            }
 
-            if (applyStuck(s, v, now_ms))
-                return s;
+            recordBatchTail(out, count);
+            return count;
+        }
 
-            applySpike(s, v);
+        void setBatchSynthesis(BatchSynthesis mode) { batch_synthesis_ = mode; }
+
+        BatchSynthesis batchSynthesis() const { return batch_synthesis_; }
+
+        // Takes effect from the next sample. Counter-based mode ignores BatchSynthesis::Vectorized.
+        void setRngMode(RngMode mode) { rng_mode_ = mode; }
+
+        RngMode rngMode() const { return rng_mode_; }
+
+        // Takes effect from the next sample. Counter-based mode keeps per-sample trials so
+        // generateAt stays random access.
+        void setFaultSampling(FaultSampling mode) { fault_sampling_ = mode; }
 
-            s.value = v;           // Final computed sensor value
-            recordSample(s.value); // Add to history_
-            return s;              // Return the sample
+        FaultSampling faultSampling() const { return fault_sampling_; }
+
+        // Random access for RngMode::CounterBased: fills `out` with the samples whose sequence
+        // numbers are first_seq, first_seq + 1, ... (nextSample() numbers from 1 after reset)
+        // at start_ms + i * period_ms. Bit-identical to producing them sequentially, and
+        // const, so disjoint ranges of one sensor can be generated on different threads.
+        // Random stuck faults carry state from sample to sample and are not supported.
+        std::size_t generateAt(uint64_t first_seq, int64_t start_ms, int64_t period_ms, std::size_t count,
+                               SampleBatchView out) const
+        {
+            if (rng_mode_ != RngMode::CounterBased)
+                throw std::logic_error("generateAt requires RngMode::CounterBased");
+            if (spec_.fault.stuck_prob > 0.0 && spec_.fault.stuck_min_ms + spec_.fault.stuck_max_ms > 0)
+                throw std::logic_error("generateAt does not support random stuck faults");
+
+            count = std::min(count, out.capacity());
+            SimpleSensor view(*this); // fault windows retire as they expire; keep *this untouched
+            Sample s{};
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                s.ts = start_ms + static_cast<int64_t>(i) * period_ms;
+                s.seq = first_seq + i;
+                s.quality = QF_OK;
+                s.value = 0.0;
+
+                view.synthesize(s);
+                out.timestamps[i] = s.ts;
+                out.values[i] = s.value;
+                out.quality[i] = s.quality;
+            }
+            return count;
         }
 
         // Returns the sampling rate in Hz
@@ -135,25 +261,38 @@ namespace sensor
             return spec_.type;
         }
 
+        SensorHandle handle() const override
+        {
+            return handle_;
+        }
+
         SensorSpec &getSpec() override
         {
             return spec_;
         }
 
-        const std::deque<double> &getHistory() const override
+        HistoryView getHistory() const override
         {
-            return history_;
+            return history_.view();
         }
 
         void recordSample(double value) override
         {
-            if (history_.size() > kMaxPlotSamples)
-            {
-                history_.pop_front();
-            }
             history_.push_back(value);
         }
 
+        // Number of recent values kept for plotting (default kMaxPlotSamples).
+        // Keeps the newest values that still fit.
+        void setHistoryCapacity(std::size_t capacity)
+        {
+            history_.setCapacity(capacity);
+        }
+
+        std::size_t historyCapacity() const
+        {
+            return history_.capacity();
+        }
+
         void triggerSpikeFault(double mag, double sigma, int64_t now_ms) override
         {
             active_spike_.mag = mag;
@@ -202,6 +341,13 @@ namespace sensor
 
         const DropoutFaultInstance &getActiveDropout() const { return active_dropout_; }
 
+        // Random fault arrivals used by FaultSampling::Timeline (rebuilt by reset())
+        const FaultTimeline &dropoutTimeline() const { return dropout_timeline_; }
+
+        const FaultTimeline &spikeTimeline() const { return spike_timeline_; }
+
+        const FaultTimeline &stuckTimeline() const { return stuck_timeline_; }
+
     private:
         SensorSpec spec_; // Sensor configuration parameters
         uint64_t seq_;    // Sample sequence counter
@@ -219,18 +365,199 @@ namespace sensor
         double drift_per_sample_ = 0.0;
         double drift_offset_ = 0.0;
         std::normal_distribution<double> spike_gauss_dist_;
-        std::deque<double> history_;
+        RingBuffer<double> history_;
+        SensorHandle handle_;
+        Waveform waveform_; // base signal, rebuilt from spec_ by reset()
         SpikeFaultInstance active_spike_;
         StuckFaultInstance active_stuck_;
         DropoutFaultInstance active_dropout_;
+        BatchSynthesis batch_synthesis_ = BatchSynthesis::Exact;
+        RngMode rng_mode_ = RngMode::Sequential;
+        FaultSampling fault_sampling_ = FaultSampling::PerSample;
+        int64_t fault_clock_ms_ = -1; // timestamp of the previous sample, for the timelines
+        FaultTimeline dropout_timeline_;
+        FaultTimeline spike_timeline_;
+        FaultTimeline stuck_timeline_;
+        CounterRng counter_;
+        uint64_t draw_seq_ = 0; // sequence number addressed by counter-based draws
+
+        // Fixed draw slots per sample in RngMode::CounterBased
+        enum DrawSlot : uint32_t
+        {
+            kSlotDropout = 0,
+            kSlotGaussian = 1, // and 2
+            kSlotUniform = 3,
+            kSlotSpikeTrial = 4,
+            kSlotSpikeValue = 5, // and 6
+            kSlotStuckTrial = 7,
+            kSlotStuckDuration = 8
+        };
+
+        bool drawBernoulli(std::bernoulli_distribution &d, DrawSlot slot)
+        {
+            if (rng_mode_ == RngMode::CounterBased)
+                return counter_.uniform(draw_seq_, slot) < d.p();
+            return d(rng_);
+        }
+
+        // Keeps the timelines' period at the spacing between this sample and the previous
+        // one, whichever fault stages ran for either
+        void retimeFaults(int64_t ts)
+        {
+            if (fault_clock_ms_ >= 0 && ts > fault_clock_ms_)
+            {
+                const double spacing = static_cast<double>(ts - fault_clock_ms_);
+                const double from = static_cast<double>(fault_clock_ms_);
+                dropout_timeline_.retime(spacing, from);
+                spike_timeline_.retime(spacing, from);
+                stuck_timeline_.retime(spacing, from);
+            }
+            fault_clock_ms_ = ts;
+        }
+
+        // Whether a random fault of one kind starts at `ts`
+        bool faultTrial(FaultTimeline &timeline, std::bernoulli_distribution &d, DrawSlot slot, int64_t ts)
+        {
+            if (fault_sampling_ == FaultSampling::Timeline && rng_mode_ == RngMode::Sequential)
+                return timeline.fires(ts);
+            return drawBernoulli(d, slot);
+        }
+
+        double drawNormal(std::normal_distribution<double> &d, DrawSlot slot)
+        {
+            if (rng_mode_ == RngMode::CounterBased)
+                return d.mean() + d.stddev() * counter_.normal(draw_seq_, slot);
+            return d(rng_);
+        }
+
+        double drawUniform(std::uniform_real_distribution<double> &d, DrawSlot slot)
+        {
+            if (rng_mode_ == RngMode::CounterBased)
+                return d.a() + (d.b() - d.a()) * counter_.uniform(draw_seq_, slot);
+            return d(rng_);
+        }
+
+        int64_t drawInt(std::uniform_int_distribution<int64_t> &d, DrawSlot slot)
+        {
+            if (rng_mode_ == RngMode::CounterBased)
+            {
+                const double span = static_cast<double>(d.b() - d.a()) + 1.0;
+                const auto k = static_cast<int64_t>(counter_.uniform(draw_seq_, slot) * span);
+                return d.a() + std::min(k, d.b() - d.a());
+            }
+            return d(rng_);
+        }
+
+        // Unit value in [0, 1] for the +-mag spike shapes
+        double drawUnit(DrawSlot slot)
+        {
+            if (rng_mode_ == RngMode::CounterBased)
+                return counter_.uniform(draw_seq_, slot);
+            return rng_() / (double)rng_.max();
+        }
+
+        // Runs the dropout → signal → noise → stuck → spike pipeline for s.ts.
+        // Returns false when the sample must not be recorded in history_ (stuck).
+        bool synthesize(Sample &s)
+        {
+            draw_seq_ = s.seq;
+            if (applyDropout(s))
+                return true;
+
+            double v = generateBaseSignal(s.ts);
+            v += generateNoise(s.ts);
+            return finishSample(s, v);
+        }
+
+        // Stuck → spike stages of synthesize() for an already computed signal value
+        bool finishSample(Sample &s, double v)
+        {
+            if (applyStuck(s, v, s.ts))
+                return false;
+
+            applySpike(s, v);
+
+            s.value = v; // Final computed sensor value
+            return true;
+        }
+
+        // True when any fault stage could alter a sample; otherwise the vectorized
+        // path skips the per-sample fault pipeline (and its RNG draws) entirely.
+        bool faultsPossible() const
+        {
+            return spec_.fault.dropout_prob > 0.0 || spec_.fault.spike_prob > 0.0 ||
+                   spec_.fault.stuck_prob > 0.0 || stuck_until_ms_ >= 0 ||
+                   active_dropout_.active || active_stuck_.active || active_spike_.active;
+        }
+
+        // BatchSynthesis::Vectorized: signal and noise are produced a block at a time by the
+        // kernels, then faults are applied per sample exactly as in synthesize().
+        void generateBlocks(int64_t start_ms, int64_t period_ms, std::size_t count, SampleBatchView out)
+        {
+            using namespace kernels;
+            double scratch[kBlockSize + 1];
+
+            const bool faults = faultsPossible();
+
+            for (std::size_t done = 0; done < count;)
+            {
+                const std::size_t n = std::min(kBlockSize, count - done);
+                const int64_t block_start = start_ms + static_cast<int64_t>(done) * period_ms;
+                double *values = out.values.data() + done;
+
+                waveform_.fill(block_start, period_ms, n, values);
+
+                if (gaussian_sigma_ > 0.0)
+                    addGaussianBlock(rng_, gaussian_sigma_, n, values, scratch);
+                if (spec_.noise.uniform_range > 0.0)
+                    addUniformBlock(rng_, spec_.noise.uniform_range, n, values, scratch);
+                if (spec_.noise.drift_ppm > 0.0)
+                    addDriftBlock(block_start, period_ms, n, spec_.noise.drift_ppm, spec_.base_level, values);
+
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    const int64_t ts = block_start + static_cast<int64_t>(i) * period_ms;
+                    out.timestamps[done + i] = ts;
+                    out.quality[done + i] = QF_OK;
+                    if (!faults)
+                        continue;
+
+                    Sample s{};
+                    s.ts = ts;
+                    if (!applyDropout(s))
+                        finishSample(s, values[i]);
+                    values[i] = s.value;
+                    out.quality[done + i] = s.quality;
+                }
+
+                done += n;
+            }
+            seq_ += count;
+        }
+
+        // Stuck samples are never recorded (see nextSample), so walk back over
+        // the recorded ones that would survive the history cap.
+        void recordBatchTail(const SampleBatchView &out, std::size_t count)
+        {
+            std::size_t first = count;
+            for (std::size_t kept = 0; first > 0 && kept < history_.capacity(); --first)
+            {
+                if (!(out.quality[first - 1] & QF_STUCK))
+                    ++kept;
+            }
+            for (std::size_t i = first; i < count; ++i)
+            {
+                if (!(out.quality[i] & QF_STUCK))
+                    recordSample(out.values[i]);
+            }
+        }
 
         Sample initializeSample(int64_t now_ms)
         {
             Sample s{};          // Create a new sample
             s.ts = now_ms;       // Timestamp in milliseconds
             s.seq = ++seq_;      // Increment and assign sequence number
-            s.id = spec_.id;     // Sensor ID (e.g. "TEMP-01")
-            s.type = spec_.type; // Sensor type (e.g. "TEMP")
+            s.sensor = handle_;  // Interned sensor ID (e.g. "TEMP-01")
             s.quality |= QF_OK;  // Placeholder for quality metric
             return s;
         }
@@ -238,6 +565,8 @@ namespace sensor
         bool applyDropout(Sample &s)
         {
             const int64_t now = s.ts;
+            if (fault_sampling_ == FaultSampling::Timeline)
+                retimeFaults(now);
 
             bool triggered = false;
             if (active_dropout_.active && now >= active_dropout_.start_time_ms && now <= active_dropout_.end_time_ms)
@@ -246,7 +575,7 @@ namespace sensor
             }
             else
             {
-                triggered = dropout_dist_(rng_);
+                triggered = faultTrial(dropout_timeline_, dropout_dist_, kSlotDropout, now);
             }
 
             if (triggered)
@@ -259,15 +588,9 @@ namespace sensor
             return false;
         }
 
-        double generateBaseSignal(int64_t now_ms)
+        double generateBaseSignal(int64_t now_ms) const
         {
-            double v = spec_.base_level;
-            if (spec_.base == "sine" && spec_.sine_amp != 0.0 && spec_.sine_freq_hz > 0.0)
-            {
-                const double t = now_ms / 1000.0;
-                v += spec_.sine_amp * std::sin(2.0 * M_PI * spec_.sine_freq_hz * t);
-            }
-            return v;
+            return waveform_.at(now_ms);
         }
 
         bool applyStuck(Sample &s, double v, int64_t now_ms)
@@ -302,9 +625,9 @@ namespace sensor
             was_stuck_prev = false;
 
             if ((stuck_until_ms_ < 0 || now_ms > stuck_until_ms_) && allow_new_stuck_trial && (spec_.fault.stuck_min_ms + spec_.fault.stuck_max_ms > 0) &&
-                stuck_prob_dist_(rng_))
+                faultTrial(stuck_timeline_, stuck_prob_dist_, kSlotStuckTrial, now_ms))
             {
-                int64_t dur = stuck_duration_dist_(rng_);
+                int64_t dur = drawInt(stuck_duration_dist_, kSlotStuckDuration);
                 if (dur > 0)
                 {
                     stuck_until_ms_ = now_ms + dur;
@@ -328,10 +651,16 @@ namespace sensor
                 if (now >= active_spike_.start_time_ms && now <= active_spike_.end_time_ms)
                 {
                     s.quality |= QF_SPIKE;
-                    double spike_value = active_spike_.sigma > 0.0
-                                             ? std::normal_distribution<double>(0.0, active_spike_.sigma)(rng_)
-                                             : (2.0 * active_spike_.mag) * ((rng_() / (double)rng_.max()) - 0.5);
-                    v += spike_value;
+                    // normal_distribution requires sigma > 0, so only build it in that branch
+                    if (active_spike_.sigma > 0.0)
+                    {
+                        std::normal_distribution<double> spike_gauss(0.0, active_spike_.sigma);
+                        v += drawNormal(spike_gauss, kSlotSpikeValue);
+                    }
+                    else
+                    {
+                        v += (2.0 * active_spike_.mag) * (drawUnit(kSlotSpikeValue) - 0.5);
+                    }
                 }
                 else if (now > active_spike_.end_time_ms)
                 {
@@ -340,7 +669,7 @@ namespace sensor
                 return;
             }
             // std::cout << "I am in the applySpike function\n";
-            if (!spike_dist_(rng_))
+            if (!faultTrial(spike_timeline_, spike_dist_, kSlotSpikeTrial, s.ts))
                 return;
 
             s.quality |= QF_SPIKE;
@@ -348,11 +677,11 @@ namespace sensor
             if (spec_.fault.spike_sigma > 0.0)
             {
                 // std::cout << "I am applying the spike because spike_sigma > 0.0\n";
-                v += spike_gauss_dist_(rng_);
+                v += drawNormal(spike_gauss_dist_, kSlotSpikeValue);
             }
             else if (spec_.fault.spike_mag > 0.0)
             {
-                double spike = (2.0 * spec_.fault.spike_mag) * ((rng_() / (double)rng_.max()) - 0.5);
+                double spike = (2.0 * spec_.fault.spike_mag) * (drawUnit(kSlotSpikeValue) - 0.5);
                 v += spike;
             }
             // std::cout << "Spike applied: " << v << "\n";
@@ -364,14 +693,12 @@ namespace sensor
 
             if (gaussian_sigma_ > 0.0)
             {
-                noise += dist_(rng_);
+                noise += drawNormal(dist_, kSlotGaussian);
             }
 
             if (spec_.noise.uniform_range > 0.0)
             {
-                std::uniform_real_distribution<double> uniform_dist(
-                    -spec_.noise.uniform_range, +spec_.noise.uniform_range);
-                noise += uniform_dist(rng_);
+                noise += drawUniform(uniform_dist_, kSlotUniform);
             }
 
             if (spec_.noise.drift_ppm > 0.0)
@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
 #include <cstdint>
+#include <vector>
 
 namespace sensor
 {
@@ -24,6 +25,16 @@ namespace sensor
         uint64_t stuck_max_ms = 0;
     };
 
+    // One axis of a multi-channel sensor (see MultiChannelSensor)
+    struct ChannelSpec
+    {
+        std::string name; // e.g. "x"
+        double base_level = 0.0;
+        double sine_amp = 0.0;
+        double sine_freq_hz = 0.0;
+        double phase_rad = 0.0;
+    };
+
     struct SensorSpec
     {
         std::string id;   // e.g. "TEMP-01"
@@ -32,11 +43,19 @@ namespace sensor
         NoiseSpec noise;
         FaultSpec fault;
 
-        // base wave: "constant" / "sine" / "step"
+        // base wave: "constant" / "sine" / "step" / "ramp" / "square" / "sawtooth" / "table"
+        // (see Waveform)
         std::string base = "constant";
         double base_level = 0.0;
-        double sine_amp = 0.0;
-        double sine_freq_hz = 0.0;
+        double sine_amp = 0.0;          // amplitude of sine / square / sawtooth, height of step
+        double sine_freq_hz = 0.0;      // frequency of the periodic waves, including table
+        double square_duty = 0.5;       // square: fraction of each period spent high
+        int64_t step_at_ms = 0;         // step: time the level jumps by sine_amp
+        double ramp_per_s = 0.0;        // ramp: slope in units per second
+        std::vector<double> wave_table; // table: one period of offsets from base_level
+
+        // Multi-channel sensors only; noise and faults apply to every channel
+        std::vector<ChannelSpec> channels;
     };
 
     static inline SensorSpec makeDefaultTempSpec()
@@ -85,4 +104,22 @@ namespace sensor
 
         return s;
     }
+
+    // 3-axis accelerometer in m/s^2: gravity on z, small vibration on x/y
+    static inline SensorSpec makeDefaultImuSpec()
+    {
+        SensorSpec s;
+        s.id = "IMU-01";
+        s.type = "IMU";
+        s.rate_hz = 100;
+
+        s.noise.gaussian_sigma = 0.02;
+
+        s.channels = {
+            {"x", 0.0, 0.3, 5.0, 0.0},
+            {"y", 0.0, 0.3, 5.0, 1.5707963267948966},
+            {"z", 9.81, 0.05, 5.0, 0.0}};
+
+        return s;
+    }
 } // namespace sensor
\ No newline at end of file
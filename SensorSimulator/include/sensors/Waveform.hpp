@@ -0,0 +1,226 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "sensors/SignalKernels.hpp"
+#include "sensors/Spec.hpp"
+
+namespace sensor
+{
+    enum class WaveShape
+    {
+        Constant,
+        Sine,
+        Step,     // base_level, then base_level + sine_amp from step_at_ms on
+        Ramp,     // base_level + ramp_per_s * t
+        Square,   // +-sine_amp, high for square_duty of each period
+        Sawtooth, // rises from -sine_amp to +sine_amp over each period
+        Table     // wave_table played once per period, linearly interpolated
+    };
+
+    // "constant", "sine", "step", "ramp", "square", "sawtooth" or "table"; false for anything else
+    inline bool parseWaveShape(std::string_view text, WaveShape &out)
+    {
+        constexpr std::pair<std::string_view, WaveShape> kNames[] = {
+            {"constant", WaveShape::Constant}, {"sine", WaveShape::Sine}, {"step", WaveShape::Step}, {"ramp", WaveShape::Ramp}, {"square", WaveShape::Square}, {"sawtooth", WaveShape::Sawtooth}, {"table", WaveShape::Table}};
+        for (const auto &[name, shape] : kNames)
+        {
+            if (text == name)
+            {
+                out = shape;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Base signal of a sensor, resolved once from its spec so the per-sample cost is a
+     * switch on the shape rather than a string compare and a libm call.
+     *
+     * Periodic shapes keep their phase as a 64-bit fixed-point fraction of a turn. The
+     * phase at t ms is t * increment + offset (mod 2^64), so any timestamp is one
+     * integer multiply away, the wrap is free and long runs do not drift. Sine goes
+     * through kernels::sinTurns, square and sawtooth are read off the phase directly,
+     * and tables are interpolated between neighbouring entries. fill() runs one
+     * branch-free loop per shape; the sine, sawtooth and ramp loops vectorize with SSE2,
+     * the square loop needs a 64-bit compare (SSE4.2 or AVX2). It matches at() bit for bit.
+     */
+    class Waveform
+    {
+    public:
+        Waveform() = default; // constant 0
+
+        // Unknown spec.base names and degenerate parameters (no amplitude, no frequency,
+        // empty table) fall back to a constant base_level, as before
+        static Waveform fromSpec(const SensorSpec &spec)
+        {
+            Waveform w;
+            w.level_ = spec.base_level;
+            w.amp_ = spec.sine_amp;
+
+            WaveShape shape = WaveShape::Constant;
+            parseWaveShape(spec.base, shape);
+            const bool periodic = spec.sine_freq_hz > 0.0;
+            switch (shape)
+            {
+            case WaveShape::Sine:
+            case WaveShape::Square:
+            case WaveShape::Sawtooth:
+                if (periodic && spec.sine_amp != 0.0)
+                    w.shape_ = shape;
+                break;
+            case WaveShape::Table:
+                if (periodic && !spec.wave_table.empty())
+                {
+                    w.shape_ = shape;
+                    w.table_ = std::make_shared<const std::vector<double>>(spec.wave_table);
+                }
+                break;
+            case WaveShape::Step:
+                w.shape_ = shape;
+                w.step_at_ms_ = spec.step_at_ms;
+                break;
+            case WaveShape::Ramp:
+                w.shape_ = shape;
+                w.ramp_per_ms_ = spec.ramp_per_s / 1000.0;
+                break;
+            case WaveShape::Constant:
+                break;
+            }
+            w.increment_ = toPhase(spec.sine_freq_hz / 1000.0);
+            w.duty_ = spec.square_duty >= 1.0 ? UINT64_MAX : toPhase(std::max(spec.square_duty, 0.0));
+            return w;
+        }
+
+        // level + amp * sin(2*pi*freq*t + phase_rad), e.g. one axis of a MultiChannelSensor
+        static Waveform sine(double level, double amp, double freq_hz, double phase_rad = 0.0)
+        {
+            Waveform w;
+            w.level_ = level;
+            w.amp_ = amp;
+            if (amp != 0.0 && freq_hz > 0.0)
+            {
+                w.shape_ = WaveShape::Sine;
+                w.increment_ = toPhase(freq_hz / 1000.0);
+                w.offset_ = toPhase(phase_rad / kernels::kTwoPi);
+            }
+            return w;
+        }
+
+        WaveShape shape() const { return shape_; }
+
+        double at(int64_t now_ms) const
+        {
+            return valueAt(now_ms, phaseAt(now_ms));
+        }
+
+        // out[i] = at(start_ms + i * period_ms); the phase advances by one add per sample
+        void fill(int64_t start_ms, int64_t period_ms, std::size_t n, double *out) const
+        {
+            uint64_t phase = phaseAt(start_ms);
+            const uint64_t step = static_cast<uint64_t>(period_ms) * increment_;
+            switch (shape_)
+            {
+            case WaveShape::Constant:
+                kernels::constantBlock(n, level_, out);
+                return;
+            case WaveShape::Sine:
+                for (std::size_t i = 0; i < n; ++i, phase += step)
+                    out[i] = level_ + amp_ * kernels::sinTurns(toTurns(phase));
+                return;
+            case WaveShape::Square:
+            {
+                const double high = level_ + amp_;
+                const double low = level_ - amp_;
+                for (std::size_t i = 0; i < n; ++i, phase += step)
+                    out[i] = phase < duty_ ? high : low;
+                return;
+            }
+            case WaveShape::Sawtooth:
+                for (std::size_t i = 0; i < n; ++i, phase += step)
+                    out[i] = level_ + amp_ * (2.0 * toTurns(phase) - 1.0);
+                return;
+            case WaveShape::Ramp:
+            {
+                // Timestamps are integers well below 2^53, so this is exact, as in at()
+                const double start = static_cast<double>(start_ms);
+                const double period = static_cast<double>(period_ms);
+                for (std::size_t i = 0; i < n; ++i)
+                    out[i] = level_ + ramp_per_ms_ * (start + period * static_cast<double>(static_cast<int32_t>(i)));
+                return;
+            }
+            case WaveShape::Step:
+            case WaveShape::Table:
+                for (std::size_t i = 0; i < n; ++i, phase += step)
+                    out[i] = valueAt(start_ms + static_cast<int64_t>(i) * period_ms, phase);
+                return;
+            }
+        }
+
+    private:
+        // Fraction of a turn in [0, 1) as fixed point; whole turns wrap away
+        static uint64_t toPhase(double turns)
+        {
+            const double scaled = (turns - std::floor(turns)) * 0x1.0p64;
+            return scaled >= 0x1.0p64 ? 0 : static_cast<uint64_t>(scaled);
+        }
+
+        // Top 52 bits of the phase as a double in [0, 1): the bits become the mantissa of
+        // [1, 2), so no uint64 -> double conversion (not vectorizable before AVX-512)
+        static double toTurns(uint64_t phase)
+        {
+            return std::bit_cast<double>((phase >> 12) | 0x3ff0000000000000ULL) - 1.0;
+        }
+
+        uint64_t phaseAt(int64_t now_ms) const
+        {
+            return static_cast<uint64_t>(now_ms) * increment_ + offset_;
+        }
+
+        double valueAt(int64_t now_ms, uint64_t phase) const
+        {
+            const double turns = toTurns(phase);
+            switch (shape_)
+            {
+            case WaveShape::Constant:
+                return level_;
+            case WaveShape::Sine:
+                return level_ + amp_ * kernels::sinTurns(turns);
+            case WaveShape::Step:
+                return now_ms >= step_at_ms_ ? level_ + amp_ : level_;
+            case WaveShape::Ramp:
+                return level_ + ramp_per_ms_ * static_cast<double>(now_ms);
+            case WaveShape::Square:
+                return phase < duty_ ? level_ + amp_ : level_ - amp_;
+            case WaveShape::Sawtooth:
+                return level_ + amp_ * (2.0 * turns - 1.0);
+            case WaveShape::Table:
+            {
+                const std::vector<double> &table = *table_;
+                const double pos = turns * static_cast<double>(table.size());
+                const std::size_t i = std::min(static_cast<std::size_t>(pos), table.size() - 1);
+                const std::size_t j = i + 1 == table.size() ? 0 : i + 1;
+                return level_ + table[i] + (table[j] - table[i]) * (pos - static_cast<double>(i));
+            }
+            }
+            return level_;
+        }
+
+        WaveShape shape_ = WaveShape::Constant;
+        double level_ = 0.0;
+        double amp_ = 0.0;
+        uint64_t increment_ = 0; // phase advance per millisecond
+        uint64_t offset_ = 0;    // phase at t = 0
+        uint64_t duty_ = 0;      // square: phase below which the wave is high
+        int64_t step_at_ms_ = 0;
+        double ramp_per_ms_ = 0.0;
+        std::shared_ptr<const std::vector<double>> table_; // shared by copies (generateAt copies the sensor)
+    };
+} // namespace sensor
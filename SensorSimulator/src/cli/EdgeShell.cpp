@@ -20,7 +20,15 @@
 #include "../../include/cli/commands/QueryLogCommand.hpp"
 #include "../../include/cli/commands/ImportLogCommand.hpp"
 #include "../../include/cli/commands/RemoveCommand.hpp"
-
+#include "../../include/cli/commands/CacheStatsCommand.hpp"
+#include "../../include/cli/commands/SimulateCommand.hpp"
+#include "../../include/cli/commands/ReplayCommand.hpp"
+#include "../../include/cli/commands/CampaignCommand.hpp"
+#include "../../include/cli/commands/DetectCommand.hpp"
+#include "../../include/scheduler/SimulationRunner.hpp"
+
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <sstream>
 #include <iomanip>
@@ -39,10 +47,8 @@ void EdgeShell::run(Mode mode)
 
     if (db_)
     {
-        db_->setColumns(
-            {"timestamp_ms", "sensor_id", "value", "fault_flags"},
-            {MiniDB::ColumnType::Int, MiniDB::ColumnType::String,
-             MiniDB::ColumnType::Float, MiniDB::ColumnType::String});
+        // Scalar log schema; adding a multi-channel sensor widens it (see widenLog())
+        db_->setColumns(MiniDB::logColumns(), MiniDB::logColumnTypes());
         activeScheduler().setDatabase(db_);
     }
 
@@ -70,6 +76,11 @@ void EdgeShell::run(Mode mode)
         registry_->registerCommand(std::make_unique<cli::QueryLogCommand>(db_));
         registry_->registerCommand(std::make_unique<cli::ImportLogCommand>(db_));
         registry_->registerCommand(std::make_unique<cli::RemoveCommand>(*this));
+        registry_->registerCommand(std::make_unique<cli::CacheStatsCommand>(db_));
+        registry_->registerCommand(std::make_unique<cli::SimulateCommand>(activeScheduler(), is_running_));
+        registry_->registerCommand(std::make_unique<cli::ReplayCommand>(*this, db_));
+        registry_->registerCommand(std::make_unique<cli::CampaignCommand>(activeScheduler(), db_));
+        registry_->registerCommand(std::make_unique<cli::DetectCommand>(activeScheduler()));
     }
     else
     {
@@ -113,26 +124,38 @@ void EdgeShell::printHelp() const
         << "  add <id>                     - Add new sensor with given ID\n"
         << "  remove <id>                  - Remove an existing sensor by ID\n"
         << "  tick <delta_ms>              - Advance time and sample as needed\n"
-        << "  run                          - Start real-time simulation (ticks every 1s)\n"
+        << "  run [speed]                  - Start simulation (ticks every 1s of simulated time)\n"
+        << "                                 speed: realtime (default), <factor>x, afap\n"
+        << "  simulate <duration> [speed]  - Run a bounded simulation and report throughput\n"
+        << "                                 e.g. simulate 1d afap\n"
+        << "  replay <file|log> [speed]    - Replay a capture file or the in-memory log as sensors\n"
+        << "  replay save <file>           - Write the in-memory log as a binary capture\n"
+        << "  campaign <file>              - Queue a fault-injection campaign on scheduled sensors\n"
+        << "  campaign report              - Compare injected faults with faults seen in the log\n"
+        << "  detect on|off [options]      - Flag noisy, flatlined and fast-changing samples\n"
+        << "                                 e.g. detect on z=4 window=32 flatline=20 rate=5\n"
+        << "  detect                       - Show per-detector counts and cost\n"
         << "  stop                         - Stop real-time simulation\n"
         << "  runplot <id>                 - Start real-time plot\n"
         << "  stopplot                     - Stop real-time plot\n"
         << "  plot <id>                    - Plot sensor data\n"
-        << "  status <id>                  - Show active faults on given sensor\n"
+        << "  status <id>                  - Show active faults and output statistics of given sensor\n"
         << "  logstatus [filters]          - Show logged sensor entries with optional filters\n"
         << "                                 e.g. logstatus TEMP-001 last=5\n"
         << "  savelog                      - Save logs to .tbl file (in ./data folder)\n"
         << "  loadlog                      - Load logs from disk into memory\n"
         << "  clearlog                     - Clear all logs from memory and disk\n"
-        << "  exportlog [options]          - Export logs to JSON file\n"
+        << "  exportlog [options]          - Export logs to JSON or columnar file\n"
         << "                                 e.g. exportlog filename=logs.json\n"
         << "                                 e.g. exportlog source=disk filename=backup.json\n"
+        << "                                 e.g. exportlog format=columnar filename=logs.mdbc\n"
         << "  querylog <conds> [source=..] - Query logs with conditions\n"
         << "                                 e.g. querylog column=value op== value=25.0\n"
         << "                                 e.g. querylog column=sensor_id op== value=TEMP-001 source=disk\n"
         << "  importlog [options]          - Import logs from JSON into memory or disk\n"
         << "                                 e.g. importlog filename=backup.json\n"
         << "                                 e.g. importlog target=disk filename=logs.json\n"
+        << "  cachestats                   - Show page cache hit/miss counters for disk queries\n"
         << "  inject <type> <id> [p1 p2]   - Inject fault (spike/stuck/dropout) with optional params\n"
         << "                                 e.g. inject spike TEMP-001 5.0 0.3\n"
         << "  reset <id>                   - Reset sensor\n"
@@ -214,63 +237,58 @@ void EdgeShell::stepSensor(const std::string &sensorId)
 
 void EdgeShell::injectFault(const std::string &faultType, const std::string &sensorId, const std::vector<std::string> &params)
 {
-    auto *scheduledSensor = activeScheduler().getScheduledSensorAs<sensor::SimpleSensor>(sensorId);
-    if (!scheduledSensor)
-    {
-        std::cout << "Sensor not scheduled: " << sensorId << "\n";
-        return;
-    }
+    using FaultKind = sensor::SensorScheduler::FaultKind;
+    sensor::SensorScheduler::FaultEvent fault{activeScheduler().getNowUs(), sensorId, FaultKind::Spike};
 
     if (faultType == "spike")
     {
-        double mag = 3.0;
-        double sigma = 0.5;
-
         if (params.size() >= 1)
-            mag = std::stod(params[0]);
+            fault.mag = std::stod(params[0]);
 
         if (params.size() >= 2)
-            sigma = std::stod(params[1]);
-
-        int64_t now = activeScheduler().getNow();
-        scheduledSensor->triggerSpikeFault(mag, sigma, now);
-
-        std::cout << "Triggered transient spike on " << sensorId
-                  << " [mag=" << mag << ", sigma=" << sigma << "]\n";
+            fault.sigma = std::stod(params[1]);
     }
     else if (faultType == "stuck")
     {
-        int duration_ms = 1000;
+        fault.kind = FaultKind::Stuck;
+        fault.duration_ms = 1000;
         if (params.size() >= 1)
-            duration_ms = std::stoi(params[0]);
-        std::cout << "Duration MS is ->> " << duration_ms << "\n";
-
-        int64_t now = activeScheduler().getNow();
-        double current_value = scheduledSensor->getHistory().empty()
-                                   ? scheduledSensor->getSpec().base_level
-                                   : scheduledSensor->getHistory().back();
-
-        scheduledSensor->triggerStuckFault(duration_ms, now, current_value);
-
-        std::cout << "Triggered transient stuck fault on " << sensorId
-                  << " [duration=" << duration_ms << " ms]\n";
+            fault.duration_ms = std::stoi(params[0]);
+        std::cout << "Duration MS is ->> " << fault.duration_ms << "\n";
     }
     else if (faultType == "dropout")
     {
-        int duration_ms = 2000;
+        fault.kind = FaultKind::Dropout;
+        fault.duration_ms = 2000;
         if (!params.empty())
-            duration_ms = std::stoi(params[0]);
-
-        auto now = activeScheduler().getNow();
-
-        scheduledSensor->triggerDropoutFault(now, duration_ms);
-
-        std::cout << "Injected dropout fault on " << sensorId
-                  << " [duration=" << duration_ms << "ms]\n";
+            fault.duration_ms = std::stoi(params[0]);
     }
     else
     {
         std::cout << "Unknown fault type: " << faultType << "\n";
+        return;
+    }
+
+    if (!activeScheduler().injectFault(fault))
+    {
+        std::cout << "Sensor not scheduled: " << sensorId << "\n";
+        return;
+    }
+
+    switch (fault.kind)
+    {
+    case FaultKind::Spike:
+        std::cout << "Triggered transient spike on " << sensorId
+                  << " [mag=" << fault.mag << ", sigma=" << fault.sigma << "]\n";
+        break;
+    case FaultKind::Stuck:
+        std::cout << "Triggered transient stuck fault on " << sensorId
+                  << " [duration=" << fault.duration_ms << " ms]\n";
+        break;
+    case FaultKind::Dropout:
+        std::cout << "Injected dropout fault on " << sensorId
+                  << " [duration=" << fault.duration_ms << "ms]\n";
+        break;
     }
 }
 
@@ -286,7 +304,7 @@ void EdgeShell::resetSensor(const std::string &sensorId)
     std::cout << "Sensor reset: " << sensorId << "\n";
 }
 
-void EdgeShell::addScheduledSensor(const std::string &sensorId, uint64_t period_ms)
+void EdgeShell::addScheduledSensor(const std::string &sensorId, uint64_t period_ms, FaultSampling sampling)
 {
     if (owned_sensors_.find(sensorId) != owned_sensors_.end() || activeScheduler().getScheduledSensor(sensorId))
     {
@@ -306,22 +324,65 @@ void EdgeShell::addScheduledSensor(const std::string &sensorId, uint64_t period_
     {
         spec = makeDefaultPressureSpec();
     }
+    else if (upperId.starts_with("IMU"))
+    {
+        spec = makeDefaultImuSpec();
+    }
     else
     {
         printHelp();
-        std::cout << "Only TEMP and PRES commands are acceptable at the moment...\n";
+        std::cout << "Only TEMP, PRES and IMU sensors are supported at the moment...\n";
 
         return;
     }
     spec.id = sensorId;
 
-    auto sensor = std::make_unique<SimpleSensor>(spec);
+    std::unique_ptr<ISensor> sensor;
+    if (spec.channels.empty())
+    {
+        auto simple = std::make_unique<SimpleSensor>(spec);
+        simple->setFaultSampling(sampling);
+        sensor = std::move(simple);
+    }
+    else
+        sensor = std::make_unique<MultiChannelSensor>(spec);
     ISensor *sensorPtr = sensor.get();
+    widenLog(*sensorPtr);
     owned_sensors_[sensorId] = std::move(sensor);
     activeScheduler().addScheduledSensor(sensorId, sensorPtr, period_ms);
     std::cout << "Sensor added: " << sensorId << "\n";
 }
 
+void EdgeShell::addReplaySensors(const std::vector<RecordedStream> &streams, double speed)
+{
+    for (const auto &stream : streams)
+    {
+        if (owned_sensors_.find(stream.id) != owned_sensors_.end() || activeScheduler().getScheduledSensorAs<ISensor>(stream.id))
+        {
+            std::cout << "Sensor already exists: " << stream.id << "\n";
+            continue;
+        }
+
+        auto sensor = makeReplaySensor(stream);
+        sensor->setPlaybackSpeed(speed);
+        ISensor *sensorPtr = sensor.get();
+        widenLog(*sensorPtr);
+        owned_sensors_[stream.id] = std::move(sensor);
+        // At speed s the recording's period covers 1/s of scheduler time, kept in µs so
+        // e.g. 250 ms at 3x stays 83'333 µs instead of truncating to 83 ms
+        const double period_us = static_cast<double>(nominalPeriodMs(stream.samples)) * 1000.0 / speed;
+        activeScheduler().addScheduledSensorUs(stream.id, sensorPtr, std::max<uint64_t>(1, std::llround(period_us)));
+        std::cout << "Replay sensor added: " << stream.id << " (" << stream.samples.size() << " samples)\n";
+    }
+}
+
+// Gives the log one value column per channel of the sensor, so its samples stay one row each
+void EdgeShell::widenLog(const ISensor &sensor)
+{
+    if (db_ && sensor.channelCount() > 1)
+        db_->widenLogColumns(sensor.channelCount());
+}
+
 void EdgeShell::stepAllSensors()
 {
     auto ids = activeScheduler().getSensorIds();
@@ -436,6 +497,10 @@ void EdgeShell::plotSensorData(const std::string &sensorId) const
         }
     }
     std::cout << "\n";
+
+    // The axis above covers the plotted window only; the whole run comes from the scheduler
+    if (const auto *stats = activeScheduler().getSensorStats(sensorId); stats && stats->count() > 0)
+        sensor::printStats(std::cout, sensorId, *stats);
 }
 
 void EdgeShell::setDatabase(MiniDB *db) { db_ = db; }
@@ -0,0 +1,229 @@
+#include "../../include/scheduler/FaultCampaign.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <ostream>
+#include <random>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace
+{
+    using nlohmann::json;
+    using FaultEvent = sensor::SensorScheduler::FaultEvent;
+    using FaultKind = sensor::SensorScheduler::FaultKind;
+
+    FaultKind parseKind(const std::string &name)
+    {
+        if (name == "spike")
+            return FaultKind::Spike;
+        if (name == "stuck")
+            return FaultKind::Stuck;
+        if (name == "dropout")
+            return FaultKind::Dropout;
+        throw std::invalid_argument("Unknown campaign fault: '" + name + "'");
+    }
+
+    std::vector<const std::string *> matchSensors(const std::string &pattern, const std::vector<std::string> &ids)
+    {
+        std::vector<const std::string *> matches;
+        if (!pattern.empty() && pattern.back() == '*')
+        {
+            const std::string_view prefix(pattern.data(), pattern.size() - 1);
+            for (const auto &id : ids)
+            {
+                if (std::string_view(id).substr(0, prefix.size()) == prefix)
+                    matches.push_back(&id);
+            }
+        }
+        else if (auto it = std::find(ids.begin(), ids.end(), pattern); it != ids.end())
+        {
+            matches.push_back(&*it);
+        }
+        return matches;
+    }
+
+    // A number, or a [lo, hi] range drawn uniformly
+    double drawNumber(const json &entry, const char *field, double fallback, std::mt19937_64 &rng)
+    {
+        auto it = entry.find(field);
+        if (it == entry.end())
+            return fallback;
+        if (it->is_number())
+            return it->get<double>();
+        if (it->is_array() && it->size() == 2 && (*it)[0].is_number() && (*it)[1].is_number())
+        {
+            const double lo = (*it)[0].get<double>();
+            const double hi = (*it)[1].get<double>();
+            return std::uniform_real_distribution<double>(std::min(lo, hi), std::max(lo, hi))(rng);
+        }
+        throw std::invalid_argument(std::string("Campaign field '") + field + "' must be a number or a [lo, hi] range");
+    }
+
+    // drawNumber for fields that must not be negative; a range is checked as a whole, so
+    // a bad bound fails every time rather than only when it is drawn
+    double drawNonNegative(const json &entry, const char *field, double fallback, std::mt19937_64 &rng)
+    {
+        bool negative = false;
+        if (auto it = entry.find(field); it != entry.end() && it->is_array())
+            for (const auto &bound : *it)
+                negative |= bound.is_number() && bound.get<double>() < 0.0;
+        const double value = drawNumber(entry, field, fallback, rng);
+        if (negative || value < 0.0)
+            throw std::invalid_argument(std::string("Campaign field '") + field + "' must not be negative");
+        return value;
+    }
+
+    // "count" of a random block, read signed so -1 is rejected instead of wrapping
+    std::size_t blockCount(const json &block)
+    {
+        const auto count = block.value("count", int64_t{0});
+        if (count < 0)
+            throw std::invalid_argument("Campaign random block: count must not be negative");
+        return static_cast<std::size_t>(count);
+    }
+
+    // Fault parameters of one event, with the `inject` command defaults
+    FaultEvent makeEvent(const json &entry, FaultKind kind, std::mt19937_64 &rng)
+    {
+        FaultEvent event{0, {}, kind};
+        event.mag = drawNumber(entry, "mag", event.mag, rng);
+        event.sigma = drawNumber(entry, "sigma", event.sigma, rng);
+        const double fallback = kind == FaultKind::Dropout ? 2000.0 : 1000.0;
+        event.duration_ms = kind == FaultKind::Spike ? 0 : static_cast<int64_t>(drawNonNegative(entry, "duration_ms", fallback, rng));
+        return event;
+    }
+
+    uint64_t toUs(double ms, uint64_t origin_us)
+    {
+        if (ms < 0.0)
+            throw std::invalid_argument("Campaign times must not be negative");
+        return origin_us + static_cast<uint64_t>(ms * 1000.0);
+    }
+}
+
+namespace sensor
+{
+    FaultCampaign parseFaultCampaign(const nlohmann::json &config, const std::vector<std::string> &sensorIds,
+                                     uint64_t origin_us)
+    {
+        FaultCampaign campaign;
+        std::mt19937_64 rng(config.value("seed", uint64_t{1}));
+
+        const json events = config.value("events", json::array());
+        const json random = config.value("random", json::array());
+        if (!events.is_array() || !random.is_array())
+            throw std::invalid_argument("Campaign: 'events' and 'random' must be arrays");
+
+        std::size_t total = 0;
+        for (const auto &block : random)
+            total += blockCount(block);
+        campaign.events.reserve(events.size() + total);
+
+        for (const auto &entry : events)
+        {
+            const FaultKind kind = parseKind(entry.value("fault", ""));
+            const uint64_t at_us = toUs(entry.value("at_ms", 0.0), origin_us);
+            for (const std::string *id : matchSensors(entry.value("sensor", ""), sensorIds))
+            {
+                FaultEvent event = makeEvent(entry, kind, rng);
+                event.at_us = at_us;
+                event.sensor_id = *id;
+                campaign.events.push_back(std::move(event));
+            }
+        }
+
+        for (const auto &block : random)
+        {
+            const FaultKind kind = parseKind(block.value("fault", ""));
+            const auto matches = matchSensors(block.value("sensor", "*"), sensorIds);
+            const double from_ms = block.value("from_ms", 0.0);
+            const double to_ms = block.value("to_ms", from_ms);
+            if (to_ms < from_ms)
+                throw std::invalid_argument("Campaign random block: to_ms precedes from_ms");
+            if (matches.empty())
+                continue;
+
+            std::uniform_int_distribution<std::size_t> pick(0, matches.size() - 1);
+            std::uniform_real_distribution<double> when(from_ms, to_ms);
+            const std::size_t count = blockCount(block);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                FaultEvent event = makeEvent(block, kind, rng);
+                event.at_us = toUs(to_ms > from_ms ? when(rng) : from_ms, origin_us);
+                event.sensor_id = *matches[pick(rng)];
+                campaign.events.push_back(std::move(event));
+            }
+        }
+        return campaign;
+    }
+
+    FaultCampaign loadFaultCampaign(const std::string &path, const std::vector<std::string> &sensorIds,
+                                    uint64_t origin_us)
+    {
+        std::ifstream file(path);
+        if (!file)
+            throw std::runtime_error("Cannot open fault campaign: " + path);
+        try
+        {
+            return parseFaultCampaign(nlohmann::json::parse(file), sensorIds, origin_us);
+        }
+        catch (const nlohmann::json::exception &e)
+        {
+            throw std::runtime_error("Invalid fault campaign " + path + ": " + e.what());
+        }
+    }
+
+    CampaignSummary summarizeCampaign(const SensorScheduler::FaultCounts &injected, const std::vector<LogEntry> &logs)
+    {
+        enum : uint8_t
+        {
+            kSpike = 1,
+            kStuck = 2,
+            kDropout = 4
+        };
+
+        CampaignSummary summary;
+        summary.injected = injected;
+        std::unordered_map<std::string, uint8_t> previous; // fault bits of each sensor's last row
+        std::unordered_set<std::string> affected;
+
+        for (const auto &row : logs)
+        {
+            uint8_t bits = 0;
+            for (const auto &fault : row.faults)
+            {
+                if (fault == "spike")
+                    bits |= kSpike;
+                else if (fault == "stuck")
+                    bits |= kStuck;
+                else if (fault == "dropout")
+                    bits |= kDropout;
+            }
+
+            uint8_t &prev = previous[row.sensorId];
+            const uint8_t onsets = bits & ~prev;
+            prev = bits;
+            if (bits)
+            {
+                ++summary.faulted_rows;
+                affected.insert(row.sensorId);
+            }
+            summary.observed.spike += (onsets & kSpike) != 0;
+            summary.observed.stuck += (onsets & kStuck) != 0;
+            summary.observed.dropout += (onsets & kDropout) != 0;
+        }
+        summary.sensors_affected = affected.size();
+        return summary;
+    }
+
+    void printCampaignSummary(std::ostream &out, const CampaignSummary &summary)
+    {
+        out << "Fault campaign summary (injected / observed onsets):\n"
+            << "  spike:   " << summary.injected.spike << " / " << summary.observed.spike << "\n"
+            << "  stuck:   " << summary.injected.stuck << " / " << summary.observed.stuck << "\n"
+            << "  dropout: " << summary.injected.dropout << " / " << summary.observed.dropout << "\n"
+            << "  faulted rows: " << summary.faulted_rows << " across " << summary.sensors_affected << " sensors\n";
+    }
+} // namespace sensor
@@ -0,0 +1,291 @@
+#include "../../include/scheduler/FleetSpec.hpp"
+#include "../../include/scheduler/SensorScheduler.hpp"
+#include "../../include/sensors/MultiChannelSensor.hpp"
+#include "../../include/sensors/Waveform.hpp"
+
+#include <fstream>
+#include <stdexcept>
+
+namespace
+{
+    using nlohmann::json;
+    using sensor::SensorSpec;
+
+    // Value of a numeric field for instance i of n: a number, or a [lo, hi] range spread linearly
+    double numberAt(const json &value, std::size_t i, std::size_t n, const std::string &field)
+    {
+        if (value.is_number())
+            return value.get<double>();
+        if (value.is_array() && value.size() == 2 && value[0].is_number() && value[1].is_number())
+        {
+            const double lo = value[0].get<double>();
+            const double hi = value[1].get<double>();
+            return n > 1 ? lo + (hi - lo) * static_cast<double>(i) / static_cast<double>(n - 1) : lo;
+        }
+        throw std::invalid_argument("Fleet field '" + field + "' must be a number or a [lo, hi] range");
+    }
+
+    template <typename T>
+    void setNumber(const json &object, const char *field, T &out, std::size_t i, std::size_t n)
+    {
+        auto it = object.find(field);
+        if (it != object.end())
+            out = static_cast<T>(numberAt(*it, i, n, field));
+    }
+
+    // "TEMP-{n:04}" with number 7 -> "TEMP-0007"
+    std::string expandId(const std::string &pattern, uint64_t number)
+    {
+        const auto open = pattern.find("{n");
+        if (open == std::string::npos)
+            return pattern;
+        const auto close = pattern.find('}', open);
+        if (close == std::string::npos)
+            throw std::invalid_argument("Unterminated placeholder in fleet id: " + pattern);
+
+        std::size_t width = 0;
+        if (pattern[open + 2] == ':')
+        {
+            for (std::size_t k = open + 3; k < close; ++k)
+            {
+                if (pattern[k] < '0' || pattern[k] > '9')
+                    throw std::invalid_argument("Invalid placeholder in fleet id: " + pattern);
+                width = width * 10 + static_cast<std::size_t>(pattern[k] - '0');
+            }
+        }
+        else if (open + 2 != close)
+        {
+            throw std::invalid_argument("Invalid placeholder in fleet id: " + pattern);
+        }
+
+        std::string digits = std::to_string(number);
+        if (digits.size() < width)
+            digits.insert(0, width - digits.size(), '0');
+        return pattern.substr(0, open) + digits + pattern.substr(close + 1);
+    }
+
+    SensorSpec presetSpec(const std::string &preset)
+    {
+        if (preset.empty())
+            return SensorSpec{};
+        if (preset == "temp")
+            return sensor::makeDefaultTempSpec();
+        if (preset == "pressure")
+            return sensor::makeDefaultPressureSpec();
+        if (preset == "imu")
+            return sensor::makeDefaultImuSpec();
+        throw std::invalid_argument("Unknown fleet preset: " + preset);
+    }
+
+    void applyFields(SensorSpec &spec, const json &fields, std::size_t i, std::size_t n)
+    {
+        spec.type = fields.value("type", spec.type);
+        spec.base = fields.value("base", spec.base);
+        if (sensor::WaveShape shape; !sensor::parseWaveShape(spec.base, shape))
+            throw std::invalid_argument("Unknown fleet base wave: " + spec.base);
+        setNumber(fields, "rate_hz", spec.rate_hz, i, n);
+        setNumber(fields, "base_level", spec.base_level, i, n);
+        setNumber(fields, "sine_amp", spec.sine_amp, i, n);
+        setNumber(fields, "sine_freq_hz", spec.sine_freq_hz, i, n);
+        setNumber(fields, "square_duty", spec.square_duty, i, n);
+        setNumber(fields, "step_at_ms", spec.step_at_ms, i, n);
+        setNumber(fields, "ramp_per_s", spec.ramp_per_s, i, n);
+        if (auto table = fields.find("wave_table"); table != fields.end())
+            spec.wave_table = table->get<std::vector<double>>();
+
+        if (auto noise = fields.find("noise"); noise != fields.end())
+        {
+            setNumber(*noise, "gaussian_sigma", spec.noise.gaussian_sigma, i, n);
+            setNumber(*noise, "uniform_range", spec.noise.uniform_range, i, n);
+            setNumber(*noise, "drift_ppm", spec.noise.drift_ppm, i, n);
+        }
+
+        if (auto fault = fields.find("fault"); fault != fields.end())
+        {
+            setNumber(*fault, "spike_prob", spec.fault.spike_prob, i, n);
+            setNumber(*fault, "dropout_prob", spec.fault.dropout_prob, i, n);
+            setNumber(*fault, "spike_mag", spec.fault.spike_mag, i, n);
+            setNumber(*fault, "spike_sigma", spec.fault.spike_sigma, i, n);
+            setNumber(*fault, "stuck_prob", spec.fault.stuck_prob, i, n);
+            setNumber(*fault, "stuck_min_ms", spec.fault.stuck_min_ms, i, n);
+            setNumber(*fault, "stuck_max_ms", spec.fault.stuck_max_ms, i, n);
+        }
+
+        if (auto channels = fields.find("channels"); channels != fields.end())
+        {
+            spec.channels.clear();
+            for (const auto &ch : *channels)
+            {
+                sensor::ChannelSpec channel;
+                channel.name = ch.value("name", "");
+                setNumber(ch, "base_level", channel.base_level, i, n);
+                setNumber(ch, "sine_amp", channel.sine_amp, i, n);
+                setNumber(ch, "sine_freq_hz", channel.sine_freq_hz, i, n);
+                setNumber(ch, "phase_rad", channel.phase_rad, i, n);
+                spec.channels.push_back(std::move(channel));
+            }
+        }
+    }
+
+    sensor::FaultSampling faultSamplingOf(const json &fields, sensor::FaultSampling fallback)
+    {
+        auto it = fields.find("fault_sampling");
+        if (it == fields.end())
+            return fallback;
+        sensor::FaultSampling mode = fallback;
+        if (!it->is_string() || !sensor::parseFaultSampling(it->get<std::string>(), mode))
+            throw std::invalid_argument("Fleet field 'fault_sampling' must be \"per_sample\" or \"timeline\"");
+        return mode;
+    }
+
+    // SimpleSensor, or MultiChannelSensor for specs with channels
+    std::unique_ptr<sensor::ISensor> makeFleetSensor(const sensor::FleetEntry &entry, uint64_t seed)
+    {
+        std::unique_ptr<sensor::ISensor> sensor;
+        if (entry.spec.channels.empty())
+        {
+            auto simple = std::make_unique<sensor::SimpleSensor>(entry.spec);
+            simple->setFaultSampling(entry.fault_sampling);
+            sensor = std::move(simple);
+        }
+        else
+        {
+            sensor = std::make_unique<sensor::MultiChannelSensor>(entry.spec);
+        }
+        sensor->reset(seed);
+        return sensor;
+    }
+}
+
+namespace sensor
+{
+    FleetSpec parseFleetSpec(const nlohmann::json &config)
+    {
+        FleetSpec fleet;
+        fleet.seed = config.value("seed", fleet.seed);
+        const FaultSampling fleetSampling = faultSamplingOf(config, FaultSampling::PerSample);
+
+        const json templates = config.value("templates", json::object());
+        const json groups = config.value("groups", json::array());
+        if (!groups.is_array())
+            throw std::invalid_argument("Fleet config: 'groups' must be an array");
+
+        std::size_t total = 0;
+        for (const auto &group : groups)
+            total += group.value("count", std::size_t{1});
+        fleet.sensors.reserve(total);
+
+        for (std::size_t g = 0; g < groups.size(); ++g)
+        {
+            json fields = json::object();
+            if (auto name = groups[g].find("template"); name != groups[g].end())
+            {
+                auto tmpl = templates.find(name->get<std::string>());
+                if (tmpl == templates.end())
+                    throw std::invalid_argument("Fleet group " + std::to_string(g) + ": unknown template '" +
+                                                name->get<std::string>() + "'");
+                fields = *tmpl;
+            }
+            fields.merge_patch(groups[g]);
+
+            const std::string idPattern = fields.value("id", "");
+            if (idPattern.empty())
+                throw std::invalid_argument("Fleet group " + std::to_string(g) + ": missing 'id'");
+            const auto count = fields.value("count", std::size_t{1});
+            const auto start = fields.value("start", uint64_t{1});
+            const SensorSpec preset = presetSpec(fields.value("preset", ""));
+            const bool pooled = fields.value("pool", false);
+            const FaultSampling sampling = faultSamplingOf(fields, fleetSampling);
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                FleetEntry entry{preset, 0, g, pooled, sampling};
+                applyFields(entry.spec, fields, i, count);
+                entry.spec.id = expandId(idPattern, start + i);
+                if (entry.spec.type.empty())
+                    entry.spec.type = entry.spec.id.substr(0, entry.spec.id.find('-'));
+
+                if (fields.contains("period_us"))
+                    setNumber(fields, "period_us", entry.period_us, i, count);
+                else if (fields.contains("period_ms"))
+                    entry.period_us = static_cast<uint64_t>(numberAt(fields["period_ms"], i, count, "period_ms") * 1000.0);
+                else if (entry.spec.rate_hz > 0)
+                    entry.period_us = (1'000'000 + entry.spec.rate_hz / 2) / entry.spec.rate_hz;
+                if (entry.period_us == 0)
+                    throw std::invalid_argument("Fleet group " + std::to_string(g) + ": period must be positive");
+                if (pooled && (!entry.spec.channels.empty() || entry.spec.fault.stuck_prob > 0.0 ||
+                               (i > 0 && entry.period_us != fleet.sensors.back().period_us)))
+                    throw std::invalid_argument("Fleet group " + std::to_string(g) +
+                                                ": a pool needs one period, one channel and no random stuck faults");
+
+                fleet.sensors.push_back(std::move(entry));
+            }
+        }
+        return fleet;
+    }
+
+    FleetSpec loadFleetSpec(const std::string &path)
+    {
+        std::ifstream file(path);
+        if (!file)
+            throw std::runtime_error("Cannot open fleet config: " + path);
+        try
+        {
+            return parseFleetSpec(nlohmann::json::parse(file));
+        }
+        catch (const nlohmann::json::exception &e)
+        {
+            throw std::runtime_error("Invalid fleet config " + path + ": " + e.what());
+        }
+    }
+
+    std::vector<std::unique_ptr<ISensor>> makeFleetSensors(const FleetSpec &fleet)
+    {
+        std::vector<std::unique_ptr<ISensor>> sensors;
+        sensors.reserve(fleet.sensors.size());
+        for (std::size_t i = 0; i < fleet.sensors.size(); ++i)
+            sensors.push_back(makeFleetSensor(fleet.sensors[i], fleet.seed + i));
+        return sensors;
+    }
+
+    std::size_t deployFleet(const FleetSpec &fleet, SensorScheduler &scheduler,
+                            std::vector<std::unique_ptr<ISensor>> &owned,
+                            std::vector<std::unique_ptr<ISensorPool>> &pools)
+    {
+        std::vector<SensorScheduler::BulkSensor> batch;
+        batch.reserve(fleet.sensors.size());
+        owned.reserve(owned.size() + fleet.sensors.size());
+
+        // Pooled groups are contiguous runs of entries; each becomes one pool
+        std::vector<std::pair<std::unique_ptr<SensorPool<FleetPoolSensor>>, uint64_t>> grouped;
+        for (std::size_t i = 0; i < fleet.sensors.size();)
+        {
+            const FleetEntry &entry = fleet.sensors[i];
+            if (!entry.pooled)
+            {
+                owned.push_back(makeFleetSensor(entry, fleet.seed + i));
+                batch.push_back({entry.spec.id, owned.back().get(), entry.period_us});
+                ++i;
+                continue;
+            }
+
+            std::size_t end = i;
+            while (end < fleet.sensors.size() && fleet.sensors[end].pooled && fleet.sensors[end].group == entry.group)
+                ++end;
+            auto pool = std::make_unique<SensorPool<FleetPoolSensor>>();
+            pool->reserve(end - i);
+            for (std::size_t k = i; k < end; ++k)
+                pool->emplace(fleet.sensors[k].spec).reset(fleet.seed + k);
+            grouped.emplace_back(std::move(pool), entry.period_us);
+            i = end;
+        }
+
+        std::size_t added = scheduler.addScheduledSensors(batch);
+        for (auto &[pool, period_us] : grouped)
+        {
+            added += scheduler.addSensorPool(*pool, period_us);
+            pools.push_back(std::move(pool));
+        }
+        return added;
+    }
+} // namespace sensor
@@ -0,0 +1,173 @@
+#include "../../include/scheduler/ReplayCapture.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace
+{
+    constexpr char kMagic[8] = {'S', 'E', 'P', 'C', 'A', 'P', '0', '1'};
+
+    // Smallest encoding of a stream (two empty strings and a count) and of a sample
+    constexpr uint64_t kMinStreamBytes = 4 + 4 + 8;
+    constexpr uint64_t kSampleBytes = 8 + 8 + 1;
+
+    template <typename T>
+    void put(std::ostream &os, const T &value)
+    {
+        os.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    void putString(std::ostream &os, const std::string &text)
+    {
+        put(os, static_cast<uint32_t>(text.size()));
+        os.write(text.data(), static_cast<std::streamsize>(text.size()));
+    }
+
+    template <typename T>
+    T get(std::istream &is)
+    {
+        T value{};
+        if (!is.read(reinterpret_cast<char *>(&value), sizeof(T)))
+            throw std::runtime_error("Truncated capture file");
+        return value;
+    }
+
+    // Bytes left after the read position, which bounds every count read from the file
+    uint64_t remaining(std::istream &is)
+    {
+        const auto pos = is.tellg();
+        is.seekg(0, std::ios::end);
+        const auto end = is.tellg();
+        is.seekg(pos);
+        return end > pos ? static_cast<uint64_t>(end - pos) : 0;
+    }
+
+    std::string getString(std::istream &is)
+    {
+        const auto length = get<uint32_t>(is);
+        if (length > remaining(is))
+            throw std::runtime_error("Truncated capture file");
+        std::string text(length, '\0');
+        if (!is.read(text.data(), static_cast<std::streamsize>(text.size())))
+            throw std::runtime_error("Truncated capture file");
+        return text;
+    }
+
+    // "TEMP-001" -> "TEMP"
+    std::string typeFromId(const std::string &id)
+    {
+        return id.substr(0, id.find('-'));
+    }
+}
+
+namespace sensor
+{
+    void writeCapture(const std::string &path, const std::vector<RecordedStream> &streams)
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out)
+            throw std::runtime_error("Cannot open capture file for writing: " + path);
+
+        out.write(kMagic, sizeof(kMagic));
+        put(out, static_cast<uint32_t>(streams.size()));
+        for (const auto &stream : streams)
+        {
+            putString(out, stream.id);
+            putString(out, stream.type);
+            put(out, static_cast<uint64_t>(stream.samples.size()));
+            for (const auto &sample : stream.samples)
+            {
+                put(out, sample.ts_ms);
+                put(out, sample.value);
+                put(out, sample.quality);
+            }
+        }
+
+        if (!out)
+            throw std::runtime_error("Failed to write capture file: " + path);
+    }
+
+    std::vector<RecordedStream> readCapture(const std::string &path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+            throw std::runtime_error("Cannot open capture file: " + path);
+
+        char magic[sizeof(kMagic)];
+        if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0)
+            throw std::runtime_error("Not a capture file: " + path);
+
+        const auto streamCount = get<uint32_t>(in);
+        if (streamCount > remaining(in) / kMinStreamBytes)
+            throw std::runtime_error("Corrupt capture file (stream count): " + path);
+        std::vector<RecordedStream> streams(streamCount);
+        for (auto &stream : streams)
+        {
+            stream.id = getString(in);
+            stream.type = getString(in);
+            const auto count = get<uint64_t>(in);
+            if (count > remaining(in) / kSampleBytes)
+                throw std::runtime_error("Corrupt capture file (sample count): " + path);
+            stream.samples.reserve(static_cast<std::size_t>(count));
+            for (uint64_t i = 0; i < count; ++i)
+            {
+                RecordedSample sample{};
+                sample.ts_ms = get<int64_t>(in);
+                sample.value = get<double>(in);
+                sample.quality = get<uint8_t>(in);
+                stream.samples.push_back(sample);
+            }
+        }
+        return streams;
+    }
+
+    std::vector<RecordedStream> streamsFromLogs(const std::vector<LogEntry> &logs)
+    {
+        std::vector<RecordedStream> streams;
+        std::unordered_map<std::string, std::size_t> index;
+        for (const auto &entry : logs)
+        {
+            auto [it, inserted] = index.try_emplace(entry.sensorId, streams.size());
+            if (inserted)
+                streams.push_back(RecordedStream{entry.sensorId, typeFromId(entry.sensorId), {}});
+            streams[it->second].samples.push_back(
+                RecordedSample{static_cast<int64_t>(entry.timestampMs), entry.value, qualityFromFaults(entry.faults)});
+        }
+
+        for (auto &stream : streams)
+        {
+            std::stable_sort(stream.samples.begin(), stream.samples.end(),
+                             [](const RecordedSample &a, const RecordedSample &b)
+                             { return a.ts_ms < b.ts_ms; });
+        }
+        return streams;
+    }
+
+    std::unique_ptr<ReplaySensor> makeReplaySensor(const RecordedStream &stream)
+    {
+        SensorSpec spec;
+        spec.id = stream.id;
+        spec.type = stream.type.empty() ? typeFromId(stream.id) : stream.type;
+        const double period_ms = static_cast<double>(nominalPeriodMs(stream.samples));
+        spec.rate_hz = std::max(1, static_cast<int>(std::lround(1000.0 / period_ms)));
+        return std::make_unique<ReplaySensor>(spec, stream.samples);
+    }
+
+    void CaptureRecorder::record(const cppminidb::SensorLogRow &row)
+    {
+        auto [it, inserted] = index_.try_emplace(row.sensor_id, streams_.size());
+        if (inserted)
+            streams_.push_back(RecordedStream{row.sensor_id, typeFromId(row.sensor_id), {}});
+        streams_[it->second].samples.push_back(
+            RecordedSample{static_cast<int64_t>(row.timestamp_ms), row.value, qualityFromFaults(row.fault_flags)});
+    }
+
+    void CaptureRecorder::clear()
+    {
+        streams_.clear();
+        index_.clear();
+    }
+} // namespace sensor
@@ -1,113 +1,906 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
 #include <iostream>
+#include <map>
+#include <sstream>
+#include <cppminidb/Logger.hpp>
 #include "../../include/scheduler/SensorScheduler.hpp"
+#include "../../include/scheduler/SampleBus.hpp"
+
+namespace
+{
+    // Millisecond text for a µs time: "1500" or "1500.250"
+    struct MsText
+    {
+        uint64_t us;
+    };
+
+    std::ostream &operator<<(std::ostream &os, MsText t)
+    {
+        os << t.us / 1000;
+        if (t.us % 1000 != 0)
+        {
+            const char fill = os.fill('0');
+            os << '.' << std::setw(3) << t.us % 1000;
+            os.fill(fill);
+        }
+        return os;
+    }
+
+    constexpr std::string_view kComponent = "SensorScheduler";
+}
 
 namespace sensor
 {
+    using cppminidb::logError;
+    using cppminidb::logInfo;
+    using cppminidb::logWarn;
+
+    SensorScheduler::SensorScheduler() : shards_(1) {}
+
+    SensorScheduler::~SensorScheduler()
+    {
+        stopWorkers();
+    }
+
     void SensorScheduler::addScheduledSensor(const std::string &id, ISensor *sensor, uint64_t period_ms)
     {
-        if (schedule_.count(id))
+        addScheduledSensorUs(id, sensor, period_ms * 1000);
+    }
+
+    void SensorScheduler::addScheduledSensorAtRate(const std::string &id, ISensor *sensor)
+    {
+        const int rate = sensor ? sensor->rateHz() : 0;
+        if (rate <= 0)
         {
-            std::cout << "Sensor already exists: " << id << "\n";
+            logWarn(kComponent) << "Invalid rate for " << id << ": must be greater than 0 Hz";
             return;
         }
+        addScheduledSensorUs(id, sensor, (1'000'000 + rate / 2) / rate);
+    }
 
-        SensorEntry entry;
+    void SensorScheduler::addScheduledSensorUs(const std::string &id, ISensor *sensor, uint64_t period_us)
+    {
+        if (index_.count(id))
+        {
+            logInfo(kComponent) << "Sensor already exists: " << id;
+            return;
+        }
+        if (!sensor)
+        {
+            logError(kComponent) << "NULL sensor for id=" << id;
+            return;
+        }
+        if (period_us == 0)
+        {
+            logWarn(kComponent) << "Invalid period for " << id << ": must be greater than 0 ms";
+            return;
+        }
+
+        std::size_t slot;
+        if (!free_slots_.empty())
+        {
+            slot = free_slots_.back();
+            free_slots_.pop_back();
+        }
+        else
+        {
+            slot = slots_.size();
+            slots_.emplace_back();
+        }
+
+        SensorEntry &entry = slots_[slot];
+        entry.id = id;
+        entry.handle = sensor->handle();
         entry.sensor = sensor;
-        entry.period_ms = period_ms;
-        entry.next_sample_time_ms = current_time_ms_;
-        schedule_[id] = std::move(entry);
-        std::cout << "Sensor scheduled: " << id << " (period: " << period_ms << " ms)\n";
+        entry.period_us = period_us;
+        entry.next_sample_time_us = current_time_us_;
+        entry.order = next_order_++;
+        index_[id] = slot;
+        shardFor(slot).queue.push({entry.next_sample_time_us, entry.order, slot, entry.generation});
+
+        logInfo(kComponent) << "Sensor scheduled: " << id << " (period: " << MsText{period_us} << " ms, next at: "
+                            << MsText{entry.next_sample_time_us} << " ms)";
+    }
+
+    void SensorScheduler::reserve(std::size_t sensors)
+    {
+        slots_.reserve(sensors);
+        index_.reserve(sensors);
+    }
+
+    std::size_t SensorScheduler::addScheduledSensors(std::span<const BulkSensor> sensors)
+    {
+        reserve(index_.size() + sensors.size());
 
-        for (auto &[id, entry] : schedule_)
+        std::vector<std::vector<DueEvent>> pending(shards_.size());
+        std::size_t added = 0;
+        for (const auto &bulk : sensors)
         {
-            std::cout << "  " << id << " (period: " << entry.period_ms << " ms, next at: " << entry.next_sample_time_ms << " ms)\n";
+            if (!bulk.sensor || bulk.period_us == 0 || !index_.emplace(bulk.id, 0).second)
+                continue;
+
+            std::size_t slot;
+            if (!free_slots_.empty())
+            {
+                slot = free_slots_.back();
+                free_slots_.pop_back();
+            }
+            else
+            {
+                slot = slots_.size();
+                slots_.emplace_back();
+            }
+            index_[bulk.id] = slot;
+
+            SensorEntry &entry = slots_[slot];
+            entry.id = bulk.id;
+            entry.handle = bulk.sensor->handle();
+            entry.sensor = bulk.sensor;
+            entry.period_us = bulk.period_us;
+            entry.next_sample_time_us = current_time_us_;
+            entry.order = next_order_++;
+            pending[slot % shards_.size()].push_back({entry.next_sample_time_us, entry.order, slot, entry.generation});
+            ++added;
+        }
+
+        for (std::size_t i = 0; i < shards_.size(); ++i)
+        {
+            Shard &shard = shards_[i];
+            if (shard.queue.empty())
+            {
+                shard.queue = decltype(shard.queue)(LaterFirst{}, std::move(pending[i])); // O(n) heapify
+                continue;
+            }
+            for (const auto &event : pending[i])
+                shard.queue.push(event);
         }
+
+        auto line = logInfo(kComponent);
+        line << "Sensors scheduled: " << added;
+        if (added < sensors.size())
+            line << " (" << sensors.size() - added << " skipped)";
+        return added;
+    }
+
+    std::size_t SensorScheduler::addSensorPool(ISensorPool &pool, uint64_t period_us)
+    {
+        if (period_us == 0)
+        {
+            logWarn(kComponent) << "Invalid period for sensor pool: must be greater than 0 ms";
+            return 0;
+        }
+
+        pool.seal();
+        const std::size_t index = pools_.size();
+        PoolEntry entry{&pool, {}, {}, {}, 0, period_us, current_time_us_, next_order_++, {}};
+        entry.slots.assign(pool.size(), kNoPool);
+        entry.generations.assign(pool.size(), 0);
+        entry.live_mask.assign(pool.size(), 0);
+        entry.out.resize(pool.size());
+        reserve(index_.size() + pool.size());
+
+        for (std::size_t i = 0; i < pool.size(); ++i)
+        {
+            ISensor &sensor = pool.member(i);
+            std::string id = sensor.id();
+            if (!index_.emplace(id, 0).second)
+                continue;
+
+            std::size_t slot;
+            if (!free_slots_.empty())
+            {
+                slot = free_slots_.back();
+                free_slots_.pop_back();
+            }
+            else
+            {
+                slot = slots_.size();
+                slots_.emplace_back();
+            }
+            index_[id] = slot;
+
+            SensorEntry &member = slots_[slot];
+            member.id = std::move(id);
+            member.handle = sensor.handle();
+            member.sensor = &sensor;
+            member.period_us = period_us;
+            member.next_sample_time_us = current_time_us_;
+            member.order = entry.order;
+            member.pool = index;
+            member.pool_member = i;
+            entry.slots[i] = slot;
+            entry.generations[i] = member.generation;
+            entry.live_mask[i] = 1;
+            ++entry.live;
+        }
+
+        const std::size_t added = entry.live;
+        pools_.push_back(std::move(entry));
+        if (added > 0)
+            shardForPool(index).queue.push({current_time_us_, pools_[index].order, 0, 0, index});
+
+        auto line = logInfo(kComponent);
+        line << "Sensor pool scheduled: " << added << " sensors (period: " << MsText{period_us} << " ms)";
+        if (added < pool.size())
+            line << " (" << pool.size() - added << " skipped)";
+        return added;
     }
 
     void SensorScheduler::removeSensor(const std::string &id)
     {
-        if (schedule_.erase(id))
+        if (unschedule(id))
         {
-            std::cout << "Sensor removed: " << id << "\n";
+            logInfo(kComponent) << "Sensor removed: " << id;
         }
         else
         {
-            std::cout << "Sensor not found: " << id << "\n";
+            logInfo(kComponent) << "Sensor not found: " << id;
         }
     }
 
+    bool SensorScheduler::unschedule(const std::string &id)
+    {
+        auto it = index_.find(id);
+        if (it == index_.end())
+            return false;
+
+        const std::size_t slot = it->second;
+        SensorEntry &entry = slots_[slot];
+        const std::size_t pool = entry.pool;
+        if (pool != kNoPool)
+            pools_[pool].live_mask[entry.pool_member] = 0;
+        entry.sensor = nullptr;
+        entry.id.clear();
+        entry.pool = kNoPool;
+        ++entry.generation;
+        if (slot < stats_.size())
+            stats_[slot].reset();
+        if (slot < detectors_.size())
+            detectors_[slot].reset();
+        free_slots_.push_back(slot);
+        index_.erase(it);
+
+        // Pool members share the pool's event, which goes stale with its last member.
+        if (pool != kNoPool && --pools_[pool].live > 0)
+            return true;
+
+        // The sensor's pending event stays in the heap until popped or compacted.
+        Shard &shard = pool != kNoPool ? shardForPool(pool) : shardFor(slot);
+        ++shard.stale_events;
+        if (shard.stale_events > 64 && shard.stale_events > index_.size() / shards_.size())
+            compactQueue(shard);
+        return true;
+    }
+
     void SensorScheduler::tick(uint64_t delta_ms)
     {
-        current_time_ms_ += delta_ms;
+        tickUs(delta_ms * 1000);
+    }
+
+    void SensorScheduler::tickUs(uint64_t delta_us)
+    {
+        const uint64_t target_us = current_time_us_ + delta_us;
 
-        for (auto &[id, entry] : schedule_)
+        // Stop short of each queued fault so it applies from its own time onward
+        while (!fault_queue_.empty() && fault_queue_.top().at_us <= target_us)
         {
-            if (!entry.sensor)
+            const uint64_t at_us = fault_queue_.top().at_us;
+            if (at_us > current_time_us_ + 1)
+                advanceTo(at_us - 1);
+            current_time_us_ = std::max(current_time_us_, at_us);
+            dispatchFaults(at_us);
+        }
+        advanceTo(target_us);
+    }
+
+    void SensorScheduler::advanceTo(uint64_t now_us)
+    {
+        current_time_us_ = now_us;
+
+        if (!workers_.empty())
+        {
+            tickSharded();
+            return;
+        }
+
+        Shard &shard = shards_.front();
+        while (!shard.queue.empty() && shard.queue.top().due_us <= current_time_us_)
+        {
+            const DueEvent event = shard.queue.top();
+            shard.queue.pop();
+            if (!isLive(event))
             {
-                std::cerr << "NULL sensor for id=" << id << "\n";
+                --shard.stale_events;
                 continue;
             }
-            if (getNow() > entry.next_sample_time_ms)
+
+            // Re-arm before emitting so callbacks may safely add or remove sensors.
+            if (event.pool != kNoPool)
             {
-                auto sample = entry.sensor->nextSample(getNow());
-                std::cout << "[Tick @ " << getNow() << "]  "
-                          << "Sensor " << entry.sensor->id() << " → value: " << sample.value << "\n";
-                entry.next_sample_time_ms += entry.period_ms;
+                PoolEntry &pool = pools_[event.pool];
+                pool.next_sample_time_us = event.due_us + pool.period_us;
+                shard.queue.push({pool.next_sample_time_us, pool.order, 0, 0, event.pool});
+                emitPool(event.pool, event.due_us);
+                continue;
+            }
+            SensorEntry &entry = slots_[event.slot];
+            entry.next_sample_time_us = event.due_us + entry.period_us;
+            shard.queue.push({entry.next_sample_time_us, entry.order, event.slot, entry.generation});
+
+            emitSample(event.slot, event.due_us);
+        }
+    }
+
+    std::size_t SensorScheduler::scheduleFaults(std::span<const FaultEvent> events)
+    {
+        std::vector<QueuedFault> queued;
+        queued.reserve(events.size());
+        for (const auto &event : events)
+        {
+            auto it = index_.find(event.sensor_id);
+            if (it == index_.end())
+                continue;
+            queued.push_back({event.at_us, next_fault_order_++, it->second, slots_[it->second].generation, event.kind,
+                              event.mag, event.sigma, event.duration_ms});
+        }
 
-                if (db_)
+        const std::size_t added = queued.size();
+        if (fault_queue_.empty())
+        {
+            fault_queue_ = decltype(fault_queue_)(LaterFault{}, std::move(queued)); // O(n) heapify
+        }
+        else
+        {
+            for (const auto &fault : queued)
+                fault_queue_.push(fault);
+        }
+        return added;
+    }
+
+    bool SensorScheduler::injectFault(const FaultEvent &event)
+    {
+        ISensor *sensor = findSensor(event.sensor_id);
+        if (!sensor)
+            return false;
+        triggerFault(*sensor, event.kind, event.mag, event.sigma, event.duration_ms, current_time_us_);
+        return true;
+    }
+
+    void SensorScheduler::dispatchFaults(uint64_t now_us)
+    {
+        while (!fault_queue_.empty() && fault_queue_.top().at_us <= now_us)
+        {
+            const QueuedFault fault = fault_queue_.top();
+            fault_queue_.pop();
+            const SensorEntry &entry = slots_[fault.slot];
+            if (!entry.sensor || entry.generation != fault.generation)
+                continue;
+            triggerFault(*entry.sensor, fault.kind, fault.mag, fault.sigma, fault.duration_ms, fault.at_us);
+        }
+    }
+
+    void SensorScheduler::triggerFault(ISensor &sensor, FaultKind kind, double mag, double sigma,
+                                       int64_t duration_ms, uint64_t at_us)
+    {
+        const auto now_ms = static_cast<int64_t>(at_us / 1000);
+        switch (kind)
+        {
+        case FaultKind::Spike:
+            sensor.triggerSpikeFault(mag, sigma, now_ms);
+            ++injected_faults_.spike;
+            break;
+        case FaultKind::Stuck:
+        {
+            const auto history = sensor.getHistory();
+            const double current = history.empty() ? sensor.getSpec().base_level : history.back();
+            sensor.triggerStuckFault(duration_ms, now_ms, current);
+            ++injected_faults_.stuck;
+            break;
+        }
+        case FaultKind::Dropout:
+            sensor.triggerDropoutFault(now_ms, duration_ms);
+            ++injected_faults_.dropout;
+            break;
+        }
+    }
+
+    void SensorScheduler::tickSharded()
+    {
+        // A callback may schedule a sensor due now; inline mode samples it in this tick
+        // too, after every other due sample, so run rounds until nothing is due.
+        do
+        {
+            // Generation phase: every worker drains its own shard up to current_time_us_.
+            {
+                std::unique_lock<std::mutex> lock(pool_mtx_);
+                busy_ = workers_.size();
+                ++epoch_;
+                work_cv_.notify_all();
+                done_cv_.wait(lock, [this]
+                              { return busy_ == 0; });
+            }
+            mergeShards();
+        } while (shardsDue());
+    }
+
+    bool SensorScheduler::shardsDue() const
+    {
+        for (const auto &shard : shards_)
+        {
+            if (!shard.queue.empty() && shard.queue.top().due_us <= current_time_us_)
+                return true;
+        }
+        return false;
+    }
+
+    void SensorScheduler::mergeShards()
+    {
+        // A sensor that threw on a worker stops the merge where inline mode would have
+        // stopped: samples ordered before the failing event are still emitted.
+        std::exception_ptr error;
+        DueEvent failed{};
+        for (auto &shard : shards_)
+        {
+            if (shard.error && (!error || LaterFirst{}(failed, shard.current)))
+            {
+                error = shard.error;
+                failed = shard.current;
+            }
+            shard.error = nullptr;
+        }
+
+        // Merge phase: each shard's output is already in (due, order) order, so a
+        // k-way merge reproduces the inline emission order.
+        struct Cursor
+        {
+            DueEvent event;
+            std::size_t shard;
+            std::size_t pos;
+        };
+        auto later = [](const Cursor &a, const Cursor &b)
+        { return LaterFirst{}(a.event, b.event); };
+        std::priority_queue<Cursor, std::vector<Cursor>, decltype(later)> heads(later);
+        for (std::size_t i = 0; i < shards_.size(); ++i)
+        {
+            if (!shards_[i].generated.empty())
+                heads.push({shards_[i].generated.front().event, i, 0});
+        }
+
+        while (!heads.empty())
+        {
+            const Cursor cur = heads.top();
+            if (error && !LaterFirst{}(failed, cur.event))
+                break;
+            heads.pop();
+            const auto &generated = shards_[cur.shard].generated;
+            const GeneratedSample &sample = generated[cur.pos];
+
+            // A callback earlier in this merge may have removed the sensor.
+            if (isLive(sample.event))
+                publishSample(sample.event.slot, sample.event.due_us, sample.value, sample.faults,
+                              std::span<const double>(sample.channels.data(), sample.channel_count));
+
+            if (cur.pos + 1 < generated.size())
+                heads.push({generated[cur.pos + 1].event, cur.shard, cur.pos + 1});
+        }
+
+        if (error)
+            requeueUnmerged(failed);
+        for (auto &shard : shards_)
+            shard.generated.clear();
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    void SensorScheduler::requeueUnmerged(const DueEvent &failed)
+    {
+        // Workers already sampled and re-armed sensors past the failure. Inline mode
+        // would not have reached them yet, so put each one back at its earliest
+        // unmerged due time; the next tick samples it again.
+        for (auto &shard : shards_)
+        {
+            std::map<std::size_t, uint64_t> slots, pools; // slot / pool -> earliest unmerged due
+            for (const auto &sample : shard.generated)
+            {
+                if (LaterFirst{}(failed, sample.event) || !isLive(sample.event))
+                    continue;
+                const std::size_t pool = slots_[sample.event.slot].pool;
+                auto &restore = pool != kNoPool ? pools : slots;
+                const std::size_t key = pool != kNoPool ? pool : sample.event.slot;
+                auto [it, inserted] = restore.try_emplace(key, sample.event.due_us);
+                it->second = std::min(it->second, sample.event.due_us);
+            }
+            if (slots.empty() && pools.empty())
+                continue;
+
+            // Drop the re-armed events of those sensors; each live sensor has exactly one
+            std::vector<DueEvent> kept;
+            kept.reserve(shard.queue.size());
+            for (; !shard.queue.empty(); shard.queue.pop())
+            {
+                const DueEvent &event = shard.queue.top();
+                const bool rearmed = isLive(event) && (event.pool != kNoPool ? pools.count(event.pool)
+                                                                             : slots.count(event.slot));
+                if (!rearmed)
+                    kept.push_back(event);
+            }
+            for (const auto &[slot, due] : slots)
+            {
+                SensorEntry &entry = slots_[slot];
+                entry.next_sample_time_us = due;
+                kept.push_back({due, entry.order, slot, entry.generation});
+            }
+            for (const auto &[pool, due] : pools)
+            {
+                pools_[pool].next_sample_time_us = due;
+                kept.push_back({due, pools_[pool].order, 0, 0, pool});
+            }
+            shard.queue = decltype(shard.queue)(LaterFirst{}, std::move(kept));
+        }
+    }
+
+    void SensorScheduler::generateShard(Shard &shard, uint64_t now_us)
+    {
+        const bool wantFaults = faultsWanted();
+        while (!shard.queue.empty() && shard.queue.top().due_us <= now_us)
+        {
+            const DueEvent event = shard.queue.top();
+            shard.queue.pop();
+            if (!isLive(event))
+            {
+                --shard.stale_events;
+                continue;
+            }
+            shard.current = event;
+
+            const auto ts_ms = static_cast<int64_t>(event.due_us / 1000);
+            if (event.pool != kNoPool)
+            {
+                PoolEntry &pool = pools_[event.pool];
+                pool.next_sample_time_us = event.due_us + pool.period_us;
+                shard.queue.push({pool.next_sample_time_us, pool.order, 0, 0, event.pool});
+
+                pool.pool->sampleAll(ts_ms, wantFaults, pool.live_mask.data(), pool.out.data());
+                for (std::size_t i = 0; i < pool.slots.size(); ++i)
                 {
-                    auto faults = entry.sensor->getActiveFaults(getNow());
-                    db_->appendLog(id, getNow(), sample.value, faults);
+                    if (!memberLive(pool, i))
+                        continue;
+                    GeneratedSample out{{event.due_us, pool.order, pool.slots[i], pool.generations[i]}, pool.out[i].value, {}, {}, 0};
+                    if (wantFaults)
+                        appendFaultNames(pool.out[i].fault_flags, out.faults);
+                    shard.generated.push_back(std::move(out));
                 }
+                continue;
+            }
 
-                if (onSample)
-                {
-                    cppminidb::SensorLogRow row;
-                    row.timestamp_ms = getNow();
-                    row.sensor_id = id;
-                    row.value = sample.value;
-                    row.fault_flags = entry.sensor->getActiveFaults(getNow());
+            SensorEntry &entry = slots_[event.slot];
+            entry.next_sample_time_us = event.due_us + entry.period_us;
+            shard.queue.push({entry.next_sample_time_us, entry.order, event.slot, entry.generation});
 
-                    onSample(row);
-                }
+            GeneratedSample out{event, entry.sensor->nextSample(ts_ms).value, {}, {}, 0};
+            const auto channels = entry.sensor->channelValues();
+            out.channel_count = std::min(channels.size(), kMaxChannels);
+            std::copy_n(channels.begin(), out.channel_count, out.channels.begin());
+            if (wantFaults)
+                out.faults = entry.sensor->getActiveFaults(ts_ms);
+            shard.generated.push_back(std::move(out));
+        }
+    }
+
+    void SensorScheduler::workerLoop(std::size_t shard, uint64_t seen)
+    {
+        std::unique_lock<std::mutex> lock(pool_mtx_);
+        while (true)
+        {
+            work_cv_.wait(lock, [&]
+                          { return stopping_ || epoch_ != seen; });
+            if (stopping_)
+                return;
+            seen = epoch_;
+            const uint64_t now = current_time_us_;
+
+            lock.unlock();
+            try
+            {
+                generateShard(shards_[shard], now);
+            }
+            catch (...)
+            {
+                // Rethrown by tick() on its own thread; an escaping exception would terminate
+                shards_[shard].error = std::current_exception();
+            }
+            lock.lock();
+
+            if (--busy_ == 0)
+                done_cv_.notify_one();
+        }
+    }
+
+    void SensorScheduler::setWorkerThreads(std::size_t threads)
+    {
+        const std::size_t shardCount = threads > 1 ? threads : 1;
+        if (shardCount == shards_.size())
+            return;
+
+        stopWorkers();
+
+        // Re-partition the pending events; each live sensor has exactly one.
+        shards_.assign(shardCount, Shard{});
+        for (std::size_t slot = 0; slot < slots_.size(); ++slot)
+        {
+            const SensorEntry &entry = slots_[slot];
+            if (entry.sensor && entry.pool == kNoPool)
+                shardFor(slot).queue.push({entry.next_sample_time_us, entry.order, slot, entry.generation});
+        }
+        for (std::size_t p = 0; p < pools_.size(); ++p)
+        {
+            if (pools_[p].live > 0)
+                shardForPool(p).queue.push({pools_[p].next_sample_time_us, pools_[p].order, 0, 0, p});
+        }
+
+        if (shardCount > 1)
+        {
+            std::lock_guard<std::mutex> lock(pool_mtx_);
+            stopping_ = false;
+            for (std::size_t i = 0; i < shardCount; ++i)
+                workers_.emplace_back(&SensorScheduler::workerLoop, this, i, epoch_);
+        }
+    }
+
+    std::size_t SensorScheduler::workerThreads() const
+    {
+        return workers_.size();
+    }
+
+    void SensorScheduler::stopWorkers()
+    {
+        {
+            std::lock_guard<std::mutex> lock(pool_mtx_);
+            stopping_ = true;
+        }
+        work_cv_.notify_all();
+        for (auto &worker : workers_)
+            worker.join();
+        workers_.clear();
+    }
+
+    void SensorScheduler::emitSample(std::size_t slot, uint64_t timestamp_us)
+    {
+        ISensor *sensor = slots_[slot].sensor;
+        // Sensors and storage work in milliseconds
+        const auto ts_ms = static_cast<int64_t>(timestamp_us / 1000);
+        const auto sample = sensor->nextSample(ts_ms);
+
+        std::vector<std::string> faults;
+        if (faultsWanted())
+            faults = sensor->getActiveFaults(ts_ms);
+        publishSample(slot, timestamp_us, sample.value, faults, sensor->channelValues());
+    }
+
+    void SensorScheduler::emitPool(std::size_t pool, uint64_t timestamp_us)
+    {
+        const auto ts_ms = static_cast<int64_t>(timestamp_us / 1000);
+        const bool wantFaults = faultsWanted();
+        pools_[pool].pool->sampleAll(ts_ms, wantFaults, pools_[pool].live_mask.data(), pools_[pool].out.data());
+
+        // Index pools_ afresh each time: callbacks may schedule another pool.
+        for (std::size_t i = 0; i < pools_[pool].slots.size(); ++i)
+        {
+            const PoolEntry &entry = pools_[pool];
+            if (!memberLive(entry, i))
+                continue;
+            pool_faults_.clear();
+            if (wantFaults)
+                appendFaultNames(entry.out[i].fault_flags, pool_faults_);
+            const double value = entry.out[i].value;
+            publishSample(entry.slots[i], timestamp_us, value, pool_faults_, {});
+        }
+    }
+
+    void SensorScheduler::publishSample(std::size_t slot, uint64_t timestamp_us, double value,
+                                        const std::vector<std::string> &faults, std::span<const double> channels)
+    {
+        const SensorEntry &entry = slots_[slot];
+
+        // Copy into the reused row: callbacks may remove the sensor and clear entry.id.
+        row_.timestamp_ms = timestamp_us / 1000;
+        row_.timestamp_us = timestamp_us;
+        row_.sensor_id.assign(entry.id);
+        row_.sensor_handle = entry.handle;
+        row_.value = value;
+        row_.fault_flags.assign(faults.begin(), faults.end());
+        row_.channels.assign(channels.begin(), channels.end());
+        if (detect_ && !std::isnan(value))
+        {
+            if (slot >= detectors_.size())
+                detectors_.resize(slots_.size(), AnomalyDetector(detector_config_));
+            appendFaultNames(runDetector(detectors_[slot], static_cast<int64_t>(row_.timestamp_ms), value),
+                             row_.fault_flags);
+        }
+
+        ++samples_emitted_;
+        if (stats_enabled_)
+        {
+            if (slot >= stats_.size())
+                stats_.resize(slots_.size());
+            stats_[slot].add(value, !row_.fault_flags.empty());
+        }
+
+        // Debug only: formatting a line per sample dominates tick() on large fleets
+        if (echo_samples_ && cppminidb::Logger::instance().enabled(cppminidb::LogLevel::Debug))
+        {
+            std::ostringstream line;
+            line << "[Tick @ " << MsText{timestamp_us} << "]  "
+                 << "Sensor " << sensorName(entry.handle) << " → value: " << value;
+            for (std::size_t c = 1; c < channels.size(); ++c)
+                line << ", " << channels[c];
+            cppminidb::Logger::instance().log(cppminidb::LogLevel::Debug, kComponent, std::move(line).str());
+        }
+
+        if (db_)
+        {
+            if (channels.size() > 1)
+                db_->appendLog(row_.sensor_id, row_.timestamp_ms, channels, row_.fault_flags);
+            else
+                db_->appendLog(row_.sensor_id, row_.timestamp_ms, value, row_.fault_flags);
+        }
+
+        if (bus_)
+        {
+            bus_->publish(row_);
+        }
+
+        if (onSample)
+        {
+            onSample(row_);
+        }
+    }
+
+    uint8_t SensorScheduler::runDetector(AnomalyDetector &detector, int64_t ts_ms, double value)
+    {
+        using Clock = std::chrono::steady_clock;
+        // Reading the clock costs more than a check, so only every Nth sample is timed.
+        const bool timed = ++detector_samples_ % kDetectorTimingInterval == 0;
+        uint8_t flags = QF_OK;
+        for (std::size_t stage = 0; stage < AnomalyDetector::kStages; ++stage)
+        {
+            const auto start = timed ? Clock::now() : Clock::time_point{};
+            uint8_t found;
+            switch (stage)
+            {
+            case AnomalyDetector::ZScore:
+                found = detector.zscore(value);
+                break;
+            case AnomalyDetector::Flatline:
+                found = detector.flatline(value);
+                break;
+            default:
+                found = detector.rate(ts_ms, value);
+                break;
+            }
+
+            DetectorCost &cost = detector_costs_[stage];
+            if (timed)
+            {
+                const auto ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+                cost.timed_ns += ns > timer_overhead_ns_ ? ns - timer_overhead_ns_ : 0;
+                ++cost.timed;
             }
+            ++cost.checks;
+            cost.flagged += found != QF_OK;
+            flags |= found;
         }
+        return flags;
+    }
+
+    void SensorScheduler::enableAnomalyDetection(const AnomalyConfig &config)
+    {
+        detector_config_ = config;
+        detectors_.assign(slots_.size(), AnomalyDetector(config));
+        detector_costs_ = {};
+        detector_samples_ = 0;
+        detect_ = true;
+
+        // Cost of the clock reads themselves, taken off every timed stage
+        using Clock = std::chrono::steady_clock;
+        timer_overhead_ns_ = UINT64_MAX;
+        for (int i = 0; i < 32; ++i)
+        {
+            const auto start = Clock::now();
+            const auto ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+            timer_overhead_ns_ = std::min(timer_overhead_ns_, ns);
+        }
+    }
+
+    void SensorScheduler::disableAnomalyDetection()
+    {
+        detect_ = false;
+        detectors_.clear();
+    }
+
+    bool SensorScheduler::isLive(const DueEvent &event) const
+    {
+        if (event.pool != kNoPool)
+            return pools_[event.pool].live > 0;
+        const SensorEntry &entry = slots_[event.slot];
+        return entry.sensor && entry.generation == event.generation;
+    }
+
+    bool SensorScheduler::memberLive(const PoolEntry &pool, std::size_t member) const
+    {
+        return pool.live_mask[member] != 0;
+    }
+
+    void SensorScheduler::compactQueue(Shard &shard)
+    {
+        std::vector<DueEvent> live;
+        live.reserve(shard.queue.size() - shard.stale_events);
+        while (!shard.queue.empty())
+        {
+            if (isLive(shard.queue.top()))
+                live.push_back(shard.queue.top());
+            shard.queue.pop();
+        }
+        shard.queue = decltype(shard.queue)(LaterFirst{}, std::move(live));
+        shard.stale_events = 0;
     }
 
     void SensorScheduler::listSensorStates() const
     {
         std::cout << "Scheduled Sensors:\n";
-        for (const auto &[id, entry] : schedule_)
+        for (const auto &entry : slots_)
         {
-            std::cout << "  " << id << " (period: " << entry.period_ms
-                      << " ms, next at: " << entry.next_sample_time_ms << " ms)\n";
+            if (!entry.sensor)
+                continue;
+            const uint64_t next_us = entry.pool != kNoPool ? pools_[entry.pool].next_sample_time_us : entry.next_sample_time_us;
+            std::cout << "  " << entry.id << " (period: " << MsText{entry.period_us}
+                      << " ms, next at: " << MsText{next_us} << " ms)\n";
         }
     }
 
     std::vector<std::string> SensorScheduler::getSensorIds() const
     {
         std::vector<std::string> ids;
-        ids.reserve(schedule_.size());
-        for (const auto &pair : schedule_)
+        ids.reserve(index_.size());
+        for (const auto &entry : slots_)
         {
-            ids.push_back(pair.first);
+            if (entry.sensor)
+                ids.push_back(entry.id);
         }
         return ids;
     }
 
+    ISensor *SensorScheduler::findSensor(const std::string &id) const
+    {
+        auto it = index_.find(id);
+        return it != index_.end() ? slots_[it->second].sensor : nullptr;
+    }
+
+    const OnlineStats *SensorScheduler::getSensorStats(const std::string &id) const
+    {
+        static const OnlineStats kNoSamples;
+        auto it = index_.find(id);
+        if (it == index_.end())
+            return nullptr;
+        return it->second < stats_.size() ? &stats_[it->second] : &kNoSamples;
+    }
+
     SimpleSensor *SensorScheduler::getScheduledSensor(const std::string &id) const
     {
-        auto it = schedule_.find(id);
-        if (it != schedule_.end())
-        {
-            return dynamic_cast<SimpleSensor *>(it->second.sensor);
-        }
-        return nullptr;
+        return dynamic_cast<SimpleSensor *>(findSensor(id));
     }
 
     uint64_t SensorScheduler::getNow() const
     {
-        return current_time_ms_;
+        return current_time_us_ / 1000;
+    }
+
+    uint64_t SensorScheduler::getNowUs() const
+    {
+        return current_time_us_;
     }
 
     void SensorScheduler::setDatabase(MiniDB *db)
@@ -115,13 +908,16 @@ namespace sensor
         db_ = db;
     }
 
+    void SensorScheduler::setSampleBus(SampleBus *bus)
+    {
+        bus_ = bus;
+    }
+
     void SensorScheduler::removeScheduledSensor(const std::string &id)
     {
-        auto it = schedule_.find(id);
-        if (it != schedule_.end())
+        if (unschedule(id))
         {
-            schedule_.erase(it);
-            std::cout << "Sensor unscheduled: " << id << "\n";
+            logInfo(kComponent) << "Sensor unscheduled: " << id;
         }
     }
 
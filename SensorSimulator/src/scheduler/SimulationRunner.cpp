@@ -0,0 +1,138 @@
+#include "../../include/scheduler/SimulationRunner.hpp"
+
+#include <cctype>
+#include <iomanip>
+#include <limits>
+
+namespace sensor
+{
+    void printReport(std::ostream &os, const SimulationReport &report)
+    {
+        const auto flags = os.flags();
+        const auto precision = os.precision();
+        os << std::fixed << std::setprecision(3)
+           << "Simulated " << report.simulated_ms << " ms in " << report.wall_seconds << " s ("
+           << report.ticks << " ticks, " << report.samples << " samples)\n"
+           << std::setprecision(1)
+           << "Throughput: " << report.samplesPerSecond() << " samples/s, speedup "
+           << report.speedup() << "x\n";
+        if (report.jitter.count() > 0)
+        {
+            os << "Tick jitter: mean " << report.jitter.meanUs() << " us, stddev " << report.jitter.stddevUs()
+               << " us, max " << report.jitter.maxUs() << " us\n";
+        }
+        os.flags(flags);
+        os.precision(precision);
+    }
+
+    void printStats(std::ostream &os, const std::string &id, const OnlineStats &stats)
+    {
+        if (stats.count() == 0)
+        {
+            os << id << ": no valid samples";
+            if (stats.missing() > 0)
+                os << " (" << stats.missing() << " missing)";
+            os << "\n";
+            return;
+        }
+        const auto flags = os.flags();
+        const auto precision = os.precision();
+        os << std::fixed << std::setprecision(3)
+           << id << ": " << stats.count() << " samples, " << stats.missing() << " missing, " << stats.faulted()
+           << " faulted, last " << stats.last()
+           << ", mean " << stats.mean() << ", stddev " << stats.stddev() << "\n"
+           << "  min " << stats.min() << ", max " << stats.max() << ", ewma " << stats.ewma()
+           << ", p50 " << stats.p50() << ", p95 " << stats.p95() << ", p99 " << stats.p99() << "\n";
+        os.flags(flags);
+        os.precision(precision);
+    }
+
+    void printDetectorCosts(std::ostream &os, const std::array<SensorScheduler::DetectorCost, AnomalyDetector::kStages> &costs)
+    {
+        const auto flags = os.flags();
+        const auto precision = os.precision();
+        os << std::fixed << std::setprecision(1);
+        for (std::size_t stage = 0; stage < costs.size(); ++stage)
+        {
+            os << "Detector " << AnomalyDetector::kStageNames[stage] << ": " << costs[stage].checks << " checks, "
+               << costs[stage].flagged << " flagged, " << costs[stage].nsPerCheck() << " ns/check\n";
+        }
+        os.flags(flags);
+        os.precision(precision);
+    }
+
+    std::optional<uint64_t> parseDurationMs(const std::string &text)
+    {
+        std::size_t digits = 0;
+        while (digits < text.size() && std::isdigit(static_cast<unsigned char>(text[digits])))
+            ++digits;
+        if (digits == 0 || digits > 18)
+            return std::nullopt;
+
+        const uint64_t amount = std::stoull(text.substr(0, digits));
+        const std::string unit = text.substr(digits);
+        uint64_t scale = 0;
+        if (unit.empty() || unit == "ms")
+            scale = 1;
+        else if (unit == "s")
+            scale = 1000;
+        else if (unit == "m")
+            scale = 60'000;
+        else if (unit == "h")
+            scale = 3'600'000;
+        else if (unit == "d")
+            scale = 86'400'000;
+        else
+            return std::nullopt;
+
+        // The scheduler keeps microseconds, so the duration must fit there too
+        if (amount > std::numeric_limits<uint64_t>::max() / 1000 / scale)
+            return std::nullopt;
+        return amount * scale;
+    }
+
+    SimulationReport SimulationRunner::run(uint64_t duration_ms)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            stop_ = false;
+        }
+
+        SimulationReport report;
+        const uint64_t samplesBefore = scheduler_.samplesEmitted();
+        const auto start = SimulationClock::WallClock::now();
+
+        while (duration_ms == 0 || report.simulated_ms < duration_ms)
+        {
+            const uint64_t step = duration_ms == 0 ? tick_ms_ : std::min(tick_ms_, duration_ms - report.simulated_ms);
+            scheduler_.tick(step);
+            report.simulated_ms += step;
+            ++report.ticks;
+
+            std::unique_lock<std::mutex> lock(mtx_);
+            if (clock_.paced())
+            {
+                const auto deadline = clock_.deadline(start, report.simulated_ms);
+                if (cv_.wait_until(lock, deadline, [this]
+                                   { return stop_; }))
+                    break;
+                report.jitter.record(SimulationClock::WallClock::now() - deadline);
+            }
+            if (stop_)
+                break;
+        }
+
+        report.samples = scheduler_.samplesEmitted() - samplesBefore;
+        report.wall_seconds = std::chrono::duration<double>(SimulationClock::WallClock::now() - start).count();
+        return report;
+    }
+
+    void SimulationRunner::stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+    }
+} // namespace sensor
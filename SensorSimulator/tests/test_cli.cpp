@@ -1,9 +1,56 @@
 #include <catch2/catch_all.hpp>
 #include "cli/EdgeShell.hpp"
+#include "scheduler/SensorScheduler.hpp"
+#include "scheduler/SimulationRunner.hpp"
+#include "scheduler/ReplayCapture.hpp"
+#include "scheduler/FleetSpec.hpp"
+#include "scheduler/FaultCampaign.hpp"
+#include "scheduler/SampleBus.hpp"
+#include "scheduler/SensorPool.hpp"
+#include "cli/commands/AddCommand.hpp"
+#include "cli/commands/StatusCommand.hpp"
+#include "cli/commands/DetectCommand.hpp"
+#include <cppminidb/Logger.hpp>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
 #include <sstream>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <thread>
 
 using namespace sensor;
 
+// Counts heap allocations made while g_countAllocations is set (any thread)
+namespace
+{
+    std::atomic<bool> g_countAllocations{false};
+    std::atomic<std::size_t> g_allocations{0};
+}
+
+void *operator new(std::size_t size)
+{
+    if (g_countAllocations.load(std::memory_order_relaxed))
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+// GCC flags free() on memory from operator new once both are inlined; here they pair up
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
 TEST_CASE("CLI add TEMP sensor", "[cli][add]")
 {
     EdgeShell shell;
@@ -28,6 +75,22 @@ TEST_CASE("CLI add PRES sensor", "[cli][add]")
     REQUIRE(sensors.at("PRES-001")->rateHz() == 1);
 }
 
+TEST_CASE("CLI log keeps the scalar schema until a multi-channel sensor is added", "[cli][add][channels]")
+{
+    MiniDB db("shell_widen_log", "./data/shell_widen_test");
+    db.setColumns(MiniDB::logColumns(), MiniDB::logColumnTypes());
+    EdgeShell shell;
+    shell.setDatabase(&db);
+
+    shell.addScheduledSensor("TEMP-002", 500);
+    REQUIRE_FALSE(db.hasColumn("value_1"));
+
+    shell.addScheduledSensor("IMU-001", 500);
+    REQUIRE(db.hasColumn("value_1"));
+    REQUIRE(db.hasColumn("value_2"));
+    REQUIRE_FALSE(db.hasColumn("value_3"));
+}
+
 TEST_CASE("CLI rejects unknown sensor type", "[cli][validation]")
 {
     EdgeShell shell;
@@ -40,7 +103,7 @@ TEST_CASE("CLI rejects unknown sensor type", "[cli][validation]")
     std::cout.rdbuf(oldCout);
 
     std::string output = buffer.str();
-    REQUIRE(output.find("Only TEMP and PRES") != std::string::npos);
+    REQUIRE(output.find("Only TEMP, PRES and IMU") != std::string::npos);
 }
 
 TEST_CASE("CLI case-insensitive sensor IDs", "[cli][add][case]")
@@ -171,6 +234,28 @@ TEST_CASE("CLI tick advances time and samples", "[cli][tick]")
     REQUIRE(output.find("[Tick @ 1000]") != std::string::npos);
 }
 
+TEST_CASE("Per-sample echo is a Debug record and vanishes at Info", "[cli][tick][logger]")
+{
+    SensorSpec spec = makeDefaultTempSpec();
+    SimpleSensor temp(spec);
+    SensorScheduler scheduler;
+
+    std::stringstream buffer;
+    std::streambuf *old = std::cout.rdbuf(buffer.rdbuf());
+    cppminidb::Logger::instance().setLevel(cppminidb::LogLevel::Info);
+    scheduler.addScheduledSensor(spec.id, &temp, 1000);
+    scheduler.tick(3000);
+    cppminidb::Logger::instance().setLevel(cppminidb::LogLevel::Debug);
+    scheduler.tick(1000);
+    std::cout.rdbuf(old);
+
+    const std::string output = buffer.str();
+    REQUIRE(output.find("Sensor scheduled: " + spec.id) != std::string::npos); // Info still shows
+    REQUIRE(output.find("[Tick @ 3000]") == std::string::npos);
+    REQUIRE(output.find("[Tick @ 4000]") != std::string::npos);
+    REQUIRE(scheduler.samplesEmitted() >= 4);
+}
+
 TEST_CASE("CLI tick advances simulation time", "[cli][tick]")
 {
     EdgeShell shell;
@@ -209,4 +294,989 @@ TEST_CASE("CLI run and stop real-time simulation via REPL", "[cli][run][stop][re
     REQUIRE(output.find("Started real-time simulation") != std::string::npos);
     REQUIRE(output.find("Stopped real-time simulation.") != std::string::npos);
     REQUIRE(output.find("TEMP-001") != std::string::npos);
-}
\ No newline at end of file
+}
+TEST_CASE("Scheduler emits every due sample in timestamp order", "[scheduler][order]")
+{
+    SensorSpec fastSpec = makeDefaultTempSpec();
+    fastSpec.id = "FAST-001";
+    SensorSpec slowSpec = makeDefaultTempSpec();
+    slowSpec.id = "SLOW-001";
+    SimpleSensor fast(fastSpec);
+    SimpleSensor slow(slowSpec);
+
+    std::stringstream buffer;
+    std::streambuf *oldCout = std::cout.rdbuf(buffer.rdbuf());
+
+    SensorScheduler scheduler;
+    std::vector<cppminidb::SensorLogRow> rows;
+    scheduler.onSample = [&rows](const cppminidb::SensorLogRow &row)
+    { rows.push_back(row); };
+    scheduler.addScheduledSensor("SLOW-001", &slow, 400);
+    scheduler.addScheduledSensor("FAST-001", &fast, 100);
+
+    // One tick spanning many periods must not drop samples of the fast sensor
+    scheduler.tick(1000);
+
+    std::cout.rdbuf(oldCout);
+
+    REQUIRE(std::count_if(rows.begin(), rows.end(), [](const auto &r)
+                          { return r.sensor_id == "FAST-001"; }) == 11);
+    REQUIRE(std::count_if(rows.begin(), rows.end(), [](const auto &r)
+                          { return r.sensor_id == "SLOW-001"; }) == 3);
+    REQUIRE(std::is_sorted(rows.begin(), rows.end(), [](const auto &a, const auto &b)
+                           { return a.timestamp_ms < b.timestamp_ms; }));
+    // Ties are broken by registration order
+    REQUIRE(rows[0].sensor_id == "SLOW-001");
+    REQUIRE(rows[1].sensor_id == "FAST-001");
+    REQUIRE(rows.back().timestamp_ms == 1000);
+
+    // Next tick continues exactly where the previous one stopped
+    rows.clear();
+    std::cout.rdbuf(buffer.rdbuf());
+    scheduler.tick(50);
+    REQUIRE(rows.empty());
+    scheduler.tick(50);
+    std::cout.rdbuf(oldCout);
+    REQUIRE(rows.size() == 1);
+    REQUIRE(rows[0].timestamp_ms == 1100);
+}
+
+TEST_CASE("Scheduler scales to many sensors and ignores removed ones", "[scheduler][scale]")
+{
+    constexpr int kSensors = 20000;
+    std::vector<std::unique_ptr<SimpleSensor>> sensors;
+    SensorScheduler scheduler;
+    std::size_t emitted = 0;
+    scheduler.onSample = [&emitted](const cppminidb::SensorLogRow &)
+    { ++emitted; };
+
+    std::stringstream buffer;
+    std::streambuf *oldCout = std::cout.rdbuf(buffer.rdbuf());
+
+    for (int i = 0; i < kSensors; ++i)
+    {
+        SensorSpec spec = makeDefaultTempSpec();
+        spec.id = "TEMP-" + std::to_string(i);
+        sensors.push_back(std::make_unique<SimpleSensor>(spec));
+        // Staggered periods so only a fraction of sensors is due per tick
+        scheduler.addScheduledSensor(spec.id, sensors.back().get(), 1000 + (i % 10) * 1000);
+    }
+    scheduler.tick(0);
+    REQUIRE(emitted == kSensors);
+
+    for (int i = 0; i < kSensors; i += 2)
+        scheduler.removeScheduledSensor("TEMP-" + std::to_string(i));
+
+    emitted = 0;
+    scheduler.tick(1000);
+    std::cout.rdbuf(oldCout);
+
+    // Only odd sensors with a 1000 ms period are due: i % 10 == 0 never holds for odd i
+    REQUIRE(emitted == 0);
+    REQUIRE(scheduler.getSensorIds().size() == kSensors / 2);
+    REQUIRE(scheduler.getScheduledSensor("TEMP-0") == nullptr);
+    REQUIRE(scheduler.getScheduledSensor("TEMP-1") != nullptr);
+
+    std::cout.rdbuf(buffer.rdbuf());
+    emitted = 0;
+    scheduler.tick(1000); // t=2000: odd i with i % 10 == 1 (period 2000)
+    std::cout.rdbuf(oldCout);
+    REQUIRE(emitted == kSensors / 10);
+}
+
+TEST_CASE("Sharded scheduler emits the same ordered stream as inline mode", "[scheduler][sharded]")
+{
+    constexpr int kSensors = 257;
+    auto makeFleet = []
+    {
+        std::vector<std::unique_ptr<SimpleSensor>> fleet;
+        for (int i = 0; i < kSensors; ++i)
+        {
+            SensorSpec spec = makeDefaultTempSpec();
+            spec.id = "TEMP-" + std::to_string(i);
+            spec.noise.gaussian_sigma = 0.1;
+            spec.fault.spike_prob = 0.05;
+            spec.fault.spike_mag = 3.0;
+            fleet.push_back(std::make_unique<SimpleSensor>(spec));
+            fleet.back()->reset(1000 + i);
+        }
+        return fleet;
+    };
+    auto run = [&](std::size_t threads)
+    {
+        auto fleet = makeFleet();
+        SimpleSensor late(makeDefaultPressureSpec());
+        late.reset(77);
+        SensorScheduler scheduler;
+        scheduler.setWorkerThreads(threads);
+        std::vector<cppminidb::SensorLogRow> rows;
+        scheduler.onSample = [&](const cppminidb::SensorLogRow &row)
+        {
+            rows.push_back(row);
+            // Removal from inside a callback must also be honoured by the merge stage
+            if (row.sensor_id == "TEMP-7" && row.timestamp_ms == 1500)
+                scheduler.removeScheduledSensor("TEMP-8");
+            // A sensor added by a callback is first sampled in the same tick in both modes
+            if (row.sensor_id == "TEMP-3" && row.timestamp_ms == 1000)
+                scheduler.addScheduledSensor("LATE-1", &late, 100);
+        };
+        for (int i = 0; i < kSensors; ++i)
+            scheduler.addScheduledSensor(fleet[i]->id(), fleet[i].get(), 100 + (i % 7) * 50);
+
+        scheduler.tick(0);
+        scheduler.tick(2000);
+        if (threads > 1)
+            scheduler.setWorkerThreads(0); // switching back keeps every pending event
+        scheduler.tick(500);
+        REQUIRE(scheduler.workerThreads() == 0);
+        return rows;
+    };
+
+    std::stringstream buffer;
+    std::streambuf *oldCout = std::cout.rdbuf(buffer.rdbuf());
+    const auto inlineRows = run(0);
+    const auto shardedRows = run(4);
+    std::cout.rdbuf(oldCout);
+
+    REQUIRE(inlineRows.size() == shardedRows.size());
+    for (std::size_t i = 0; i < inlineRows.size(); ++i)
+    {
+        REQUIRE(shardedRows[i].sensor_id == inlineRows[i].sensor_id);
+        REQUIRE(shardedRows[i].timestamp_ms == inlineRows[i].timestamp_ms);
+        REQUIRE(shardedRows[i].value == inlineRows[i].value);
+        REQUIRE(shardedRows[i].fault_flags == inlineRows[i].fault_flags);
+    }
+    REQUIRE(std::none_of(inlineRows.begin(), inlineRows.end(), [](const auto &r)
+                         { return r.sensor_id == "TEMP-8" && r.timestamp_ms > 1500; }));
+    REQUIRE(std::count_if(inlineRows.begin(), inlineRows.end(), [](const auto &r)
+                          { return r.sensor_id == "LATE-1"; }) == 6); // added while tick(2000) runs: 2000 .. 2500 ms
+}
+
+namespace
+{
+    // Throws from nextSample at one timestamp, as a faulty sensor implementation might
+    class ThrowingSensor : public SimpleSensor
+    {
+    public:
+        ThrowingSensor(const SensorSpec &spec, int64_t fail_at_ms) : SimpleSensor(spec), fail_at_ms_(fail_at_ms) {}
+
+        Sample nextSample(int64_t now_ms) override
+        {
+            if (now_ms == fail_at_ms_)
+                throw std::runtime_error("sensor failed at " + std::to_string(now_ms));
+            return SimpleSensor::nextSample(now_ms);
+        }
+
+    private:
+        int64_t fail_at_ms_;
+    };
+}
+
+TEST_CASE("A sensor exception on a worker thread reaches the tick() caller", "[scheduler][sharded]")
+{
+    auto run = [](std::size_t threads)
+    {
+        std::vector<std::unique_ptr<SimpleSensor>> fleet;
+        for (int i = 0; i < 7; ++i)
+        {
+            SensorSpec spec = makeDefaultTempSpec();
+            spec.id = i == 6 ? "LATE-0" : "EXC-" + std::to_string(i);
+            if (i == 4)
+                fleet.push_back(std::make_unique<ThrowingSensor>(spec, 300));
+            else
+                fleet.push_back(std::make_unique<SimpleSensor>(spec));
+        }
+
+        SensorScheduler scheduler;
+        scheduler.setEchoSamples(false);
+        scheduler.setWorkerThreads(threads);
+        std::vector<std::string> rows;
+        scheduler.onSample = [&](const cppminidb::SensorLogRow &row)
+        { rows.push_back(row.sensor_id + "@" + std::to_string(row.timestamp_ms)); };
+
+        std::stringstream buffer;
+        std::streambuf *oldCout = std::cout.rdbuf(buffer.rdbuf());
+        for (int i = 0; i < 6; ++i)
+            scheduler.addScheduledSensor(fleet[i]->id(), fleet[i].get(), 100);
+        scheduler.addScheduledSensor("LATE-0", fleet[6].get(), 700); // due again at 700, after the failure
+        REQUIRE_THROWS_WITH(scheduler.tick(1000), "sensor failed at 300");
+
+        // Everything ordered before the failing sample was emitted, nothing after it
+        CAPTURE(threads);
+        REQUIRE(rows.size() == 3u * 6u + 1u + 4u);
+        REQUIRE(rows.back() == "EXC-3@300");
+
+        // Sensors the workers had sampled past the failure are still pending, as inline
+        const std::size_t before = rows.size();
+        scheduler.tick(0);
+        std::cout.rdbuf(oldCout);
+        REQUIRE(rows[before] == "EXC-5@300");
+        REQUIRE(std::count(rows.begin(), rows.end(), "LATE-0@700") == 1);
+        return rows;
+    };
+
+    REQUIRE(run(3) == run(0));
+}
+
+TEST_CASE("Sensor pools emit the same stream as individually scheduled sensors", "[scheduler][pool]")
+{
+    using PoolSensor = BasicSensor<policy::WaveSignal, policy::SpecNoise, policy::RandomFaults>;
+    constexpr int kMembers = 64;
+    auto specFor = [](int i)
+    {
+        SensorSpec spec = makeDefaultTempSpec();
+        spec.id = "P-" + std::to_string(1000 + i);
+        spec.noise.gaussian_sigma = 0.1;
+        spec.fault.spike_prob = 0.05;
+        spec.fault.spike_mag = 3.0;
+        return spec;
+    };
+
+    auto run = [&](bool pooled, std::size_t threads)
+    {
+        SimpleSensor before(makeDefaultTempSpec()), after(makeDefaultPressureSpec());
+        before.getSpec().id = "P-1003"; // also a pool id: the pool member is skipped
+        before.reset(1);
+        after.reset(2);
+
+        SensorPool<PoolSensor> pool;
+        std::vector<std::unique_ptr<PoolSensor>> single;
+        for (int i = 0; i < kMembers; ++i)
+        {
+            PoolSensor &sensor = pooled ? pool.emplace(specFor(i)) : *single.emplace_back(std::make_unique<PoolSensor>(specFor(i)));
+            sensor.reset(100 + i);
+        }
+
+        SensorScheduler scheduler;
+        scheduler.setWorkerThreads(threads);
+        std::vector<cppminidb::SensorLogRow> rows;
+        scheduler.onSample = [&](const cppminidb::SensorLogRow &row)
+        {
+            rows.push_back(row);
+            if (row.sensor_id == "P-1007" && row.timestamp_ms == 1000)
+                scheduler.removeScheduledSensor("P-1020");
+        };
+        scheduler.addScheduledSensor("P-1003", &before, 250);
+        if (pooled)
+        {
+            REQUIRE(scheduler.addSensorPool(pool, 100'000) == kMembers - 1);
+            REQUIRE_THROWS_AS(pool.emplace(specFor(99)), std::logic_error);
+            REQUIRE(scheduler.getScheduledSensorAs<PoolSensor>("P-1005") == &pool[5]);
+        }
+        else
+        {
+            for (auto &sensor : single)
+                scheduler.addScheduledSensorUs(sensor->id(), sensor.get(), 100'000);
+        }
+        scheduler.addScheduledSensor("PRES-01", &after, 300);
+
+        const SensorScheduler::FaultEvent faults[] = {{500'000, "P-1010", SensorScheduler::FaultKind::Dropout, 3.0, 0.5, 200},
+                                                      {700'000, "P-1011", SensorScheduler::FaultKind::Stuck, 3.0, 0.5, 300}};
+        REQUIRE(scheduler.scheduleFaults(faults) == 2);
+        scheduler.tick(2000);
+        if (pooled)
+        {
+            // Skipped and removed members are not sampled: P-1003 never, P-1020 up to 1000 ms
+            // (workers generate the whole tick before the merge runs the callback)
+            REQUIRE(pool[3].sample(5000).seq == 1u);
+            REQUIRE(pool[20].sample(5000).seq == (threads == 0 ? 12u : 22u));
+            REQUIRE(scheduler.addSensorPool(pool, 0) == 0);
+        }
+        return rows;
+    };
+
+    std::stringstream buffer;
+    std::streambuf *oldCout = std::cout.rdbuf(buffer.rdbuf());
+    const auto reference = run(false, 0);
+    const auto pooledRows = run(true, 0);
+    const auto shardedRows = run(true, 3);
+    std::cout.rdbuf(oldCout);
+
+    REQUIRE(reference.size() > 1000);
+    for (const auto *rows : {&pooledRows, &shardedRows})
+    {
+        REQUIRE(rows->size() == reference.size());
+        for (std::size_t i = 0; i < reference.size(); ++i)
+        {
+            REQUIRE((*rows)[i].sensor_id == reference[i].sensor_id);
+            REQUIRE((*rows)[i].timestamp_ms == reference[i].timestamp_ms);
+            REQUIRE(((*rows)[i].value == reference[i].value || std::isnan(reference[i].value)));
+            REQUIRE((*rows)[i].fault_flags == reference[i].fault_flags);
+        }
+    }
+    auto flagged = [&](const char *id, const char *fault)
+    {
+        return std::count_if(pooledRows.begin(), pooledRows.end(), [&](const auto &r)
+                             { return r.sensor_id == id && std::find(r.fault_flags.begin(), r.fault_flags.end(), fault) != r.fault_flags.end(); });
+    };
+    REQUIRE(flagged("P-1010", "dropout") == 3); // 500, 600, 700 ms
+    REQUIRE(flagged("P-1011", "stuck") == 4);   // 700 .. 1000 ms
+    REQUIRE(std::none_of(pooledRows.begin(), pooledRows.end(), [](const auto &r)
+                         { return r.sensor_id == "P-1020" && r.timestamp_ms > 1000; }));
+}
+
+TEST_CASE("SimulationClock parses speeds and computes absolute deadlines", "[scheduler][clock]")
+{
+    using Clock = SimulationClock;
+    REQUIRE(Clock::parse("realtime")->mode() == Clock::Mode::RealTime);
+    REQUIRE(Clock::parse("1x")->mode() == Clock::Mode::RealTime);
+    REQUIRE(Clock::parse("afap")->mode() == Clock::Mode::AsFastAsPossible);
+    REQUIRE(Clock::parse("250x")->factor() == 250.0);
+    REQUIRE(Clock::parse("250x")->describe() == "250x");
+    REQUIRE_FALSE(Clock::parse("0x"));
+    REQUIRE_FALSE(Clock::parse("fast"));
+
+    const auto start = Clock::WallClock::now();
+    REQUIRE(Clock::scaled(100.0).deadline(start, 10'000) - start == std::chrono::milliseconds(100));
+    REQUIRE(Clock::realTime().deadline(start, 1'500) - start == std::chrono::milliseconds(1'500));
+    REQUIRE(Clock::asFastAsPossible().deadline(start, 1'000'000) == start);
+
+    REQUIRE(parseDurationMs("1d") == 86'400'000u);
+    REQUIRE(parseDurationMs("90s") == 90'000u);
+    REQUIRE(parseDurationMs("250") == 250u);
+    REQUIRE_FALSE(parseDurationMs("5w"));
+    REQUIRE_FALSE(parseDurationMs("999999999999999999d")); // would wrap uint64
+    REQUIRE_FALSE(parseDurationMs("213503983d"));
+    REQUIRE(parseDurationMs("213503982d") == 213'503'982ull * 86'400'000ull);
+}
+
+TEST_CASE("SimulationRunner generates a simulated day as fast as possible", "[scheduler][clock][simulate]")
+{
+    SimpleSensor temp(makeDefaultTempSpec());
+    SensorSpec presSpec = makeDefaultTempSpec();
+    presSpec.id = "PRES-001";
+    SimpleSensor pres(presSpec);
+
+    SensorScheduler scheduler;
+    scheduler.setEchoSamples(false);
+    scheduler.addScheduledSensor("TEMP-01", &temp, 1000);
+    scheduler.addScheduledSensor("PRES-001", &pres, 60'000);
+
+    std::stringstream buffer;
+    std::streambuf *oldCout = std::cout.rdbuf(buffer.rdbuf());
+
+    SimulationRunner runner(scheduler, SimulationClock::asFastAsPossible(), 1000);
+    const auto report = runner.run(86'400'000);
+
+    // Scaled mode is paced: 2 simulated seconds at 100x take at least ~20 ms
+    SimulationRunner paced(scheduler, SimulationClock::scaled(100.0), 500);
+    const auto pacedReport = paced.run(2'000);
+
+    std::cout.rdbuf(oldCout);
+
+    REQUIRE(report.simulated_ms == 86'400'000u);
+    REQUIRE(report.ticks == 86'400u);
+    REQUIRE(report.samples == 86'401u + 1'441u);
+    REQUIRE(report.wall_seconds < 60.0);
+    REQUIRE(scheduler.getNow() == 86'402'000u);
+    REQUIRE(pacedReport.ticks == 4u);
+    REQUIRE(pacedReport.wall_seconds >= 0.019);
+    REQUIRE(report.jitter.count() == 0u);
+    REQUIRE(pacedReport.jitter.count() == 4u);
+    REQUIRE(pacedReport.jitter.minUs() >= 0.0);
+    REQUIRE(buffer.str().empty());
+
+    std::ostringstream text;
+    printReport(text, report);
+    REQUIRE(text.str().find("87842 samples") != std::string::npos);
+}
+
+TEST_CASE("SensorScheduler schedules kHz sensors with microsecond periods", "[scheduler][clock][us]")
+{
+    SensorSpec spec = makeDefaultTempSpec();
+    spec.id = "VIB-001";
+    spec.rate_hz = 2000;
+    SimpleSensor vib(spec);
+
+    SensorScheduler scheduler;
+    scheduler.setEchoSamples(false);
+    std::vector<nlohmann::json> rows;
+    scheduler.onSample = [&](const cppminidb::SensorLogRow &row)
+    { rows.push_back(row.toJSON()); };
+
+    std::stringstream buffer;
+    std::streambuf *oldCout = std::cout.rdbuf(buffer.rdbuf());
+    scheduler.addScheduledSensorAtRate("VIB-001", &vib);
+    scheduler.tick(1000);
+    const uint64_t afterFirstSecond = scheduler.samplesEmitted();
+    scheduler.tickUs(250);
+    scheduler.tickUs(250);
+    std::cout.rdbuf(oldCout);
+
+    // Due at 0, 500, ..., 1'000'000 us, then 1'000'500 after the two 250 us steps
+    REQUIRE(afterFirstSecond == 2001u);
+    REQUIRE(scheduler.samplesEmitted() == 2002u);
+    REQUIRE(scheduler.getNowUs() == 1'000'500u);
+    REQUIRE(scheduler.getNow() == 1000u);
+    REQUIRE(buffer.str().find("period: 0.500 ms") != std::string::npos);
+
+    // Rows keep millisecond time; the JSON carries the full microsecond time on every row
+    REQUIRE(rows.at(1).at("timestamp") == 0u);
+    REQUIRE(rows.at(1).at("timestampUs") == 500u);
+    REQUIRE(rows.at(2).at("timestampUs") == 1000u);
+    REQUIRE(rows.back().at("timestampUs") == 1'000'500u);
+}
+
+TEST_CASE("Scheduler emits fault-free samples without allocating", "[scheduler][handle][alloc]")
+{
+    std::vector<std::unique_ptr<SimpleSensor>> sensors;
+    SensorScheduler scheduler;
+    scheduler.setEchoSamples(false);
+    double sum = 0.0;
+    SensorHandle lastHandle = kInvalidSensorHandle;
+    scheduler.onSample = [&](const cppminidb::SensorLogRow &row)
+    {
+        sum += row.value;
+        lastHandle = row.sensor_handle;
+    };
+
+    std::stringstream buffer;
+    std::streambuf *oldCout = std::cout.rdbuf(buffer.rdbuf());
+    for (int i = 0; i < 64; ++i)
+    {
+        SensorSpec spec = makeDefaultTempSpec();
+        spec.id = "ALLOC-" + std::to_string(i);
+        sensors.push_back(std::make_unique<SimpleSensor>(spec));
+        scheduler.addScheduledSensor(spec.id, sensors.back().get(), 10);
+    }
+    scheduler.tick(1000); // warm-up: the reused row and the sensors' buffers reach full size
+
+    g_allocations = 0;
+    g_countAllocations = true;
+    scheduler.tick(1000);
+    g_countAllocations = false;
+    std::cout.rdbuf(oldCout);
+
+    REQUIRE(g_allocations == 0u);
+    REQUIRE(scheduler.samplesEmitted() == 64u * 201u);
+    REQUIRE(lastHandle == sensors.back()->handle());
+    REQUIRE(sensorName(lastHandle) == "ALLOC-63");
+    REQUIRE(sum != 0.0);
+}
+
+TEST_CASE("Recorded streams replay bit-identically through the scheduler", "[scheduler][replay]")
+{
+    SensorSpec spec = makeDefaultPressureSpec();
+    spec.id = "PRES-REC";
+    spec.noise.gaussian_sigma = 0.7; // values that would not survive a text round trip
+    SimpleSensor pres(spec);
+    pres.reset(9);
+    pres.triggerSpikeFault(3.0, 0.01, 2000);
+
+    SensorScheduler recorder;
+    recorder.setEchoSamples(false);
+    CaptureRecorder capture;
+    recorder.onSample = [&](const cppminidb::SensorLogRow &row)
+    { capture.record(row); };
+
+    std::stringstream buffer;
+    std::streambuf *oldCout = std::cout.rdbuf(buffer.rdbuf());
+    recorder.addScheduledSensor("PRES-REC", &pres, 250);
+    recorder.tick(5000);
+
+    const auto path = (std::filesystem::temp_directory_path() / "replay_roundtrip.cap").string();
+    writeCapture(path, capture.streams());
+    const auto streams = readCapture(path);
+    std::filesystem::remove(path);
+
+    // Replay at 10x: the recording's 250 ms period becomes 25 ms of scheduler time
+    auto replay = makeReplaySensor(streams.at(0));
+    replay->setPlaybackSpeed(10.0);
+    SensorScheduler player;
+    player.setEchoSamples(false);
+    std::vector<double> replayed;
+    std::vector<std::vector<std::string>> replayedFaults;
+    player.onSample = [&](const cppminidb::SensorLogRow &row)
+    {
+        replayed.push_back(row.value);
+        replayedFaults.push_back(row.fault_flags);
+    };
+    player.addScheduledSensor("PRES-REC", replay.get(), 25);
+    player.tick(500);
+    std::cout.rdbuf(oldCout);
+
+    const auto &recorded = capture.streams().at(0).samples;
+    REQUIRE(streams.size() == 1u);
+    REQUIRE(streams[0].type == "PRES");
+    REQUIRE(recorded.size() == 21u);
+    REQUIRE(replay->rateHz() == 4);
+    REQUIRE(replayed.size() == recorded.size());
+    for (std::size_t i = 0; i < recorded.size(); ++i)
+    {
+        REQUIRE(replayed[i] == recorded[i].value);
+        REQUIRE(qualityFromFaults(replayedFaults[i]) == recorded[i].quality);
+    }
+    REQUIRE(recorded[8].quality == QF_SPIKE); // t = 2000 ms
+    REQUIRE(replay->finished());
+    REQUIRE_THROWS_AS(readCapture(path), std::runtime_error);
+}
+
+TEST_CASE("Capture reader rejects counts the file cannot hold", "[replay][capture]")
+{
+    const auto path = (std::filesystem::temp_directory_path() / "replay_corrupt.cap").string();
+    writeCapture(path, {RecordedStream{"TEMP-001", "TEMP", {{0, 21.0, QF_OK}, {100, 21.5, QF_OK}}}});
+    REQUIRE(readCapture(path).at(0).samples.size() == 2u);
+
+    // Patch the sample count (after magic, stream count and both strings) to 2^40
+    const std::streamoff countOffset = 8 + 4 + (4 + 8) + (4 + 4);
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(countOffset);
+        const uint64_t huge = uint64_t{1} << 40;
+        file.write(reinterpret_cast<const char *>(&huge), sizeof(huge));
+    }
+    REQUIRE_THROWS_AS(readCapture(path), std::runtime_error);
+
+    // Same for the stream count
+    writeCapture(path, {});
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(8);
+        const uint32_t huge = 0xFFFFFFFFu;
+        file.write(reinterpret_cast<const char *>(&huge), sizeof(huge));
+    }
+    REQUIRE_THROWS_AS(readCapture(path), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Multi-channel samples travel as one row through scheduler and MiniDB", "[scheduler][channels]")
+{
+    SensorSpec spec = makeDefaultImuSpec();
+    spec.id = "IMU-001";
+    MultiChannelSensor imu(spec);
+    imu.reset(3);
+
+    MiniDB db("imu_sched_log", "./data/imu_sched_test");
+    db.setColumns(MiniDB::logColumns(3), MiniDB::logColumnTypes(3));
+
+    for (std::size_t threads : {1u, 2u})
+    {
+        SensorScheduler scheduler;
+        scheduler.setWorkerThreads(threads);
+        scheduler.setDatabase(&db);
+        std::vector<cppminidb::SensorLogRow> rows;
+        scheduler.onSample = [&](const cppminidb::SensorLogRow &row)
+        { rows.push_back(row); };
+
+        std::stringstream buffer;
+        std::streambuf *oldCout = std::cout.rdbuf(buffer.rdbuf());
+        scheduler.addScheduledSensor("IMU-001", &imu, 10);
+        scheduler.tick(100);
+        std::cout.rdbuf(oldCout);
+
+        REQUIRE(rows.size() == 11u); // one row per instant, not one per axis
+        REQUIRE(rows.back().channels.size() == 3u);
+        REQUIRE(rows.back().value == rows.back().channels[0]);
+        REQUIRE(rows.back().toJSON().at("values").size() == 3u);
+        REQUIRE(buffer.str().find("value: " ) != std::string::npos);
+    }
+
+    REQUIRE(db.rowCount() == 22u);
+    REQUIRE(db.getLogs().back().channels.size() == 3u);
+    REQUIRE(db.getLogs().back().channels[2] == Catch::Approx(9.81).margin(0.5));
+    std::filesystem::remove_all("./data/imu_sched_test");
+}
+
+TEST_CASE("Fleet spec expands templates and ranges and schedules in one pass", "[scheduler][fleet]")
+{
+    const auto config = nlohmann::json::parse(R"({
+        "seed": 7,
+        "templates": { "room": { "preset": "temp", "noise": { "gaussian_sigma": 0.0 } } },
+        "groups": [
+            { "template": "room", "id": "TEMP-{n:04}", "start": 10, "count": 1000,
+              "period_ms": 1000, "base_level": [18.0, 27.99] },
+            { "preset": "imu", "id": "IMU-{n}", "count": 2 },
+            { "preset": "temp", "id": "POOL-{n}", "count": 50, "period_ms": 1000, "pool": true }
+        ]
+    })");
+
+    FleetSpec fleet = parseFleetSpec(config);
+    REQUIRE(fleet.sensors.size() == 1052u);
+    REQUIRE(fleet.sensors.front().spec.id == "TEMP-0010");
+    REQUIRE(fleet.sensors[999].spec.id == "TEMP-1009");
+    REQUIRE(fleet.sensors.front().spec.type == "TEMP");
+    REQUIRE(fleet.sensors.front().spec.base_level == Catch::Approx(18.0));
+    REQUIRE(fleet.sensors[999].spec.base_level == Catch::Approx(27.99));
+    REQUIRE(fleet.sensors.front().period_us == 1'000'000u);
+    REQUIRE(fleet.sensors[1001].spec.id == "IMU-2");
+    REQUIRE(fleet.sensors[1001].period_us == 10'000u); // 100 Hz preset
+    REQUIRE(fleet.sensors[1001].spec.channels.size() == 3u);
+    REQUIRE(fleet.sensors.back().pooled);
+
+    SensorScheduler scheduler;
+    std::vector<std::unique_ptr<ISensor>> owned;
+    std::vector<std::unique_ptr<ISensorPool>> pools;
+    std::size_t emitted = 0;
+    scheduler.onSample = [&emitted](const cppminidb::SensorLogRow &)
+    { ++emitted; };
+
+    std::stringstream buffer;
+    std::streambuf *oldCout = std::cout.rdbuf(buffer.rdbuf());
+    REQUIRE(deployFleet(fleet, scheduler, owned, pools) == 1052u);
+    REQUIRE(deployFleet(fleet, scheduler, owned, pools) == 0u); // ids already scheduled
+    scheduler.tick(0);
+    std::cout.rdbuf(oldCout);
+
+    REQUIRE(emitted == 1052u);
+    REQUIRE(scheduler.getSensorIds().size() == 1052u);
+    REQUIRE(pools.size() == 2u);
+    REQUIRE(scheduler.getScheduledSensorAs<FleetPoolSensor>("POOL-50") == &pools.front()->member(49));
+    REQUIRE(owned.front()->channelCount() == 1u);
+    REQUIRE(owned[1000]->channelCount() == 3u);
+    REQUIRE(buffer.str().find("Sensors scheduled: 0 (1002 skipped)") != std::string::npos);
+
+    REQUIRE_THROWS_AS(parseFleetSpec(nlohmann::json::parse(R"({"groups": [{"template": "missing", "id": "X"}]})")),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(parseFleetSpec(nlohmann::json::parse(R"({"groups": [{"id": "X", "base_level": [1]}]})")),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(parseFleetSpec(nlohmann::json::parse(R"({"groups": [{"preset": "imu", "id": "X", "pool": true}]})")),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(parseFleetSpec(nlohmann::json::parse(
+                          R"({"groups": [{"id": "X{n}", "count": 2, "period_ms": [10, 20], "pool": true}]})")),
+                      std::invalid_argument);
+}
+
+TEST_CASE("Fleet specs and the shell select timeline fault sampling", "[scheduler][fleet][faults]")
+{
+    const auto config = nlohmann::json::parse(R"({
+        "seed": 5,
+        "fault_sampling": "timeline",
+        "templates": { "noisy": { "preset": "temp", "fault": { "dropout_prob": 0.05, "spike_prob": 0.05 } } },
+        "groups": [
+            { "template": "noisy", "id": "TL-{n}", "count": 2 },
+            { "template": "noisy", "id": "PS-{n}", "count": 1, "fault_sampling": "per_sample" }
+        ]
+    })");
+    const FleetSpec fleet = parseFleetSpec(config);
+    REQUIRE(fleet.sensors[0].fault_sampling == FaultSampling::Timeline);
+    REQUIRE(fleet.sensors[2].fault_sampling == FaultSampling::PerSample);
+
+    auto sensors = makeFleetSensors(fleet);
+    auto *timeline = dynamic_cast<SimpleSensor *>(sensors[1].get());
+    REQUIRE(timeline != nullptr);
+    REQUIRE(timeline->faultSampling() == FaultSampling::Timeline);
+    REQUIRE(dynamic_cast<SimpleSensor &>(*sensors[2]).faultSampling() == FaultSampling::PerSample);
+
+    // Same stream as a SimpleSensor switched to Timeline by hand
+    SimpleSensor reference(fleet.sensors[1].spec);
+    reference.setFaultSampling(FaultSampling::Timeline);
+    reference.reset(fleet.seed + 1);
+    std::size_t faults = 0;
+    for (int64_t t = 0; t < 200'000; t += 100)
+    {
+        const Sample a = timeline->nextSample(t);
+        const Sample b = reference.nextSample(t);
+        REQUIRE(a.quality == b.quality);
+        REQUIRE((a.value == b.value || (std::isnan(a.value) && std::isnan(b.value))));
+        faults += a.quality != QF_OK;
+    }
+    REQUIRE(faults > 0);
+
+    REQUIRE_THROWS_AS(parseFleetSpec(nlohmann::json::parse(R"({"groups": [{"id": "X", "fault_sampling": "sometimes"}]})")),
+                      std::invalid_argument);
+
+    EdgeShell shell;
+    cli::AddCommand add(shell);
+    std::stringstream buffer;
+    std::streambuf *oldCout = std::cout.rdbuf(buffer.rdbuf());
+    std::streambuf *oldCerr = std::cerr.rdbuf(buffer.rdbuf());
+    add.execute({"temp-009", "100", "timeline"});
+    add.execute({"temp-010", "100", "sometimes"});
+    add.execute({"pres-009", "100"});
+    std::cout.rdbuf(oldCout);
+    std::cerr.rdbuf(oldCerr);
+    REQUIRE(dynamic_cast<SimpleSensor &>(*shell.getSensors().at("TEMP-009")).faultSampling() == FaultSampling::Timeline);
+    REQUIRE(dynamic_cast<SimpleSensor &>(*shell.getSensors().at("PRES-009")).faultSampling() == FaultSampling::PerSample);
+    REQUIRE(shell.getSensors().count("TEMP-010") == 0u);
+    REQUIRE(buffer.str().find("Invalid fault sampling: sometimes") != std::string::npos);
+}
+
+TEST_CASE("Fault campaign dispatches timed faults and reconciles them with the log", "[scheduler][campaign]")
+{
+    std::vector<std::unique_ptr<SimpleSensor>> sensors;
+    SensorScheduler scheduler;
+    std::vector<LogEntry> logs;
+    scheduler.onSample = [&logs](const cppminidb::SensorLogRow &row)
+    { logs.push_back({row.timestamp_ms, row.sensor_id, row.value, row.fault_flags, {}}); };
+
+    std::stringstream buffer;
+    std::streambuf *oldCout = std::cout.rdbuf(buffer.rdbuf());
+    for (int i = 1; i <= 3; ++i)
+    {
+        SensorSpec spec = makeDefaultTempSpec();
+        spec.id = "TEMP-" + std::to_string(i);
+        spec.fault = {};
+        sensors.push_back(std::make_unique<SimpleSensor>(spec));
+        scheduler.addScheduledSensor(spec.id, sensors.back().get(), 100);
+    }
+
+    const auto config = nlohmann::json::parse(R"({
+        "seed": 3,
+        "events": [
+            { "at_ms": 1000, "sensor": "TEMP-*", "fault": "dropout", "duration_ms": 300 },
+            { "at_ms": 2050, "sensor": "TEMP-2", "fault": "stuck", "duration_ms": 200 },
+            { "at_ms": 2500, "sensor": "NOPE-1", "fault": "spike" }
+        ],
+        "random": [
+            { "fault": "spike", "sensor": "TEMP-3", "count": 1, "from_ms": 5000, "to_ms": 6000, "sigma": 0.01 }
+        ]
+    })");
+    const auto campaign = parseFaultCampaign(config, scheduler.getSensorIds());
+    REQUIRE(campaign.events.size() == 5u); // unknown ids match nothing
+    REQUIRE(scheduler.scheduleFaults(campaign.events) == 5u);
+
+    scheduler.tick(10'000); // one tick, split at every fault time
+    std::cout.rdbuf(oldCout);
+    REQUIRE(scheduler.pendingFaults() == 0u);
+
+    for (const auto &row : logs)
+    {
+        const bool dropout = std::find(row.faults.begin(), row.faults.end(), "dropout") != row.faults.end();
+        REQUIRE(dropout == (row.timestampMs >= 1000 && row.timestampMs <= 1300));
+    }
+
+    const auto summary = summarizeCampaign(scheduler.injectedFaults(), logs);
+    REQUIRE(summary.injected.dropout == 3u);
+    REQUIRE(summary.injected.stuck == 1u);
+    REQUIRE(summary.injected.spike == 1u);
+    REQUIRE(summary.observed.dropout == 3u);
+    REQUIRE(summary.observed.stuck == 1u);
+    REQUIRE(summary.observed.spike == 1u);
+    REQUIRE(summary.sensors_affected == 3u);
+
+    std::stringstream report;
+    printCampaignSummary(report, summary);
+    REQUIRE(report.str().find("dropout: 3 / 3") != std::string::npos);
+
+    // Faults for sensors removed before their time are dropped
+    std::vector<SensorScheduler::FaultEvent> late{{scheduler.getNowUs() + 1000, "TEMP-1", SensorScheduler::FaultKind::Spike}};
+    std::cout.rdbuf(buffer.rdbuf());
+    scheduler.scheduleFaults(late);
+    scheduler.removeScheduledSensor("TEMP-1");
+    scheduler.tick(2000);
+    std::cout.rdbuf(oldCout);
+    REQUIRE(scheduler.injectedFaults().total() == 5u);
+    REQUIRE_THROWS_AS(parseFaultCampaign(nlohmann::json::parse(R"({"events": [{"fault": "melt", "sensor": "*"}]})"),
+                                         scheduler.getSensorIds()),
+                      std::invalid_argument);
+    for (const char *bad : {R"({"random": [{"fault": "spike", "count": -1}]})",
+                            R"({"events": [{"fault": "stuck", "sensor": "*", "duration_ms": -5}]})",
+                            R"({"events": [{"fault": "dropout", "sensor": "*", "duration_ms": [-100, 100]}]})"})
+        REQUIRE_THROWS_AS(parseFaultCampaign(nlohmann::json::parse(bad), scheduler.getSensorIds()), std::invalid_argument);
+}
+
+TEST_CASE("CLI inject triggers faults on any scheduled sensor", "[cli][inject]")
+{
+    EdgeShell shell;
+    std::stringstream buffer;
+    std::streambuf *oldCout = std::cout.rdbuf(buffer.rdbuf());
+    shell.addScheduledSensor("IMU-001", 100);
+    shell.injectFault("dropout", "IMU-001", {"500"});
+    shell.injectFault("dropout", "TEMP-404", {});
+    std::cout.rdbuf(oldCout);
+
+    REQUIRE(buffer.str().find("Injected dropout fault on IMU-001 [duration=500ms]") != std::string::npos);
+    REQUIRE(buffer.str().find("Sensor not scheduled: TEMP-404") != std::string::npos);
+    REQUIRE(shell.getSensors().at("IMU-001")->getActiveFaults(0) == std::vector<std::string>{"dropout"});
+}
+
+TEST_CASE("Sample bus applies backpressure policies and counts drops", "[scheduler][bus]")
+{
+    BoundedQueue<int> queue(5);
+    REQUIRE(queue.capacity() == 8u);
+    for (int i = 0; i < 8; ++i)
+        REQUIRE(queue.tryPush(i));
+    REQUIRE_FALSE(queue.tryPush(8));
+    int out = -1;
+    REQUIRE(queue.tryPop(out));
+    REQUIRE(out == 0);
+
+    // A consumer held at a gate until everything is published
+    std::atomic<bool> open{false};
+    std::vector<uint64_t> newest, oldest;
+    std::atomic<uint64_t> blocked{0};
+    SampleBus bus;
+    auto gated = [&open](std::vector<uint64_t> &into)
+    {
+        return [&open, &into](const cppminidb::SensorLogRow &row)
+        {
+            while (!open.load())
+                std::this_thread::yield();
+            into.push_back(row.timestamp_ms);
+        };
+    };
+    bus.subscribe("drop-newest", gated(newest), 4, Backpressure::DropNewest);
+    bus.subscribe("drop-oldest", gated(oldest), 4, Backpressure::DropOldest);
+    bus.subscribe("block", [&blocked](const cppminidb::SensorLogRow &)
+                  { ++blocked; }, 4, Backpressure::Block);
+    bus.start();
+
+    for (uint64_t ts = 0; ts < 100; ++ts)
+        bus.publish({ts, "TEMP-001", 1.0, {}});
+    open = true;
+    bus.flush();
+
+    const auto stats = bus.stats();
+    REQUIRE(stats[0].published == 100u);
+    REQUIRE(stats[0].delivered + stats[0].dropped == 100u);
+    REQUIRE(stats[0].dropped >= 90u);
+    REQUIRE(newest.front() == 0u); // the first rows were kept, the rest dropped
+    REQUIRE(stats[1].delivered + stats[1].dropped == 100u);
+    REQUIRE(oldest.back() == 99u); // the newest rows survive
+    REQUIRE(stats[2].dropped == 0u);
+    REQUIRE(blocked == 100u);
+    REQUIRE_THROWS_AS(bus.subscribe("late", nullptr), std::logic_error);
+    bus.stop();
+}
+
+TEST_CASE("Scheduler publishes into a multi-producer sample bus feeding MiniDB", "[scheduler][bus]")
+{
+    MiniDB db("bus_log", "./data/bus_test");
+    db.setColumns(MiniDB::logColumns(1), MiniDB::logColumnTypes(1));
+
+    SampleBus bus;
+    bus.subscribe("minidb", SampleBus::databaseWriter(db), 64, Backpressure::Block);
+    std::atomic<uint64_t> extra{0};
+    bus.subscribe("counter", [&extra](const cppminidb::SensorLogRow &)
+                  { ++extra; }, 1024, Backpressure::Block);
+    bus.start();
+
+    // Two producers: a scheduler and a second thread publishing directly
+    std::thread side([&bus]
+                     {
+        for (uint64_t ts = 0; ts < 5000; ++ts)
+            bus.publish({ts, "SIDE-001", 2.0, {}}); });
+
+    SensorScheduler scheduler;
+    scheduler.setEchoSamples(false);
+    scheduler.setSampleBus(&bus);
+    SensorSpec spec = makeDefaultTempSpec();
+    spec.id = "TEMP-001";
+    SimpleSensor sensor(spec);
+    std::stringstream buffer;
+    std::streambuf *oldCout = std::cout.rdbuf(buffer.rdbuf());
+    scheduler.addScheduledSensor(spec.id, &sensor, 10);
+    scheduler.tick(9'990);
+    std::cout.rdbuf(oldCout);
+    side.join();
+    bus.flush();
+
+    REQUIRE(scheduler.samplesEmitted() == 1000u);
+    REQUIRE(db.rowCount() == 6000u);
+    REQUIRE(extra == 6000u);
+    bus.stop();
+    std::filesystem::remove_all("./data/bus_test");
+}
+
+TEST_CASE("Scheduler keeps running output statistics per sensor", "[scheduler][stats]")
+{
+    SensorScheduler scheduler;
+    scheduler.setEchoSamples(false);
+    SensorSpec spec = makeDefaultTempSpec();
+    spec.id = "TEMP-001";
+    SimpleSensor sensor(spec);
+    std::vector<double> values;
+    scheduler.onSample = [&values](const cppminidb::SensorLogRow &row)
+    {
+        if (!std::isnan(row.value))
+            values.push_back(row.value);
+    };
+
+    std::stringstream buffer;
+    std::streambuf *oldCout = std::cout.rdbuf(buffer.rdbuf());
+    scheduler.addScheduledSensor(spec.id, &sensor, 10);
+    REQUIRE(scheduler.getSensorStats("TEMP-404") == nullptr);
+    REQUIRE(scheduler.getSensorStats(spec.id)->count() == 0u);
+    scheduler.tick(9'990);
+
+    const OnlineStats *stats = scheduler.getSensorStats(spec.id);
+    REQUIRE(stats->count() + stats->missing() == 1000u);
+    REQUIRE(stats->count() == values.size());
+    double sum = 0.0;
+    for (double v : values)
+        sum += v;
+    REQUIRE(stats->mean() == Approx(sum / values.size()));
+    REQUIRE(stats->max() == *std::max_element(values.begin(), values.end()));
+
+    buffer.str("");
+    cli::StatusCommand status(scheduler);
+    status.execute({spec.id});
+    REQUIRE(buffer.str().find("TEMP-001: " + std::to_string(stats->count()) + " samples") != std::string::npos);
+
+    const uint64_t counted = stats->count();
+    scheduler.setStatsEnabled(false);
+    scheduler.tick(1'000);
+    REQUIRE(values.size() > counted);
+    REQUIRE(scheduler.getSensorStats(spec.id)->count() == counted);
+
+    // A sensor re-added under the same slot starts from scratch
+    scheduler.setStatsEnabled(true);
+    scheduler.removeSensor(spec.id);
+    scheduler.addScheduledSensor(spec.id, &sensor, 10);
+    REQUIRE(scheduler.getSensorStats(spec.id)->count() == 0u);
+
+    // Faulted samples are counted even with no row consumer
+    scheduler.onSample = nullptr;
+    scheduler.injectFault({scheduler.getNowUs(), spec.id, SensorScheduler::FaultKind::Dropout, 0.0, 0.0, 100});
+    scheduler.tick(190);
+    std::cout.rdbuf(oldCout);
+    stats = scheduler.getSensorStats(spec.id);
+    REQUIRE(stats->faulted() > 0u);
+    REQUIRE(stats->faulted() == stats->missing());
+}
+
+TEST_CASE("Scheduler anomaly stage marks detected faults in emitted rows", "[scheduler][anomaly]")
+{
+    SensorScheduler scheduler;
+    scheduler.setEchoSamples(false);
+    SensorSpec spec = makeDefaultTempSpec();
+    spec.id = "TEMP-001";
+    SimpleSensor sensor(spec);
+    std::size_t clean = 0, flatline = 0, stuck = 0;
+    scheduler.onSample = [&](const cppminidb::SensorLogRow &row)
+    {
+        const auto &flags = row.fault_flags;
+        clean += flags.empty();
+        flatline += std::find(flags.begin(), flags.end(), "flatline") != flags.end();
+        stuck += std::find(flags.begin(), flags.end(), "stuck") != flags.end();
+    };
+
+    std::stringstream buffer;
+    std::streambuf *oldCout = std::cout.rdbuf(buffer.rdbuf());
+    scheduler.addScheduledSensor(spec.id, &sensor, 10);
+    cli::DetectCommand detect(scheduler);
+    // Out-of-range counts print the usage instead of enabling (or throwing)
+    for (const char *bad : {"window=-1", "window=1", "window=100000000", "flatline=-3", "window=8x"})
+    {
+        REQUIRE_NOTHROW(detect.execute({"on", bad}));
+        REQUIRE_FALSE(scheduler.anomalyDetection());
+    }
+    detect.execute({"on", "flatline=10", "rate=50"});
+    REQUIRE(scheduler.anomalyDetection());
+    REQUIRE(scheduler.detectorCosts()[AnomalyDetector::Rate].checks == 0u);
+
+    // A clean sine (max slope 6.3/s) trips nothing
+    scheduler.tick(1'990);
+    REQUIRE(clean == 200u);
+
+    // A frozen output is flagged once it has repeated for 10 samples; the stuck value is
+    // the last good sample, so the run starts one sample before the fault
+    scheduler.injectFault({scheduler.getNowUs(), spec.id, SensorScheduler::FaultKind::Stuck, 0.0, 0.0, 500});
+    scheduler.tick(1'000);
+    REQUIRE(stuck > 40u);
+    REQUIRE(flatline == stuck - 8);
+
+    const auto &costs = scheduler.detectorCosts();
+    REQUIRE(costs[AnomalyDetector::ZScore].checks == 300u);
+    REQUIRE(costs[AnomalyDetector::Flatline].flagged == flatline);
+    REQUIRE(costs[AnomalyDetector::Flatline].timed == 300u / SensorScheduler::kDetectorTimingInterval);
+
+    buffer.str("");
+    detect.execute({});
+    REQUIRE(buffer.str().find("Detector flatline: 300 checks, " + std::to_string(flatline) + " flagged") != std::string::npos);
+    detect.execute({"off"});
+    scheduler.tick(100);
+    std::cout.rdbuf(oldCout);
+    REQUIRE_FALSE(scheduler.anomalyDetection());
+    REQUIRE(costs[AnomalyDetector::ZScore].checks == 300u);
+}
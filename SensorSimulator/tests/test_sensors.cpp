@@ -1,8 +1,16 @@
 #define CATCH_CONFIG_MAIN
 #include <catch2/catch_all.hpp>
 #include "sensors/SimpleSensor.hpp"
+#include "sensors/ReplaySensor.hpp"
+#include "sensors/MultiChannelSensor.hpp"
+#include "sensors/BasicSensor.hpp"
+#include "sensors/OnlineStats.hpp"
+#include "sensors/AnomalyDetector.hpp"
+#include <algorithm>
 #include <iostream>
 #include <cmath>
+#include <thread>
+#include <vector>
 
 using namespace sensor;
 
@@ -28,8 +36,8 @@ TEST_CASE("SimpleSensor determinism with same seed", "[sensor][determinism]")
     std::cout << "s1.value: " << s1.value << std::endl;
     std::cout << "s2.value: " << s2.value << std::endl;
     REQUIRE(s1.seq == s2.seq);
-    REQUIRE(s1.id == s2.id);
-    REQUIRE(s1.type == s2.type);
+    REQUIRE(s1.sensor == s2.sensor);
+    REQUIRE(sensorName(s1.sensor) == "TEMP-01");
 }
 
 TEST_CASE("SimpleSensor exposes rate and identity", "[sensor][api]")
@@ -456,4 +464,782 @@ TEST_CASE("SimpleSensor: dropout disables all other faults and noise", "[sensor]
         REQUIRE((smp.quality & QF_SPIKE) == 0);
         REQUIRE((smp.quality & QF_STUCK) == 0);
     }
-}
\ No newline at end of file
+}
+TEST_CASE("generateBatch matches sequential nextSample calls", "[sensor][batch]")
+{
+    SensorSpec spec = makeDefaultTempSpec();
+    spec.noise.gaussian_sigma = 0.2;
+    spec.noise.uniform_range = 0.5;
+    spec.noise.drift_ppm = 50.0;
+    spec.fault.dropout_prob = 0.05;
+    spec.fault.spike_prob = 0.05;
+    spec.fault.spike_mag = 4.0;
+    spec.fault.stuck_prob = 0.02;
+    spec.fault.stuck_min_ms = 200;
+    spec.fault.stuck_max_ms = 800;
+
+    SimpleSensor sequential(spec), batched(spec);
+    sequential.reset(42);
+    batched.reset(42);
+
+    constexpr std::size_t kCount = 5000;
+    SampleBatch batch;
+    batch.resize(kCount);
+    REQUIRE(batched.generateBatch(1'000, 100, kCount, batch.view()) == kCount);
+
+    bool sawStuck = false, sawDropout = false;
+    for (std::size_t i = 0; i < kCount; ++i)
+    {
+        const auto s = sequential.nextSample(1'000 + static_cast<int64_t>(i) * 100);
+        REQUIRE(batch.timestamps[i] == s.ts);
+        REQUIRE(batch.quality[i] == s.quality);
+        if (std::isnan(s.value))
+            REQUIRE(std::isnan(batch.values[i]));
+        else
+            REQUIRE(batch.values[i] == s.value);
+        sawStuck |= (s.quality & QF_STUCK) != 0;
+        sawDropout |= (s.quality & QF_DROPOUT) != 0;
+    }
+    REQUIRE(sawStuck);
+    REQUIRE(sawDropout);
+
+    // History and RNG state line up, so the streams stay identical afterwards
+    const auto &h1 = sequential.getHistory();
+    const auto &h2 = batched.getHistory();
+    REQUIRE(h1.size() == h2.size());
+    for (std::size_t i = 0; i < h1.size(); ++i)
+        REQUIRE((h1[i] == h2[i] || (std::isnan(h1[i]) && std::isnan(h2[i]))));
+    auto nextSeq = sequential.nextSample(600'000);
+    auto nextBatch = batched.nextSample(600'000);
+    REQUIRE(nextSeq.seq == nextBatch.seq);
+    REQUIRE(nextSeq.quality == nextBatch.quality);
+}
+
+TEST_CASE("generateBatch is bounded by the output buffer", "[sensor][batch]")
+{
+    SimpleSensor sensor(makeDefaultTempSpec());
+    sensor.reset(7);
+
+    SampleBatch batch;
+    batch.resize(16);
+    REQUIRE(sensor.generateBatch(0, 10, 100, batch.view()) == 16);
+    REQUIRE(batch.timestamps.front() == 0);
+    REQUIRE(batch.timestamps.back() == 150);
+
+    // The ISensor default implementation produces the same samples
+    SimpleSensor reference(makeDefaultTempSpec());
+    reference.reset(7);
+    SampleBatch viaBase;
+    viaBase.resize(16);
+    REQUIRE(reference.ISensor::generateBatch(0, 10, 16, viaBase.view()) == 16);
+    REQUIRE(viaBase.values == batch.values);
+    REQUIRE(viaBase.quality == batch.quality);
+}
+
+TEST_CASE("Signal kernels track libm within tolerance", "[sensor][batch][kernels]")
+{
+    for (int i = -2000; i <= 2000; ++i)
+    {
+        const double turns = i * 0.01237;
+        REQUIRE(kernels::sinTurns(turns) == Catch::Approx(std::sin(2.0 * M_PI * turns)).margin(1e-10));
+    }
+    for (double x = 1e-12; x <= 1.0; x *= 1.37)
+        REQUIRE(kernels::logPositive(x) == Catch::Approx(std::log(x)).epsilon(1e-12).margin(1e-12));
+    REQUIRE(kernels::logPositive(1.0) == 0.0);
+}
+
+TEST_CASE("Vectorized generateBatch is deterministic and statistically equivalent", "[sensor][batch][kernels]")
+{
+    constexpr std::size_t kCount = 20'000;
+
+    // Noise-free: only the sine approximation differs from the exact path
+    {
+        SimpleSensor exact(makeDefaultTempSpec()), fast(makeDefaultTempSpec());
+        exact.reset(3);
+        fast.reset(3);
+        fast.setBatchSynthesis(BatchSynthesis::Vectorized);
+
+        SampleBatch a, b;
+        a.resize(kCount);
+        b.resize(kCount);
+        exact.generateBatch(0, 37, kCount, a.view());
+        REQUIRE(fast.generateBatch(0, 37, kCount, b.view()) == kCount);
+        REQUIRE(a.timestamps == b.timestamps);
+        REQUIRE(a.quality == b.quality);
+        for (std::size_t i = 0; i < kCount; ++i)
+            REQUIRE(b.values[i] == Catch::Approx(a.values[i]).margin(1e-9));
+        REQUIRE(fast.getHistory().size() == exact.getHistory().size());
+    }
+
+    SensorSpec spec = makeDefaultTempSpec();
+    spec.sine_amp = 0.0;
+    spec.noise.gaussian_sigma = 0.5;
+    spec.fault.dropout_prob = 0.1;
+
+    SimpleSensor a(spec), b(spec);
+    a.reset(99);
+    b.reset(99);
+    a.setBatchSynthesis(BatchSynthesis::Vectorized);
+    b.setBatchSynthesis(BatchSynthesis::Vectorized);
+
+    SampleBatch ba, bb;
+    ba.resize(kCount);
+    bb.resize(kCount);
+    a.generateBatch(0, 100, kCount, ba.view());
+    b.generateBatch(0, 100, kCount, bb.view());
+    REQUIRE(ba.quality == bb.quality);
+
+    double sum = 0.0, sumSq = 0.0;
+    std::size_t n = 0, dropouts = 0;
+    for (std::size_t i = 0; i < kCount; ++i)
+    {
+        if (ba.quality[i] & QF_DROPOUT)
+        {
+            REQUIRE(std::isnan(bb.values[i]));
+            ++dropouts;
+            continue;
+        }
+        REQUIRE(ba.values[i] == bb.values[i]);
+        const double d = ba.values[i] - spec.base_level;
+        sum += d;
+        sumSq += d * d;
+        ++n;
+    }
+    const double mean = sum / n;
+    REQUIRE(std::abs(mean) < 0.02);
+    REQUIRE(std::sqrt(sumSq / n - mean * mean) == Catch::Approx(0.5).epsilon(0.03));
+    REQUIRE(dropouts > kCount / 20);
+    REQUIRE(dropouts < kCount / 5);
+}
+
+TEST_CASE("Philox4x32-10 matches the Random123 known-answer vector", "[sensor][rng]")
+{
+    const auto out = Philox4x32::generate({0, 0, 0, 0}, {0, 0});
+    REQUIRE(out[0] == 0x6627e8d5u);
+    REQUIRE(out[1] == 0xe169c58du);
+    REQUIRE(out[2] == 0xbc57ac4cu);
+    REQUIRE(out[3] == 0x9b00dbd8u);
+
+    CounterRng a(42, CounterRng::streamFor("TEMP-01")), b(42, CounterRng::streamFor("TEMP-02"));
+    REQUIRE(a.uniform(7, 3) == a.uniform(7, 3));
+    REQUIRE(a.uniform(7, 3) != a.uniform(8, 3));
+    REQUIRE(a.uniform(7, 3) != b.uniform(7, 3));
+}
+
+TEST_CASE("Counter-based RNG gives random access and parallel generation", "[sensor][rng][batch]")
+{
+    SensorSpec spec = makeDefaultTempSpec();
+    spec.noise.gaussian_sigma = 0.2;
+    spec.noise.uniform_range = 0.3;
+    spec.noise.drift_ppm = 40.0;
+    spec.fault.dropout_prob = 0.05;
+    spec.fault.spike_prob = 0.05;
+    spec.fault.spike_sigma = 2.0;
+
+    SimpleSensor sequential(spec);
+    sequential.reset(2024);
+    sequential.setRngMode(RngMode::CounterBased);
+    sequential.triggerStuckFault(300, 5'000, 25.5);
+
+    constexpr std::size_t kCount = 4000;
+    SampleBatch expected;
+    expected.resize(kCount);
+    for (std::size_t i = 0; i < kCount; ++i)
+    {
+        const auto s = sequential.nextSample(static_cast<int64_t>(i) * 10);
+        expected.timestamps[i] = s.ts;
+        expected.values[i] = s.value;
+        expected.quality[i] = s.quality;
+    }
+
+    SimpleSensor source(spec);
+    source.reset(2024);
+    source.setRngMode(RngMode::CounterBased);
+    source.triggerStuckFault(300, 5'000, 25.5);
+
+    // Jump straight to sample 3001 (1-based sequence numbers)
+    SampleBatch tail;
+    tail.resize(10);
+    REQUIRE(source.generateAt(3001, 30'000, 10, 10, tail.view()) == 10);
+    for (std::size_t i = 0; i < 10; ++i)
+        REQUIRE(tail.quality[i] == expected.quality[3000 + i]);
+
+    // Four threads, each generating a quarter of the stream from the same const sensor
+    SampleBatch parallel;
+    parallel.resize(kCount);
+    std::vector<std::thread> workers;
+    constexpr std::size_t kChunk = kCount / 4;
+    for (std::size_t w = 0; w < 4; ++w)
+    {
+        workers.emplace_back([&, w]
+                             {
+            auto view = parallel.view();
+            SampleBatchView part{view.timestamps.subspan(w * kChunk, kChunk),
+                                 view.values.subspan(w * kChunk, kChunk),
+                                 view.quality.subspan(w * kChunk, kChunk)};
+            source.generateAt(w * kChunk + 1, static_cast<int64_t>(w * kChunk) * 10, 10, kChunk, part); });
+    }
+    for (auto &t : workers)
+        t.join();
+
+    bool sawStuck = false;
+    for (std::size_t i = 0; i < kCount; ++i)
+    {
+        REQUIRE(parallel.timestamps[i] == expected.timestamps[i]);
+        REQUIRE(parallel.quality[i] == expected.quality[i]);
+        if (std::isnan(expected.values[i]))
+            REQUIRE(std::isnan(parallel.values[i]));
+        else
+            REQUIRE(parallel.values[i] == expected.values[i]);
+        sawStuck |= (expected.quality[i] & QF_STUCK) != 0;
+    }
+    REQUIRE(sawStuck);
+
+    SimpleSensor legacy(spec);
+    legacy.reset(2024);
+    REQUIRE_THROWS_AS(legacy.generateAt(1, 0, 10, 1, parallel.view()), std::logic_error);
+}
+
+TEST_CASE("RingBuffer keeps the newest values in two contiguous segments", "[sensor][history]")
+{
+    RingBuffer<int> ring(4);
+    REQUIRE(ring.view().empty());
+    for (int i = 1; i <= 3; ++i)
+        ring.push_back(i);
+    REQUIRE(std::vector<int>(ring.view().begin(), ring.view().end()) == std::vector<int>{1, 2, 3});
+
+    for (int i = 4; i <= 10; ++i)
+        ring.push_back(i);
+    const auto view = ring.view();
+    REQUIRE(view.size() == 4);
+    REQUIRE(view.front() == 7);
+    REQUIRE(view.back() == 10);
+    REQUIRE(view.first().size() + view.second().size() == 4);
+    REQUIRE(std::vector<int>(view.begin(), view.end()) == std::vector<int>{7, 8, 9, 10});
+
+    ring.setCapacity(2);
+    REQUIRE(std::vector<int>(ring.view().begin(), ring.view().end()) == std::vector<int>{9, 10});
+    ring.setCapacity(5);
+    ring.push_back(11);
+    REQUIRE(std::vector<int>(ring.view().begin(), ring.view().end()) == std::vector<int>{9, 10, 11});
+}
+
+TEST_CASE("SimpleSensor history holds exactly its configured capacity", "[sensor][history]")
+{
+    SimpleSensor sensor(makeDefaultTempSpec());
+    sensor.reset(5);
+    REQUIRE(sensor.historyCapacity() == kMaxPlotSamples);
+
+    for (int i = 0; i < 250; ++i)
+        sensor.nextSample(i * 100);
+    REQUIRE(sensor.getHistory().size() == kMaxPlotSamples);
+
+    sensor.setHistoryCapacity(16);
+    SampleBatch batch;
+    batch.resize(64);
+    sensor.generateBatch(25'000, 100, 64, batch.view());
+
+    const auto history = sensor.getHistory();
+    REQUIRE(history.size() == 16);
+    for (std::size_t i = 0; i < 16; ++i)
+        REQUIRE(history[i] == batch.values[48 + i]);
+
+    // Iterators from a temporary view stay valid: they point into the sensor's buffer
+    const auto first = sensor.getHistory().begin();
+    const auto last = sensor.getHistory().end();
+    REQUIRE(last - first == 16);
+    REQUIRE(std::equal(first, last, batch.values.begin() + 48));
+}
+
+TEST_CASE("Samples carry an interned sensor handle", "[sensor][handle]")
+{
+    const SensorHandle a = internSensorId("HANDLE-A");
+    REQUIRE(a != kInvalidSensorHandle);
+    REQUIRE(internSensorId("HANDLE-A") == a);
+    REQUIRE(internSensorId("HANDLE-B") != a);
+    REQUIRE(sensorName(a) == "HANDLE-A");
+    REQUIRE(sensorName(kInvalidSensorHandle).empty());
+
+    SensorSpec spec = makeDefaultTempSpec();
+    spec.id = "HANDLE-A";
+    SimpleSensor sensor(spec);
+    sensor.reset(1);
+    REQUIRE(sensor.handle() == a);
+    REQUIRE(sensor.nextSample(0).sensor == a);
+
+    // Re-interning from many threads is race-free and stable
+    std::vector<std::thread> threads;
+    std::vector<SensorHandle> seen(8);
+    for (std::size_t t = 0; t < seen.size(); ++t)
+        threads.emplace_back([&seen, t]
+                             { seen[t] = internSensorId("HANDLE-SHARED"); });
+    for (auto &th : threads)
+        th.join();
+    REQUIRE(std::all_of(seen.begin(), seen.end(), [&](SensorHandle h)
+                        { return h == seen.front(); }));
+}
+
+TEST_CASE("ReplaySensor plays a recording with seek and playback speed", "[sensor][replay]")
+{
+    SensorSpec spec = makeDefaultTempSpec();
+    spec.id = "REPLAY-01";
+    ReplaySensor replay(spec, {{1000, 1.0}, {1100, 2.0}, {1200, 3.0, QF_SPIKE}, {1300, 4.0}});
+    REQUIRE(nominalPeriodMs(replay.recording()) == 100u);
+
+    // Anchored at the first call: caller time 5000 plays recording time 1000
+    REQUIRE(replay.nextSample(5000).value == 1.0);
+    REQUIRE(replay.nextSample(5099).value == 1.0);
+    REQUIRE(replay.nextSample(5100).value == 2.0);
+    const Sample spike = replay.nextSample(5200);
+    REQUIRE(spike.value == 3.0);
+    REQUIRE(spike.quality == QF_SPIKE);
+    REQUIRE(spike.sensor == internSensorId("REPLAY-01"));
+    REQUIRE(replay.getActiveFaults(5200) == std::vector<std::string>{"spike"});
+    REQUIRE_FALSE(replay.finished());
+
+    // Backward seek, then double speed from the current position
+    replay.seek(1100);
+    REQUIRE(replay.nextSample(9000).value == 2.0);
+    replay.setPlaybackSpeed(2.0);
+    REQUIRE(replay.nextSample(9100).value == 4.0);
+    REQUIRE(replay.position() == 1300);
+    REQUIRE(replay.finished());
+    REQUIRE(replay.nextSample(20000).value == 4.0); // held past the end
+
+    // Before the first recorded sample the reading is a dropout
+    replay.seek(900);
+    const Sample early = replay.nextSample(0);
+    REQUIRE(std::isnan(early.value));
+    REQUIRE(early.quality == QF_DROPOUT);
+
+    // reset() rewinds deterministically
+    replay.reset(7);
+    const Sample first = replay.nextSample(42);
+    REQUIRE(first.seq == 1u);
+    REQUIRE(first.value == 1.0);
+    REQUIRE(replay.played() == 1u);
+}
+
+TEST_CASE("MultiChannelSensor produces every axis from one call", "[sensor][channels]")
+{
+    SensorSpec spec = makeDefaultImuSpec();
+    MultiChannelSensor imu(spec);
+    imu.reset(5);
+    REQUIRE(imu.channelCount() == 3);
+    REQUIRE(imu.channelName(2) == "z");
+
+    const Sample s = imu.nextSample(100);
+    const auto axes = imu.channelValues();
+    REQUIRE(axes.size() == 3);
+    REQUIRE(s.value == axes[0]);
+    REQUIRE(axes[2] == Catch::Approx(9.81).margin(0.5));
+    REQUIRE(imu.getHistory().back() == axes[0]);
+
+    // Same seed, same vectors
+    MultiChannelSensor twin(spec);
+    twin.reset(5);
+    twin.nextSample(100);
+    REQUIRE(std::equal(axes.begin(), axes.end(), twin.channelValues().begin()));
+
+    // Faults act on the whole device
+    imu.triggerDropoutFault(200, 0);
+    REQUIRE(imu.nextSample(200).quality & QF_DROPOUT);
+    REQUIRE(std::all_of(imu.channelValues().begin(), imu.channelValues().end(), [](double v)
+                        { return std::isnan(v); }));
+    const auto before = imu.nextSample(300);
+    const std::vector<double> frozen(imu.channelValues().begin(), imu.channelValues().end());
+    imu.triggerStuckFault(1000, 300, before.value);
+    REQUIRE(imu.nextSample(400).quality & QF_STUCK);
+    REQUIRE(std::equal(frozen.begin(), frozen.end(), imu.channelValues().begin()));
+
+    // Scalar sensors report a single channel
+    SimpleSensor temp(makeDefaultTempSpec());
+    REQUIRE(temp.channelCount() == 1);
+    REQUIRE(temp.channelValues().empty());
+
+    spec.channels.clear();
+    REQUIRE_THROWS_AS(MultiChannelSensor(spec), std::invalid_argument);
+}
+
+TEST_CASE("Fault timeline matches per-sample fault probabilities", "[sensor][fault][timeline]")
+{
+    SensorSpec spec = makeDefaultTempSpec();
+    spec.rate_hz = 10;
+    spec.noise.gaussian_sigma = 0.0;
+    spec.fault.dropout_prob = 0.05;
+    spec.fault.spike_prob = 0.02;
+    spec.fault.spike_mag = 4.0;
+    spec.fault.stuck_prob = 0.0;
+
+    SimpleSensor sensor(spec);
+    sensor.reset(11);
+    sensor.setFaultSampling(FaultSampling::Timeline);
+    REQUIRE(sensor.dropoutTimeline().eventsPerSecond() == Catch::Approx(-10.0 * std::log(0.95)));
+
+    constexpr int kSamples = 200'000;
+    int dropouts = 0, spikes = 0;
+    for (int i = 0; i < kSamples; ++i)
+    {
+        const auto s = sensor.nextSample(100 + i * 100);
+        dropouts += (s.quality & QF_DROPOUT) != 0;
+        spikes += (s.quality & QF_SPIKE) != 0;
+    }
+    REQUIRE(dropouts / double(kSamples) == Catch::Approx(0.05).margin(0.003));
+    REQUIRE(spikes / double(kSamples - dropouts) == Catch::Approx(0.02).margin(0.002));
+
+    // Certain and impossible faults stay certain and impossible
+    spec.fault.dropout_prob = 1.0;
+    SimpleSensor always(spec);
+    always.reset(1);
+    always.setFaultSampling(FaultSampling::Timeline);
+    for (int i = 0; i < 100; ++i)
+        REQUIRE((always.nextSample(i * 100).quality & QF_DROPOUT) != 0);
+    REQUIRE(std::isinf(sensor.stuckTimeline().nextEventMs()));
+}
+
+TEST_CASE("Fault timeline follows the actual sample spacing", "[sensor][fault][timeline]")
+{
+    SensorSpec spec = makeDefaultTempSpec();
+    spec.rate_hz = 1; // nominal 1 s period, but scheduled every 100 ms below
+    spec.fault.dropout_prob = 0.05;
+    spec.fault.spike_prob = 0.0;
+    spec.fault.stuck_prob = 0.0;
+
+    SimpleSensor sensor(spec);
+    sensor.reset(3);
+    sensor.setFaultSampling(FaultSampling::Timeline);
+
+    constexpr int kSamples = 200'000;
+    int dropouts = 0;
+    for (int i = 0; i < kSamples; ++i)
+        dropouts += (sensor.nextSample(i * 100).quality & QF_DROPOUT) != 0;
+    REQUIRE(sensor.dropoutTimeline().periodMs() == Catch::Approx(100.0));
+    REQUIRE(sensor.dropoutTimeline().eventsPerSecond() == Catch::Approx(-10.0 * std::log(0.95)));
+    REQUIRE(dropouts / double(kSamples) == Catch::Approx(0.05).margin(0.003));
+}
+
+TEST_CASE("Fault timeline can be listed ahead of sampling", "[sensor][fault][timeline]")
+{
+    SensorSpec spec = makeDefaultTempSpec();
+    spec.rate_hz = 10;
+    spec.fault.dropout_prob = 0.1;
+    spec.fault.spike_prob = 0.0;
+    spec.fault.stuck_prob = 0.0;
+
+    SimpleSensor sensor(spec);
+    sensor.reset(5);
+    sensor.setFaultSampling(FaultSampling::Timeline);
+
+    FaultTimeline planned = sensor.dropoutTimeline();
+    planned.anchor(0); // the first sample at t=100 anchors the sensor's copy at 0 too
+    const auto events = planned.events(100'000);
+    REQUIRE(events.size() > 50u); // ~105 expected over 1000 periods
+
+    std::size_t next = 0;
+    for (int64_t ts = 100; ts <= 100'000; ts += 100)
+    {
+        bool expected = false;
+        while (next < events.size() && events[next] <= static_cast<double>(ts))
+            expected |= events[next++] > static_cast<double>(ts - 100);
+        REQUIRE(((sensor.nextSample(ts).quality & QF_DROPOUT) != 0) == expected);
+    }
+
+    // Same seed, same timeline
+    SimpleSensor again(spec);
+    again.reset(5);
+    again.setFaultSampling(FaultSampling::Timeline);
+    FaultTimeline replanned = again.dropoutTimeline();
+    replanned.anchor(0);
+    REQUIRE(replanned.events(100'000) == events);
+}
+
+TEST_CASE("Waveforms follow their shape from the phase accumulator", "[sensor][waveform]")
+{
+    SensorSpec spec;
+    spec.base_level = 10.0;
+    spec.sine_amp = 2.0;
+    spec.sine_freq_hz = 0.25; // 4 s period
+
+    spec.base = "sine";
+    const Waveform sine = Waveform::fromSpec(spec);
+    REQUIRE(sine.shape() == WaveShape::Sine);
+    for (int64_t t : {0LL, 1LL, 999LL, 1000LL, 3'141LL, 86'400'000LL, 31'536'000'123LL})
+        REQUIRE(sine.at(t) == Catch::Approx(10.0 + 2.0 * std::sin(2.0 * M_PI * 0.25 * (t / 1000.0))).margin(1e-9));
+
+    spec.base = "square";
+    spec.square_duty = 0.25;
+    const Waveform square = Waveform::fromSpec(spec);
+    REQUIRE(square.at(0) == 12.0);
+    REQUIRE(square.at(999) == 12.0);
+    REQUIRE(square.at(1001) == 8.0);
+    REQUIRE(square.at(3999) == 8.0);
+    REQUIRE(square.at(4001) == 12.0);
+
+    spec.base = "sawtooth";
+    const Waveform saw = Waveform::fromSpec(spec);
+    REQUIRE(saw.at(0) == Catch::Approx(8.0));
+    REQUIRE(saw.at(2000) == Catch::Approx(10.0));
+    REQUIRE(saw.at(3000) == Catch::Approx(11.0));
+    REQUIRE(saw.at(4001) == Catch::Approx(8.001));
+
+    spec.base = "step";
+    spec.step_at_ms = 500;
+    const Waveform step = Waveform::fromSpec(spec);
+    REQUIRE(step.at(499) == 10.0);
+    REQUIRE(step.at(500) == 12.0);
+
+    spec.base = "ramp";
+    spec.ramp_per_s = -0.5;
+    REQUIRE(Waveform::fromSpec(spec).at(4000) == Catch::Approx(8.0));
+
+    spec.base = "table";
+    spec.wave_table = {0.0, 4.0, 0.0, -4.0}; // one entry per second at 0.25 Hz
+    const Waveform table = Waveform::fromSpec(spec);
+    REQUIRE(table.at(1000) == Catch::Approx(14.0));
+    REQUIRE(table.at(1500) == Catch::Approx(12.0));
+    REQUIRE(table.at(3500) == Catch::Approx(8.0)); // wraps from the last entry to the first
+    REQUIRE(table.at(5000) == Catch::Approx(14.0));
+
+    // Block fill walks the same phase as at()
+    for (const Waveform *w : {&sine, &square, &saw, &table})
+    {
+        std::vector<double> block(300);
+        w->fill(-7, 37, block.size(), block.data());
+        for (std::size_t i = 0; i < block.size(); ++i)
+            REQUIRE(block[i] == w->at(-7 + static_cast<int64_t>(i) * 37));
+    }
+
+    // Missing parameters keep the old constant fallback; unknown names too
+    spec.base = "sine";
+    spec.sine_freq_hz = 0.0;
+    REQUIRE(Waveform::fromSpec(spec).shape() == WaveShape::Constant);
+    spec.base = "noise";
+    REQUIRE(Waveform::fromSpec(spec).at(123) == 10.0);
+    WaveShape shape;
+    REQUIRE_FALSE(parseWaveShape("noise", shape));
+}
+
+TEST_CASE("SimpleSensor uses the configured waveform in both batch modes", "[sensor][waveform][batch]")
+{
+    SensorSpec spec;
+    spec.id = "SQ-01";
+    spec.rate_hz = 10;
+    spec.base = "square";
+    spec.base_level = 1.0;
+    spec.sine_amp = 0.5;
+    spec.sine_freq_hz = 1.0;
+
+    SimpleSensor single(spec);
+    single.reset(5);
+    REQUIRE(single.nextSample(100).value == 1.5);
+    REQUIRE(single.nextSample(600).value == 0.5);
+    REQUIRE(single.nextSample(1100).value == 1.5);
+
+    SimpleSensor exact(spec), fast(spec);
+    exact.reset(5);
+    fast.reset(5);
+    fast.setBatchSynthesis(BatchSynthesis::Vectorized);
+    SampleBatch a, b;
+    a.resize(1000);
+    b.resize(1000);
+    exact.generateBatch(0, 100, 1000, a.view());
+    fast.generateBatch(0, 100, 1000, b.view());
+    REQUIRE(a.values == b.values);
+    REQUIRE(std::count(a.values.begin(), a.values.end(), 1.5) == Catch::Approx(500).margin(100)); // edges may fall either way
+}
+
+TEST_CASE("BasicSensor composes signal, noise and fault policies", "[sensor][basic]")
+{
+    SensorSpec spec = makeDefaultTempSpec();
+    spec.id = "BASIC-01";
+
+    // Noise- and fault-free: the same base signal as SimpleSensor
+    BasicSensor<policy::WaveSignal> plain(spec);
+    SimpleSensor reference(spec);
+    reference.reset(1);
+    for (int64_t t = 0; t < 5000; t += 100)
+        REQUIRE(plain.sample(t).value == reference.nextSample(t).value);
+    REQUIRE(plain.getActiveFaults(0).empty());
+    plain.triggerDropoutFault(0, 1000); // NoFaults ignores triggers
+    REQUIRE_FALSE(std::isnan(plain.sample(5000).value));
+
+    BasicSensor<policy::ConstantSignal, policy::NoNoise, policy::InjectedFaults> faulty(spec);
+    ISensor &adapter = faulty;
+    REQUIRE(adapter.nextSample(0).value == 25.0);
+    adapter.triggerStuckFault(200, 100, 7.5);
+    REQUIRE(adapter.getActiveFaults(150) == std::vector<std::string>{"stuck"});
+    REQUIRE(adapter.nextSample(200).value == 7.5);
+    REQUIRE((faulty.sample(300).quality & QF_STUCK) != 0);
+    adapter.triggerDropoutFault(400, 100);
+    const Sample dropped = faulty.sample(450);
+    REQUIRE(std::isnan(dropped.value));
+    REQUIRE(faulty.activeFaultFlags(450) == QF_DROPOUT);
+    REQUIRE(faulty.sample(501).value == 25.0);
+    REQUIRE(adapter.getHistory().size() == 2); // stuck and dropped samples are not recorded
+
+    adapter.triggerSpikeFault(0.0, 0.5, 600);
+    const Sample spiked = faulty.sample(700);
+    REQUIRE((spiked.quality & QF_SPIKE) != 0);
+    REQUIRE(spiked.value != 25.0);
+
+    // Same seed, same stream
+    spec.noise.gaussian_sigma = 0.2;
+    spec.fault.spike_prob = 0.1;
+    spec.fault.spike_mag = 2.0;
+    using Noisy = BasicSensor<policy::WaveSignal, policy::SpecNoise, policy::RandomFaults>;
+    Noisy a(spec), b(spec);
+    a.reset(9);
+    b.reset(9);
+    int spikes = 0;
+    for (int64_t t = 0; t < 10'000; t += 10)
+    {
+        const Sample sa = a.sample(t);
+        REQUIRE(sa.value == b.sample(t).value);
+        spikes += (sa.quality & QF_SPIKE) != 0;
+    }
+    REQUIRE(spikes > 50);
+    REQUIRE(spikes < 150);
+}
+
+TEST_CASE("OnlineStats tracks moments, extremes and quantiles in one pass", "[sensor][stats]")
+{
+    OnlineStats empty;
+    REQUIRE(empty.count() == 0u);
+    REQUIRE(std::isnan(empty.mean()));
+    REQUIRE(std::isnan(empty.p50()));
+
+    OnlineStats few;
+    for (double v : {3.0, 1.0, 2.0})
+        few.add(v);
+    REQUIRE(few.p50() == 2.0);
+    REQUIRE(few.min() == 1.0);
+    REQUIRE(few.max() == 3.0);
+    REQUIRE(few.variance() == Approx(1.0));
+
+    std::mt19937_64 rng(7);
+    std::normal_distribution<double> normal(20.0, 2.0);
+    std::vector<double> values;
+    OnlineStats stats(0.05);
+    double ewma = 0.0;
+    for (int i = 0; i < 20000; ++i)
+    {
+        const double v = normal(rng);
+        ewma = i == 0 ? v : ewma + 0.05 * (v - ewma);
+        values.push_back(v);
+        stats.add(v);
+    }
+    stats.add(std::numeric_limits<double>::quiet_NaN());
+
+    REQUIRE(stats.count() == values.size());
+    REQUIRE(stats.missing() == 1u);
+    REQUIRE(stats.last() == values.back());
+    REQUIRE(stats.ewma() == Approx(ewma));
+
+    // Welford against the two-pass formulas
+    double sum = 0.0;
+    for (double v : values)
+        sum += v;
+    const double mean = sum / values.size();
+    double squares = 0.0;
+    for (double v : values)
+        squares += (v - mean) * (v - mean);
+    REQUIRE(stats.mean() == Approx(mean).epsilon(1e-12));
+    REQUIRE(stats.variance() == Approx(squares / (values.size() - 1)).epsilon(1e-9));
+    REQUIRE(stats.min() == *std::min_element(values.begin(), values.end()));
+    REQUIRE(stats.max() == *std::max_element(values.begin(), values.end()));
+
+    // P² estimates against exact ranks (sigma is 2.0)
+    std::sort(values.begin(), values.end());
+    auto rank = [&values](double p)
+    { return values[static_cast<std::size_t>(p * (values.size() - 1))]; };
+    REQUIRE(stats.p50() == Approx(rank(0.50)).margin(0.05));
+    REQUIRE(stats.p95() == Approx(rank(0.95)).margin(0.1));
+    REQUIRE(stats.p99() == Approx(rank(0.99)).margin(0.15));
+
+    stats.reset();
+    REQUIRE(stats.count() == 0u);
+    REQUIRE(stats.missing() == 0u);
+    REQUIRE(stats.ewmaAlpha() == 0.05);
+}
+
+TEST_CASE("AnomalyDetector flags outliers, flatlines and fast changes", "[sensor][anomaly]")
+{
+    AnomalyConfig config;
+    config.window = 32;
+    config.z_threshold = 6.0;
+    config.flatline_samples = 5;
+    config.max_rate_per_s = 1000.0; // 10 units per 10 ms sample
+    AnomalyDetector detector(config);
+
+    // A large level exercises the re-centred window sums
+    std::mt19937_64 rng(3);
+    std::normal_distribution<double> normal(1000.0, 0.5);
+    int64_t t = 0;
+    uint8_t seen = QF_OK;
+    for (int i = 0; i < 2000; ++i)
+        seen |= detector.check(t += 10, normal(rng));
+    REQUIRE(seen == QF_OK);
+
+    REQUIRE(detector.check(t += 10, 1050.0) == (QF_NOISY | QF_RATE));
+    REQUIRE(detector.check(t += 10, std::numeric_limits<double>::quiet_NaN()) == QF_OK);
+
+    for (int i = 1; i <= 6; ++i)
+    {
+        const uint8_t flags = detector.check(t += 10, 1000.0);
+        REQUIRE(((flags & QF_FLATLINE) != 0) == (i >= 5));
+    }
+
+    std::vector<std::string> names;
+    appendFaultNames(QF_SPIKE | QF_NOISY | QF_FLATLINE | QF_RATE, names);
+    REQUIRE(names == std::vector<std::string>{"spike", "noisy", "flatline", "rate"});
+
+    // No history after a reset, so nothing to compare against
+    detector.reset();
+    REQUIRE(detector.check(t += 10, 5000.0) == QF_OK);
+}
+
+TEST_CASE("AnomalyDetector flatline tolerates jitter within epsilon but not a slow drift", "[sensor][anomaly]")
+{
+    AnomalyConfig config;
+    config.z_threshold = 0.0;
+    config.flatline_samples = 10;
+    config.flatline_epsilon = 0.05;
+    AnomalyDetector detector(config);
+
+    // Jitter around a stuck level stays within epsilon of the first value
+    for (int i = 1; i <= 12; ++i)
+    {
+        const uint8_t flags = detector.flatline(20.0 + ((i & 1) ? 0.02 : -0.02));
+        REQUIRE(((flags & QF_FLATLINE) != 0) == (i >= 10));
+    }
+
+    // 0.01 per sample is below epsilon step to step, but the run restarts every 6 values
+    detector.reset();
+    uint8_t seen = QF_OK;
+    for (int i = 0; i < 100; ++i)
+        seen |= detector.flatline(30.0 + 0.01 * i);
+    REQUIRE(seen == QF_OK);
+}
+
+TEST_CASE("AnomalyDetector flatline treats ulp-level jitter as flat by default", "[sensor][anomaly]")
+{
+    AnomalyConfig config; // flatline_epsilon = 0, as in the shipped gateway config
+    config.z_threshold = 0.0;
+    AnomalyDetector detector(config);
+
+    // A stuck 25.0 whose reading wobbles by one ulp either way
+    const double levels[] = {25.0, std::nextafter(25.0, 30.0), std::nextafter(25.0, 20.0)};
+    for (int i = 1; i <= 200; ++i)
+    {
+        const uint8_t flags = detector.flatline(levels[i % 3]);
+        REQUIRE(((flags & QF_FLATLINE) != 0) == (i >= static_cast<int>(config.flatline_samples)));
+    }
+
+    // With the relative tolerance off, only exact repeats count
+    config.flatline_relative = 0.0;
+    AnomalyDetector exact(config);
+    uint8_t seen = QF_OK;
+    for (int i = 1; i <= 200; ++i)
+        seen |= exact.flatline(levels[i % 3]);
+    REQUIRE(seen == QF_OK);
+}